@@ -0,0 +1,21 @@
+#ifndef _ASRC_H_
+#define _ASRC_H_
+
+#include <stdint.h>
+
+// polyphase branches of the prototype filter and taps per branch. the
+// phase in between two branches is interpolated linearly.
+#define ASRC_PHASE_BITS 6
+#define ASRC_TAPS 16
+
+// read step per output frame in 8.24 fixed point, 1.0 at matched clocks
+#define ASRC_ONE (1 << 24)
+// the servo keeps the ratio within 2000 ppm of nominal
+#define ASRC_MAX_CORR (ASRC_ONE / 500)
+
+void asrc_reset(void);
+void asrc_servo(int32_t err);
+uint32_t asrc_process(uint32_t *dst, uint32_t frames);
+int32_t asrc_ratio_ppm(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef _AUDIO_GAIN_H_
+#define _AUDIO_GAIN_H_
+
+#include <stdint.h>
+
+// soft gain range in 1/256 dB, in 0.5 dB steps. the Q15 gains run out of
+// resolution much below this.
+#define AUDIO_GAIN_MIN (-60 * 256)
+#define AUDIO_GAIN_MAX 0
+#define AUDIO_GAIN_RES 128
+
+// Q15 gain of both channels, right in the top halfword
+#define AUDIO_GAIN_UNITY 0x7fff7fff
+
+// gain is where the last block ended, target where the next one ramps to.
+// target may be written at any time as a single word.
+typedef struct {
+  uint32_t gain;
+  volatile uint32_t target;
+} audio_gain_t;
+
+uint16_t audio_gain_q15(int32_t vol);
+void audio_gain_apply(audio_gain_t *g, uint32_t *buf, uint32_t frames);
+
+#endif
\ No newline at end of file
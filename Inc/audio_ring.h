@@ -0,0 +1,38 @@
+#ifndef _AUDIO_RING_H_
+#define _AUDIO_RING_H_
+
+#include <stdint.h>
+
+// ring size in 32-bit words, must be a power of two
+#define AUDIO_RING_WORDS 2048
+// one Q31 word per channel, left first. the ring size is a multiple of it,
+// so a frame never straddles the wrap point.
+#define AUDIO_RING_FRAME_WORDS 2
+
+// single-producer/single-consumer ring between the USB ISR (producer) and
+// the audio output stage (consumer). head is only written by the producer,
+// tail only by the consumer, so no critical sections are needed.
+typedef struct {
+  uint32_t buf[AUDIO_RING_WORDS];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t overrun_cnt;
+  volatile uint32_t underrun_cnt;
+} audio_ring_t;
+
+// free space handed to the producer, split in two at the wrap point
+typedef struct {
+  uint32_t *ptr[2];
+  uint32_t len[2];
+} audio_ring_span_t;
+
+extern audio_ring_t audio_ring;
+
+uint32_t audio_ring_fill(const audio_ring_t *ring);
+int audio_ring_reserve(audio_ring_t *ring, uint32_t words,
+                       audio_ring_span_t *span);
+void audio_ring_commit(audio_ring_t *ring, uint32_t words);
+uint32_t audio_ring_read(audio_ring_t *ring, uint32_t *dst, uint32_t words);
+void audio_ring_flush(audio_ring_t *ring);
+
+#endif
\ No newline at end of file
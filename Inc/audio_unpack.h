@@ -0,0 +1,16 @@
+#ifndef _AUDIO_UNPACK_H_
+#define _AUDIO_UNPACK_H_
+
+#include <stdint.h>
+
+// stereo USB subframes to the internal format: one Q31 word per channel,
+// left first. src needs no alignment.
+typedef void (*audio_unpack_t)(const uint8_t *src, uint32_t *dst,
+                               uint32_t frames);
+
+void audio_unpack_16(const uint8_t *src, uint32_t *dst, uint32_t frames);
+void audio_unpack_24_3(const uint8_t *src, uint32_t *dst, uint32_t frames);
+void audio_unpack_24_4(const uint8_t *src, uint32_t *dst, uint32_t frames);
+void audio_unpack_32(const uint8_t *src, uint32_t *dst, uint32_t frames);
+
+#endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef _CLOCK_H_
 #define _CLOCK_H_
 
+#include <stdint.h>
+
 void clock_init(void);
+void clock_plli2s_init(uint32_t m, uint32_t n, uint32_t r);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef _CODEC_H_
+#define _CODEC_H_
+
+#include <stdint.h>
+
+// master volume range of the CS43L22 in 1/256 dB, the UAC2 volume unit.
+// the register steps by 0.5 dB.
+#define CODEC_VOLUME_MIN (-102 * 256)
+#define CODEC_VOLUME_MAX (12 * 256)
+#define CODEC_VOLUME_RES 128
+
+void codec_init(void);
+void codec_set_volume(int16_t left, int16_t right);
+void codec_set_mute(uint8_t left, uint8_t right);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef _CONCEAL_H_
+#define _CONCEAL_H_
+
+#include <stdint.h>
+
+// length of the fade out ahead of starvation or after an overflow, and of
+// the fade in once data resumes
+#ifndef CONCEAL_FADE_MS
+#define CONCEAL_FADE_MS 2
+#endif
+
+// events with the output position, in frames, of the last one of each kind
+typedef struct {
+  uint32_t underrun_cnt; // faded out as the ring ran low
+  uint32_t overrun_cnt;  // faded out and dropped the queue after overflow
+  uint32_t cut_cnt;      // data ended before the fade out did
+  uint32_t resume_cnt;   // faded back in
+  uint32_t underrun_pos;
+  uint32_t overrun_pos;
+  uint32_t cut_pos;
+  uint32_t resume_pos;
+} conceal_stats_t;
+
+extern volatile conceal_stats_t conceal_stats;
+
+void conceal_set_rate(uint32_t rate);
+uint32_t conceal_fade_frames(void);
+uint32_t conceal_gain(void);
+void conceal_silence(void);
+void conceal_ramp(uint32_t *buf, uint32_t frames, uint8_t down);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef _CONV_H_
+#define _CONV_H_
+
+#include <arm_math.h>
+#include <stdint.h>
+
+// longest impulse response, a power of two. the spectra and delay lines
+// take 32 bytes of RAM per tap for both channels.
+#ifndef CONV_MAX_TAPS
+#define CONV_MAX_TAPS 1024
+#endif
+
+// partition size range in frames, powers of two. the partition size is the
+// latency of the engine, a smaller one costs more CPU per frame.
+#define CONV_MIN_PARTITION 32
+#define CONV_MAX_PARTITION 256
+#define CONV_DEFAULT_PARTITION 128
+
+void conv_init(void);
+int conv_setup(uint16_t partition, uint16_t taps);
+int conv_load(uint8_t channels, uint16_t first, uint16_t count,
+              const float *taps);
+int conv_enable(uint8_t enable);
+void conv_sync(void);
+uint8_t conv_active(void);
+void conv_set_shorten(uint8_t shift);
+void conv_process(float32_t *buf, uint32_t frames);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef _DEADLINE_H_
+#define _DEADLINE_H_
+
+#include <stdint.h>
+
+// margins in 1/100 % of the refill period
+#define DEADLINE_FULL 10000
+// below this a refill is a near miss and processing steps down a tier
+#define DEADLINE_LOW 2500
+// processing steps back up after DEADLINE_HOLD refills in a row above this,
+// each with room for the tier restored
+#define DEADLINE_HIGH 4000
+#define DEADLINE_HOLD 500
+#define DEADLINE_TIERS 5
+#define DEADLINE_LOG 8
+
+// a tier change
+typedef struct {
+  uint32_t pos; // playback_position() at the change
+  uint8_t from;
+  uint8_t to;
+  uint16_t margin; // of the refill that caused it
+} deadline_event_t;
+
+typedef struct {
+  uint32_t refill_cnt;
+  uint32_t near_cnt; // margin below DEADLINE_LOW
+  uint32_t miss_cnt; // the DMA had reached the half being refilled
+  uint32_t down_cnt;
+  uint32_t up_cnt;
+  uint16_t margin_last;
+  uint16_t margin_min; // since the last read from USB
+  uint8_t tier;        // 0 is full processing
+  uint8_t log_pos;     // entry of the log written next
+  uint16_t reserved;
+  deadline_event_t log[DEADLINE_LOG];
+} deadline_stats_t;
+
+extern volatile deadline_stats_t deadline_stats;
+
+void deadline_init(void);
+void deadline_check(uint32_t left, uint32_t frames);
+void deadline_read(deadline_stats_t *stats);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _DYN_H_
+#define _DYN_H_
+
+#include <arm_math.h>
+#include <stdint.h>
+
+// limiter look-ahead, the latency it adds while enabled
+#define DYN_LOOKAHEAD_MS 1
+#define DYN_BANDS 3
+
+// dynamics settings as exchanged with the host, levels in 1/256 dB
+typedef struct {
+  uint8_t limiter;    // look-ahead limiter on
+  uint8_t compressor; // three-band compressor ahead of it on
+  int16_t ceiling;    // limiter output ceiling, at most 0 dBFS
+  uint16_t release;   // limiter release, ms
+  uint16_t xover[2];  // low/mid and mid/high crossover, Hz
+  int16_t threshold[DYN_BANDS];
+  uint16_t ratio[DYN_BANDS]; // 1/256, 256 is 1:1
+  uint16_t attack;           // compressor attack, ms
+  uint16_t comp_release;     // compressor release, ms
+} dyn_params_t;
+
+// largest gain reduction since the last read, 1/256 dB
+typedef struct {
+  uint16_t limiter;
+  uint16_t band[DYN_BANDS];
+} dyn_meter_t;
+
+void dyn_init(void);
+void dyn_set_rate(uint32_t rate);
+int dyn_set_params(const dyn_params_t *params);
+void dyn_get_params(dyn_params_t *params);
+void dyn_read_meter(dyn_meter_t *meter);
+void dyn_sync(void);
+uint8_t dyn_active(void);
+void dyn_process(float32_t *buf, uint32_t frames);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,10 @@
+#ifndef _FEEDBACK_H_
+#define _FEEDBACK_H_
+
+#include <stdint.h>
+
+void feedback_init(void);
+void feedback_set_rate(uint32_t rate);
+uint32_t feedback_value(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef _GRAPH_H_
+#define _GRAPH_H_
+
+#include <stdint.h>
+
+#define GRAPH_MAX_NODES 8
+// buffers of one block in the arena, the graph input included
+#define GRAPH_MAX_SLOTS 4
+
+typedef enum {
+  GRAPH_GAIN,  // param is the gain in 1/256 dB, ramped over one block
+  GRAPH_PEQ,   // the parametric EQ
+  GRAPH_CONV,  // the convolution engine
+  GRAPH_DYN,   // compressor and limiter
+  GRAPH_METER, // peak meter, passes the signal through
+  GRAPH_MIX,   // sum of both inputs
+  GRAPH_NUM_TYPES,
+} graph_node_type_t;
+
+// node as exchanged with the host. signal 0 is the graph input, signal n
+// the output of node n - 1, the output of the last node is played. nodes
+// only read signals of nodes before them, and the EQ, convolution and
+// dynamics nodes appear at most once.
+typedef struct {
+  uint8_t type;
+  uint8_t in[2]; // in[1] only for GRAPH_MIX
+  uint8_t reserved;
+  int16_t param;
+} graph_node_t;
+
+void graph_init(void);
+void graph_set_rate(uint32_t rate);
+int graph_set_nodes(uint8_t count, const graph_node_t *nodes);
+uint8_t graph_get_nodes(graph_node_t *nodes);
+void graph_read_meters(int16_t *peaks);
+void graph_sync(void);
+uint8_t graph_active(void);
+void graph_process(int32_t *buf, uint32_t frames);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef _I2C_H_
+#define _I2C_H_
+
+#include <stdint.h>
+
+// queued transfers, a power of two
+#define I2C_QUEUE_LEN 16
+// data bytes of one write, after the register address
+#define I2C_XFER_MAX 4
+
+// runs from the I2C interrupt once the transfer is over, failed or not
+typedef void (*i2c_done_t)(void);
+
+// register write to a 7-bit device. with a non-zero mask the register is
+// read first and only the masked bits are replaced by data[0], len must be
+// 1 then.
+typedef struct {
+  uint8_t addr; // 8-bit write address
+  uint8_t reg;
+  uint8_t len;
+  uint8_t mask;
+  uint8_t data[I2C_XFER_MAX];
+  i2c_done_t done;
+} i2c_xfer_t;
+
+void i2c_init(void);
+int i2c_submit(const i2c_xfer_t *xfer);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef _LOAD_H_
+#define _LOAD_H_
+
+#include <stdint.h>
+
+// 100 % load
+#define LOAD_FULL 10000
+
+// CPU load in 1/100 % over the last complete window of each length, all
+// that is not spent asleep in the idle loop counts as busy
+typedef struct {
+  uint16_t load_1ms;
+  uint16_t max_1ms; // highest 1 ms load of the last complete second
+  uint16_t load_100ms;
+  uint16_t load_1s;
+  uint32_t window_cnt; // 1 ms windows
+  uint32_t late_cnt;   // windows that closed 1 ms or more late
+} load_stats_t;
+
+extern volatile load_stats_t load_stats;
+
+void load_init(void);
+void load_idle(void);
+
+#endif
\ No newline at end of file
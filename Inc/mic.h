@@ -0,0 +1,28 @@
+#ifndef _MIC_H_
+#define _MIC_H_
+
+#include "audio_ring.h"
+#include <stdint.h>
+
+// PCM samples produced per DMA half-buffer
+#define MIC_BLOCK_FRAMES 48
+
+// the capture pipeline may use this many cycles per millisecond of audio,
+// about 20% of the 96 MHz core. blocks above it are counted.
+#define MIC_CYCLES_PER_MS 20000
+
+typedef struct {
+  uint32_t block_cnt;
+  uint32_t cycles_last;
+  uint32_t cycles_max;
+  uint32_t over_budget_cnt;
+} mic_stats_t;
+
+// mono Q31 samples at the playback rate, one word each
+extern audio_ring_t mic_ring;
+extern volatile mic_stats_t mic_stats;
+
+void mic_init(void);
+void mic_set_rate(uint32_t rate);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef _PEQ_H_
+#define _PEQ_H_
+
+#include <arm_math.h>
+#include <stdint.h>
+
+#define PEQ_MAX_BANDS 10
+
+typedef enum {
+  PEQ_OFF,
+  PEQ_PEAK,
+  PEQ_LOW_SHELF,
+  PEQ_HIGH_SHELF,
+  PEQ_LOW_PASS,
+  PEQ_HIGH_PASS,
+  PEQ_NOTCH,
+} peq_type_t;
+
+// one band as exchanged with the host, 8 bytes little endian. gain in
+// 1/256 dB like the UAC2 volume, Q in 1/256. gain is ignored by the
+// filters without one.
+typedef struct {
+  uint8_t type;
+  uint8_t reserved;
+  uint16_t freq; // Hz
+  int16_t gain;
+  uint16_t q;
+} peq_band_t;
+
+void peq_set_rate(uint32_t rate);
+int peq_set_bands(uint8_t first, uint8_t count, const peq_band_t *bands);
+void peq_get_bands(uint8_t first, uint8_t count, peq_band_t *bands);
+void peq_sync(void);
+void peq_set_limit(uint8_t count);
+uint8_t peq_active(void);
+void peq_process(float32_t *buf, uint32_t frames);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef _PLAYBACK_H_
+#define _PLAYBACK_H_
+
+#include "audio_gain.h"
+#include "codec.h"
+#include <stdint.h>
+
+#define PLAYBACK_DEFAULT_RATE 48000
+#define PLAYBACK_MAX_RATE 96000
+
+// length of one DMA half-buffer, i.e. the refill period. the total
+// latency added by the output stage is twice this value.
+#ifndef PLAYBACK_BUFFER_MS
+#define PLAYBACK_BUFFER_MS 2
+#endif
+
+#define PLAYBACK_MAX_HALF_FRAMES (PLAYBACK_MAX_RATE / 1000 * PLAYBACK_BUFFER_MS)
+
+// host volume and mute go to the CS43L22 by default. set to 1 to scale the
+// samples instead, ramped per sample, and leave the codec at 0 dB.
+#ifndef PLAYBACK_SOFT_VOLUME
+#define PLAYBACK_SOFT_VOLUME 0
+#endif
+
+// volume range in 1/256 dB
+#if PLAYBACK_SOFT_VOLUME
+#define PLAYBACK_VOLUME_MIN AUDIO_GAIN_MIN
+#define PLAYBACK_VOLUME_MAX AUDIO_GAIN_MAX
+#define PLAYBACK_VOLUME_RES AUDIO_GAIN_RES
+#else
+#define PLAYBACK_VOLUME_MIN CODEC_VOLUME_MIN
+#define PLAYBACK_VOLUME_MAX CODEC_VOLUME_MAX
+#define PLAYBACK_VOLUME_RES CODEC_VOLUME_RES
+#endif
+
+void playback_init(void);
+int playback_set_rate(uint32_t rate);
+uint32_t playback_rate(void);
+uint32_t playback_i2s_prescaler(void);
+uint32_t playback_rate_at(uint8_t index);
+void playback_set_asrc(uint8_t enable);
+uint8_t playback_asrc(void);
+uint8_t playback_playing(void);
+void playback_set_volume(int16_t left, int16_t right);
+void playback_set_mute(uint8_t left, uint8_t right);
+void playback_refill(uint32_t *dst, uint32_t frames);
+uint32_t playback_position(void);
+uint32_t playback_queued(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef _PROF_H_
+#define _PROF_H_
+
+#include <stdint.h>
+#include <stm32f411xe.h>
+
+// probes compile to nothing with 0
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 1
+#endif
+
+// histogram bucket 0 counts runs below 2^PROF_BUCKET_SHIFT cycles, bucket
+// k runs from 2^(PROF_BUCKET_SHIFT + k - 1) up to twice that, the last one
+// everything longer. a 1 ms frame is 96000 cycles, in bucket 12.
+#define PROF_BUCKETS 16
+#define PROF_BUCKET_SHIFT 5
+
+typedef enum {
+  PROF_USB,      // OTG_FS_IRQHandler
+  PROF_TIM1,     // TIM1_UP_TIM10_IRQHandler
+  PROF_FEEDBACK, // TIM2_IRQHandler
+  PROF_PLAYBACK, // one refill, processing included
+  PROF_MIC,      // one capture block
+  PROF_SPECTRUM, // one analyzer frame
+  // one graph block per node type, in graph_node_type_t order
+  PROF_GRAPH_GAIN,
+  PROF_GRAPH_PEQ,
+  PROF_GRAPH_CONV,
+  PROF_GRAPH_DYN,
+  PROF_GRAPH_METER,
+  PROF_GRAPH_MIX,
+  PROF_NUM_PROBES,
+} prof_probe_t;
+
+// per probe, in cycles, as exchanged with the host. the mean is total /
+// count.
+typedef struct {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint32_t last;
+  uint64_t total;
+  uint32_t hist[PROF_BUCKETS];
+} prof_stats_t;
+
+extern volatile prof_stats_t prof_stats[PROF_NUM_PROBES];
+extern const char *const prof_names[PROF_NUM_PROBES];
+
+void prof_init(void);
+void prof_record(uint8_t probe, uint32_t cycles);
+int prof_read(uint8_t probe, prof_stats_t *stats, uint8_t reset);
+
+#if PROF_ENABLE
+#define PROF_BEGIN(start) uint32_t start = DWT->CYCCNT
+#define PROF_END(probe, start) prof_record((probe), DWT->CYCCNT - (start))
+#define PROF_RECORD(probe, cycles) prof_record((probe), (cycles))
+#else
+#define PROF_BEGIN(start)
+#define PROF_END(probe, start)
+#define PROF_RECORD(probe, cycles)
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef _SPECTRUM_H_
+#define _SPECTRUM_H_
+
+#include <stdint.h>
+
+// FFT points, powers of two
+#define SPECTRUM_MIN_SIZE 256
+#define SPECTRUM_MAX_SIZE 2048
+#define SPECTRUM_DEFAULT_SIZE 1024
+// 1/3-octave bands centered on 1 kHz * 2^(k/3), 20 Hz to 20 kHz
+#define SPECTRUM_BANDS 31
+// time between reports, ms
+#define SPECTRUM_MIN_INTERVAL 10
+#define SPECTRUM_DEFAULT_INTERVAL 50
+
+typedef enum {
+  SPECTRUM_OFF,
+  SPECTRUM_PLAYBACK, // what goes out to the codec, left and right mixed
+  SPECTRUM_CAPTURE,  // the mic stream
+} spectrum_source_t;
+
+// settings as exchanged with the host
+typedef struct {
+  uint8_t source; // spectrum_source_t
+  uint8_t reserved;
+  uint16_t size;
+  uint16_t interval;
+} spectrum_config_t;
+
+// one report on the interrupt endpoint, band levels in 1/256 dBFS. a full
+// scale sine reads 0 dB in its band.
+typedef struct {
+  uint8_t seq;
+  uint8_t source;
+  int16_t band[SPECTRUM_BANDS];
+} spectrum_report_t;
+
+typedef struct {
+  uint32_t frame_cnt;
+  uint32_t late_cnt;    // input overwritten while being copied, dropped
+  uint32_t skip_cnt;    // previous frame still running when one was due
+  uint32_t busy_cnt;    // the host had not read the previous report yet
+  uint32_t cycles_last; // per frame: window, FFT and bands
+  uint32_t cycles_max;
+} spectrum_stats_t;
+
+extern volatile spectrum_stats_t spectrum_stats;
+
+void spectrum_init(void);
+void spectrum_set_rate(uint32_t rate);
+int spectrum_set_config(const spectrum_config_t *config);
+void spectrum_get_config(spectrum_config_t *config);
+void spectrum_set_bypass(uint8_t enable);
+void spectrum_feed(uint8_t source, const int32_t *src, uint32_t frames,
+                   uint32_t channels);
+
+#endif
\ No newline at end of file
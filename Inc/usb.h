@@ -1,6 +1,68 @@
 #ifndef _USB_H_
 #define _USB_H_
 
+#include <stdint.h>
+
+// bmRequestType fields
+#define USB_REQ_DIR_IN 0x80
+#define USB_REQ_TYPE_Msk 0x60
+#define USB_REQ_TYPE_STANDARD 0x00
+#define USB_REQ_TYPE_CLASS 0x20
+#define USB_REQ_TYPE_VENDOR 0x40
+#define USB_REQ_RECIPIENT_Msk 0x1f
+#define USB_REQ_RECIPIENT_DEVICE 0x00
+#define USB_REQ_RECIPIENT_INTERFACE 0x01
+#define USB_REQ_RECIPIENT_ENDPOINT 0x02
+
+// endpoints in use, including EP0
+#define USB_NUM_EPS 4
+// interrupt IN endpoint of the vendor interface, reports to the host
+#define USB_REPORT_EP 3
+#define USB_REPORT_MPS 64
+
+typedef struct {
+  uint8_t bmRequestType;
+  uint8_t bRequest;
+  uint16_t wValue;
+  uint16_t wIndex;
+  uint16_t wLength;
+} usb_setup_t;
+
+typedef enum {
+  USB_CTRL_OK = 0,
+  USB_CTRL_STALL,
+} usb_ctrl_result_t;
+
+// isochronous stream health. a frame is dropped when the core reports an
+// incomplete transfer for it, recovered when the endpoint completes again
+// after being re-armed for the next frame.
+typedef struct {
+  uint32_t dropped_cnt;
+  uint32_t recovered_cnt;
+} usb_iso_stats_t;
+
+// interrupt statistics, readable from the debugger
+typedef struct {
+  uint32_t irq_cnt;
+  uint32_t rx_pop_cnt;
+  uint32_t rx_pop_max; // most RX FIFO entries drained in one interrupt
+  uint32_t cycles_last;
+  uint32_t cycles_max;
+  uint64_t cycles_total;
+  usb_iso_stats_t iso_in[USB_NUM_EPS];
+  usb_iso_stats_t iso_out[USB_NUM_EPS];
+} usb_stats_t;
+
+extern volatile usb_stats_t usb_stats;
+
+// a request handler either answers with usb_ctrl_send()/usb_ctrl_recv(),
+// returns USB_CTRL_OK for a request without data stage, or stalls.
+typedef usb_ctrl_result_t (*usb_ctrl_handler_t)(const usb_setup_t *setup);
+
 void usb_init(void);
+void usb_ctrl_send(const void *data, uint16_t len);
+void usb_ctrl_recv(void *buf, uint16_t len, usb_ctrl_handler_t done);
+void usb_stream_restart(void);
+int usb_report_send(const void *data, uint16_t len);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef _USB_AUDIO_H_
+#define _USB_AUDIO_H_
+
+#include "audio_unpack.h"
+#include "usb.h"
+
+// stream format of an AS alternate setting
+typedef struct {
+  uint8_t frame_bytes; // both channels
+  audio_unpack_t unpack;
+} usb_audio_format_t;
+
+// capture stream of the mic AS interface, one channel
+#define USB_AUDIO_MIC_FRAME_BYTES 2
+
+usb_ctrl_result_t usb_audio_request(const usb_setup_t *req);
+const usb_audio_format_t *usb_audio_format(uint8_t alt);
+uint16_t usb_audio_out_mps(const usb_audio_format_t *fmt);
+uint16_t usb_audio_in_mps(void);
+
+#endif
\ No newline at end of file
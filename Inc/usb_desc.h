@@ -0,0 +1,31 @@
+#ifndef _USB_DESC_H_
+#define _USB_DESC_H_
+
+#include <stdint.h>
+
+#define USB_DESC_DEVICE 0x01
+#define USB_DESC_CONFIGURATION 0x02
+#define USB_DESC_STRING 0x03
+
+// audio function topology
+#define USB_AUDIO_CLOCK_ID 0x10
+#define USB_AUDIO_IT_ID 0x01
+#define USB_AUDIO_OT_ID 0x02
+#define USB_AUDIO_FU_ID 0x03
+#define USB_AUDIO_MIC_IT_ID 0x04
+#define USB_AUDIO_MIC_OT_ID 0x05
+
+#define USB_AC_INTERFACE 0
+#define USB_AS_INTERFACE 1
+// zero bandwidth, 16-bit, 24-in-3, 24-in-4, 32-bit
+#define USB_AS_NUM_ALTS 5
+#define USB_MIC_INTERFACE 2
+// zero bandwidth, 16-bit mono
+#define USB_MIC_NUM_ALTS 2
+// spectrum reports and the like, outside the audio function
+#define USB_VENDOR_INTERFACE 3
+#define USB_NUM_INTERFACES 4
+
+const uint8_t *usb_desc_get(uint8_t type, uint8_t index, uint16_t *len);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef _USB_FIFO_H_
+#define _USB_FIFO_H_
+
+#include "usb.h"
+#include <stdint.h>
+
+// OTG_FS has 1.25 KB of FIFO RAM shared by the RX FIFO and all TX FIFOs
+#define USB_FIFO_WORDS 320
+// smallest depth the core accepts for a TX FIFO
+#define USB_FIFO_TX_MIN 16
+
+// packet sizes of the endpoints in use, 0 for an inactive IN endpoint
+typedef struct {
+  uint16_t out_mps; // largest OUT packet of the enabled endpoints, EP0 too
+  uint16_t in_mps[USB_NUM_EPS];
+} usb_fifo_eps_t;
+
+// sizes and offsets in 32-bit words, TX FIFO n belongs to IN endpoint n
+typedef struct {
+  uint16_t rx_words;
+  uint16_t tx_offset[USB_NUM_EPS];
+  uint16_t tx_words[USB_NUM_EPS];
+} usb_fifo_plan_t;
+
+int usb_fifo_plan(const usb_fifo_eps_t *eps, usb_fifo_plan_t *plan);
+uint32_t usb_fifo_moved(const usb_fifo_plan_t *plan);
+int usb_fifo_apply(const usb_fifo_plan_t *plan);
+int usb_fifo_flush(uint8_t num);
+int usb_fifo_room(uint8_t ep, uint16_t len);
+void usb_fifo_write(uint8_t ep, const uint8_t *src, uint16_t len);
+
+#endif
\ No newline at end of file
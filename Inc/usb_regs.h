@@ -0,0 +1,50 @@
+#ifndef _USB_REGS_H_
+#define _USB_REGS_H_
+
+#include <stm32f411xe.h>
+
+// every OTG_FS register, FIFO and platform access made by the USB stack
+// goes through these macros. defining USB_REGS_OVERRIDE to a header name
+// redirects them, e.g. to an in-memory register model in a host build.
+#ifdef USB_REGS_OVERRIDE
+#include USB_REGS_OVERRIDE
+#else
+
+#define USB USB_OTG_FS
+#define USB_DEV                                                                \
+  ((USB_OTG_DeviceTypeDef *)((uint32_t)USB_OTG_FS_PERIPH_BASE +                \
+                             USB_OTG_DEVICE_BASE))
+#define USB_INEP                                                               \
+  ((USB_OTG_INEndpointTypeDef *)((uint32_t)USB_OTG_FS_PERIPH_BASE +            \
+                                 USB_OTG_IN_ENDPOINT_BASE))
+#define USB_OUTEP                                                              \
+  ((USB_OTG_OUTEndpointTypeDef *)((uint32_t)USB_OTG_FS_PERIPH_BASE +           \
+                                  USB_OTG_OUT_ENDPOINT_BASE))
+#define USB_FIFO(ep)                                                           \
+  ((volatile uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_FIFO_BASE +          \
+                         ((ep) * USB_OTG_FIFO_SIZE)))
+
+// the RX FIFO and GRXSTSP pop on read, and interrupt flags clear on a
+// write of one, so they get their own accessors
+#define USB_FIFO_READ(ep) (*USB_FIFO(ep))
+#define USB_FIFO_WRITE(ep, val) (*USB_FIFO(ep) = (val))
+#define USB_RXSTS_POP() (USB->GRXSTSP)
+#define USB_INT_CLEAR(reg, val) ((reg) = (val))
+
+#define USB_CYCCNT() (DWT->CYCCNT)
+#define USB_CYCCNT_INIT()                                                      \
+  do {                                                                         \
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                            \
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;                                       \
+  } while (0)
+
+#define USB_CLK_ENABLE() (RCC->AHB2ENR |= RCC_AHB2ENR_OTGFSEN)
+#define USB_IRQ_ENABLE()                                                       \
+  do {                                                                         \
+    NVIC_SetPriority(OTG_FS_IRQn, 0);                                          \
+    NVIC_EnableIRQ(OTG_FS_IRQn);                                               \
+  } while (0)
+
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef _USB_VENDOR_H_
+#define _USB_VENDOR_H_
+
+#include "usb.h"
+
+// vendor requests to the device, bRequest codes. all data is little
+// endian.
+//
+// USB_VENDOR_ASRC: no data, wValue 1 consumes the ring through the
+// resampler instead of relying on the feedback endpoint, 0 goes back to the
+// feedback. IN, one byte, reads back whether the resampler is in use. the
+// device also switches to it on its own once the host ignores the
+// feedback, and back to the feedback whenever the stream restarts or the
+// rate changes.
+#define USB_VENDOR_ASRC 0x01
+// USB_VENDOR_PEQ: wIndex is the first band, the data stage carries
+// wLength / 8 peq_band_t structures. OUT sets the bands, all at once, IN
+// reads them back.
+#define USB_VENDOR_PEQ 0x02
+// USB_VENDOR_CONV_SETUP: no data, wValue is the partition size and wIndex
+// the impulse response length. starts loading a new response, after the
+// engine was disabled.
+#define USB_VENDOR_CONV_SETUP 0x03
+// USB_VENDOR_CONV_IR: OUT, float taps from tap wIndex on, up to
+// USB_VENDOR_CONV_CHUNK at a time. wValue bit 0 selects the left channel,
+// bit 1 the right one.
+#define USB_VENDOR_CONV_IR 0x04
+// USB_VENDOR_CONV_ENABLE: no data, wValue 1 enables the engine with the
+// response loaded, 0 bypasses it.
+#define USB_VENDOR_CONV_ENABLE 0x05
+// USB_VENDOR_DYN: a dyn_params_t, OUT sets the limiter and compressor, IN
+// reads the settings back
+#define USB_VENDOR_DYN 0x06
+// USB_VENDOR_DYN_METER: IN, a dyn_meter_t with the largest gain reduction
+// since the last read
+#define USB_VENDOR_DYN_METER 0x07
+// USB_VENDOR_SPECTRUM: a spectrum_config_t, OUT selects the analyzer
+// source, FFT size and report interval, IN reads them back. reports go out
+// on the interrupt endpoint of the vendor interface.
+#define USB_VENDOR_SPECTRUM 0x08
+// USB_VENDOR_SPECTRUM_STATS: IN, a spectrum_stats_t with the cycles per
+// frame
+#define USB_VENDOR_SPECTRUM_STATS 0x09
+// USB_VENDOR_GRAPH: graph_node_t entries, OUT replaces the processing
+// graph without stopping playback, no data stage leaves the output
+// unprocessed. IN reads the nodes back. an OUT the graph can not be planned
+// from stalls.
+#define USB_VENDOR_GRAPH 0x0a
+// USB_VENDOR_GRAPH_METER: IN, one int16_t per node index with the peak of
+// each meter node since the last read, 1/256 dBFS
+#define USB_VENDOR_GRAPH_METER 0x0b
+// USB_VENDOR_PROF: IN, a prof_stats_t with the cycle counts of probe
+// wIndex. wValue 1 starts the probe over after the read.
+#define USB_VENDOR_PROF 0x0c
+// USB_VENDOR_LOAD: IN, a load_stats_t with the CPU load
+#define USB_VENDOR_LOAD 0x0d
+// USB_VENDOR_DEADLINE: IN, a deadline_stats_t with the refill margins,
+// the processing tier and its last changes. the minimum margin starts over
+// after each read.
+#define USB_VENDOR_DEADLINE 0x0e
+
+// requests on the convolution engine stall while it is still switching
+// off, the host retries them
+#define USB_VENDOR_CONV_CHUNK 64
+
+usb_ctrl_result_t usb_vendor_request(const usb_setup_t *req);
+
+#endif
\ No newline at end of file
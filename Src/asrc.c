@@ -0,0 +1,306 @@
+#include "asrc.h"
+#include "audio_ring.h"
+#include "playback.h"
+#include <arm_math.h>
+
+#define ASRC_PHASES (1 << ASRC_PHASE_BITS)
+#define ASRC_PROTO_LEN (ASRC_PHASES * ASRC_TAPS + 1)
+// fraction bits of the read position below the phase index
+#define ASRC_FRAC_BITS (24 - ASRC_PHASE_BITS)
+
+// 8.24 correction per frame of fill error, and added to the integral per
+// window. about 15 ppm and 0.35 ppm, a damped loop with a time constant of
+// about three seconds. the integral takes over the clock offset and leaves
+// no standing fill error.
+#define ASRC_PROP_GAIN 256
+#define ASRC_INTEG_GAIN 6
+
+// windowed sinc, Kaiser beta 8, cutoff 0.45 fs, sampled at 64 times the
+// input rate. THD+N at 1000 ppm offset is below -85 dB up to 10 kHz and
+// -81 dB at 18 kHz. each polyphase branch sums to 1.0.
+static const q31_t proto[ASRC_PROTO_LEN] = {
+    -117460, -117424, -116412, -114356, -111186, -106833,
+    -101232, -94316, -86024, -76295, -65069, -52294,
+    -37917, -21890, -4171, 15279, 36493, 59501,
+    84325, 110981, 139479, 169823, 202009, 236025,
+    271853, 309466, 348828, 389895, 432615, 476926,
+    522757, 570027, 618646, 668516, 719525, 771557,
+    824480, 878157, 932440, 987169, 1042177, 1097288,
+    1152313, 1207059, 1261321, 1314886, 1367533, 1419036,
+    1469157, 1517654, 1564280, 1608779, 1650893, 1690358,
+    1726905, 1760264, 1790163, 1816326, 1838478, 1856344,
+    1869650, 1878124, 1881495, 1879499, 1871874, 1858366,
+    1838727, 1812716, 1780103, 1740667, 1694197, 1640496,
+    1579380, 1510680, 1434240, 1349923, 1257609, 1157198,
+    1048607, 931776, 806666, 673260, 531567, 381617,
+    223469, 57206, -117062, -299197, -489034, -686377,
+    -891002, -1102655, -1321053, -1545881, -1776795, -2013419,
+    -2255348, -2502143, -2753338, -3008436, -3266907, -3528196,
+    -3791716, -4056852, -4322962, -4589376, -4855398, -5120310,
+    -5383367, -5643801, -5900827, -6153635, -6401400, -6643280,
+    -6878417, -7105943, -7324974, -7534622, -7733989, -7922174,
+    -8098272, -8261380, -8410596, -8545023, -8663771, -8765963,
+    -8850732, -8917227, -8964616, -8992089, -8998857, -8984163,
+    -8947274, -8887494, -8804160, -8696650, -8564380, -8406814,
+    -8223459, -8013874, -7777671, -7514516, -7224132, -6906304,
+    -6560878, -6187766, -5786947, -5358468, -4902450, -4419084,
+    -3908639, -3371458, -2807962, -2218654, -1604114, -965005,
+    -302071, 383860, 1091880, 1820996, 2570131, 3338129,
+    4123748, 4925667, 5742484, 6572718, 7414809, 8267123,
+    9127949, 9995507, 10867945, 11743345, 12619723, 13495037,
+    14367186, 15234012, 16093311, 16942831, 17780275, 18603314,
+    19409582, 20196687, 20962213, 21703726, 22418782, 23104929,
+    23759716, 24380695, 24965431, 25511507, 26016529, 26478135,
+    26893999, 27261840, 27579425, 27844581, 28055198, 28209237,
+    28304735, 28339816, 28312693, 28221677, 28065184, 27841742,
+    27549993, 27188706, 26756778, 26253243, 25677273, 25028193,
+    24305475, 23508752, 22637817, 21692634, 20673334, 19580227,
+    18413800, 17174725, 15863856, 14482239, 13031109, 11511891,
+    9926208, 8275876, 6562904, 4789500, 2958065, 1071196,
+    -868320, -2857502, -4893181, -6972001, -9090425, -11244736,
+    -13431041, -15645278, -17883221, -20140484, -22412530, -24694673,
+    -26982091, -29269833, -31552821, -33825869, -36083682, -38320873,
+    -40531969, -42711424, -44853629, -46952924, -49003606, -50999948,
+    -52936204, -54806628, -56605483, -58327055, -59965667, -61515694,
+    -62971575, -64327826, -65579057, -66719986, -67745452, -68650427,
+    -69430038, -70079573, -70594499, -70970478, -71203378, -71289287,
+    -71224529, -71005675, -70629558, -70093286, -69394251, -68530147,
+    -67498976, -66299063, -64929066, -63387985, -61675174, -59790348,
+    -57733591, -55505367, -53106526, -50538309, -47802354, -44900704,
+    -41835807, -38610522, -35228121, -31692292, -28007136, -24177173,
+    -20207334, -16102965, -11869822, -7514065, -3042258, 1538642,
+    6221288, 10997949, 15860527, 20800556, 25809221, 30877364,
+    35995499, 41153828, 46342250, 51550380, 56767565, 61982900,
+    67185246, 72363253, 77505373, 82599886, 87634918, 92598466,
+    97478419, 102262581, 106938696, 111494473, 115917611, 120195823,
+    124316865, 128268562, 132038833, 135615720, 138987414, 142142288,
+    145068916, 147756109, 150192938, 152368767, 154273276, 155896491,
+    157228812, 158261041, 158984406, 159390593, 159471767, 159220602,
+    158630301, 157694629, 156407928, 154765145, 152761856, 150394284,
+    147659320, 144554545, 141078247, 137229440, 133007878, 128414074,
+    123449312, 118115658, 112415974, 106353930, 99934009, 93161514,
+    86042578, 78584166, 70794077, 62680945, 54254243, 45524274,
+    36502174, 27199902, 17630237, 7806766, -2256123, -12543258,
+    -23038688, -33725709, -44586873, -55604007, -66758240, -78030015,
+    -89399123, -100844719, -112345354, -123879001, -135423086, -146954519,
+    -158449723, -169884675, -181234934, -192475682, -203581760, -214527706,
+    -225287799, -235836093, -246146467, -256192662, -265948327, -275387064,
+    -284482471, -293208191, -301537954, -309445629, -316905267, -323891150,
+    -330377839, -336340219, -341753551, -346593519, -350836272, -354458479,
+    -357437371, -359750789, -361377230, -362295892, -362486719, -361930445,
+    -360608638, -358503740, -355599109, -351879059, -347328900, -341934971,
+    -335684682, -328566543, -320570203, -311686473, -301907364, -291226110,
+    -279637196, -267136381, -253720723, -239388593, -224139701, -207975108,
+    -190897240, -172909899, -154018275, -134228951, -113549909, -91990534,
+    -69561609, -46275321, -22145248, 2813643, 28585004, 55151124,
+    82492935, 110590035, 139420706, 168961930, 199189420, 230077640,
+    261599837, 293728070, 326433241, 359685132, 393452444, 427702829,
+    462402938, 497518462, 533014175, 568853980, 605000962, 641417434,
+    678064989, 714904556, 751896451, 789000434, 826175767, 863381272,
+    900575390, 937716241, 974761686, 1011669387, 1048396872, 1084901596,
+    1121141005, 1157072601, 1192654005, 1227843018, 1262597692, 1296876386,
+    1330637838, 1363841219, 1396446204, 1428413029, 1459702556, 1490276332,
+    1520096647, 1549126598, 1577330143, 1604672156, 1631118488, 1656636014,
+    1681192691, 1704757604, 1727301020, 1748794430, 1769210597, 1788523600,
+    1806708872, 1823743245, 1839604981, 1854273809, 1867730958, 1879959188,
+    1890942815, 1900667737, 1909121458, 1916293108, 1922173459, 1926754939,
+    1930031648, 1931999364, 1932655551, 1931999364, 1930031648, 1926754939,
+    1922173459, 1916293108, 1909121458, 1900667737, 1890942815, 1879959188,
+    1867730958, 1854273809, 1839604981, 1823743245, 1806708872, 1788523600,
+    1769210597, 1748794430, 1727301020, 1704757604, 1681192691, 1656636014,
+    1631118488, 1604672156, 1577330143, 1549126598, 1520096647, 1490276332,
+    1459702556, 1428413029, 1396446204, 1363841219, 1330637838, 1296876386,
+    1262597692, 1227843018, 1192654005, 1157072601, 1121141005, 1084901596,
+    1048396872, 1011669387, 974761686, 937716241, 900575390, 863381272,
+    826175767, 789000434, 751896451, 714904556, 678064989, 641417434,
+    605000962, 568853980, 533014175, 497518462, 462402938, 427702829,
+    393452444, 359685132, 326433241, 293728070, 261599837, 230077640,
+    199189420, 168961930, 139420706, 110590035, 82492935, 55151124,
+    28585004, 2813643, -22145248, -46275321, -69561609, -91990534,
+    -113549909, -134228951, -154018275, -172909899, -190897240, -207975108,
+    -224139701, -239388593, -253720723, -267136381, -279637196, -291226110,
+    -301907364, -311686473, -320570203, -328566543, -335684682, -341934971,
+    -347328900, -351879059, -355599109, -358503740, -360608638, -361930445,
+    -362486719, -362295892, -361377230, -359750789, -357437371, -354458479,
+    -350836272, -346593519, -341753551, -336340219, -330377839, -323891150,
+    -316905267, -309445629, -301537954, -293208191, -284482471, -275387064,
+    -265948327, -256192662, -246146467, -235836093, -225287799, -214527706,
+    -203581760, -192475682, -181234934, -169884675, -158449723, -146954519,
+    -135423086, -123879001, -112345354, -100844719, -89399123, -78030015,
+    -66758240, -55604007, -44586873, -33725709, -23038688, -12543258,
+    -2256123, 7806766, 17630237, 27199902, 36502174, 45524274,
+    54254243, 62680945, 70794077, 78584166, 86042578, 93161514,
+    99934009, 106353930, 112415974, 118115658, 123449312, 128414074,
+    133007878, 137229440, 141078247, 144554545, 147659320, 150394284,
+    152761856, 154765145, 156407928, 157694629, 158630301, 159220602,
+    159471767, 159390593, 158984406, 158261041, 157228812, 155896491,
+    154273276, 152368767, 150192938, 147756109, 145068916, 142142288,
+    138987414, 135615720, 132038833, 128268562, 124316865, 120195823,
+    115917611, 111494473, 106938696, 102262581, 97478419, 92598466,
+    87634918, 82599886, 77505373, 72363253, 67185246, 61982900,
+    56767565, 51550380, 46342250, 41153828, 35995499, 30877364,
+    25809221, 20800556, 15860527, 10997949, 6221288, 1538642,
+    -3042258, -7514065, -11869822, -16102965, -20207334, -24177173,
+    -28007136, -31692292, -35228121, -38610522, -41835807, -44900704,
+    -47802354, -50538309, -53106526, -55505367, -57733591, -59790348,
+    -61675174, -63387985, -64929066, -66299063, -67498976, -68530147,
+    -69394251, -70093286, -70629558, -71005675, -71224529, -71289287,
+    -71203378, -70970478, -70594499, -70079573, -69430038, -68650427,
+    -67745452, -66719986, -65579057, -64327826, -62971575, -61515694,
+    -59965667, -58327055, -56605483, -54806628, -52936204, -50999948,
+    -49003606, -46952924, -44853629, -42711424, -40531969, -38320873,
+    -36083682, -33825869, -31552821, -29269833, -26982091, -24694673,
+    -22412530, -20140484, -17883221, -15645278, -13431041, -11244736,
+    -9090425, -6972001, -4893181, -2857502, -868320, 1071196,
+    2958065, 4789500, 6562904, 8275876, 9926208, 11511891,
+    13031109, 14482239, 15863856, 17174725, 18413800, 19580227,
+    20673334, 21692634, 22637817, 23508752, 24305475, 25028193,
+    25677273, 26253243, 26756778, 27188706, 27549993, 27841742,
+    28065184, 28221677, 28312693, 28339816, 28304735, 28209237,
+    28055198, 27844581, 27579425, 27261840, 26893999, 26478135,
+    26016529, 25511507, 24965431, 24380695, 23759716, 23104929,
+    22418782, 21703726, 20962213, 20196687, 19409582, 18603314,
+    17780275, 16942831, 16093311, 15234012, 14367186, 13495037,
+    12619723, 11743345, 10867945, 9995507, 9127949, 8267123,
+    7414809, 6572718, 5742484, 4925667, 4123748, 3338129,
+    2570131, 1820996, 1091880, 383860, -302071, -965005,
+    -1604114, -2218654, -2807962, -3371458, -3908639, -4419084,
+    -4902450, -5358468, -5786947, -6187766, -6560878, -6906304,
+    -7224132, -7514516, -7777671, -8013874, -8223459, -8406814,
+    -8564380, -8696650, -8804160, -8887494, -8947274, -8984163,
+    -8998857, -8992089, -8964616, -8917227, -8850732, -8765963,
+    -8663771, -8545023, -8410596, -8261380, -8098272, -7922174,
+    -7733989, -7534622, -7324974, -7105943, -6878417, -6643280,
+    -6401400, -6153635, -5900827, -5643801, -5383367, -5120310,
+    -4855398, -4589376, -4322962, -4056852, -3791716, -3528196,
+    -3266907, -3008436, -2753338, -2502143, -2255348, -2013419,
+    -1776795, -1545881, -1321053, -1102655, -891002, -686377,
+    -489034, -299197, -117062, 57206, 223469, 381617,
+    531567, 673260, 806666, 931776, 1048607, 1157198,
+    1257609, 1349923, 1434240, 1510680, 1579380, 1640496,
+    1694197, 1740667, 1780103, 1812716, 1838727, 1858366,
+    1871874, 1879499, 1881495, 1878124, 1869650, 1856344,
+    1838478, 1816326, 1790163, 1760264, 1726905, 1690358,
+    1650893, 1608779, 1564280, 1517654, 1469157, 1419036,
+    1367533, 1314886, 1261321, 1207059, 1152313, 1097288,
+    1042177, 987169, 932440, 878157, 824480, 771557,
+    719525, 668516, 618646, 570027, 522757, 476926,
+    432615, 389895, 348828, 309466, 271853, 236025,
+    202009, 169823, 139479, 110981, 84325, 59501,
+    36493, 15279, -4171, -21890, -37917, -52294,
+    -65069, -76295, -86024, -94316, -101232, -106833,
+    -111186, -114356, -116412, -117424, -117460,
+};
+
+#if ASRC_TAPS & (ASRC_TAPS - 1)
+#error "ASRC_TAPS must be a power of two"
+#endif
+
+// input history per channel, stored twice so the newest ASRC_TAPS samples
+// are always contiguous from hist_idx, oldest first
+static q31_t hist[AUDIO_RING_FRAME_WORDS][2 * ASRC_TAPS];
+static uint32_t hist_idx;
+// read position between the two newest history frames, 8.24
+static uint32_t pos;
+static int32_t corr;
+static int32_t integ;
+
+// one block of input, at most one frame more than the output plus rounding
+static uint32_t in_buf[(PLAYBACK_MAX_HALF_FRAMES + 2) * AUDIO_RING_FRAME_WORDS];
+static q31_t coeffs[ASRC_TAPS];
+
+// for debug
+static volatile uint32_t short_cnt = 0;
+
+// start over at nominal ratio from silence, after a rate change
+void asrc_reset(void) {
+  for (uint32_t i = 0; i < 2 * ASRC_TAPS; i++) {
+    hist[0][i] = 0;
+    hist[1][i] = 0;
+  }
+  hist_idx = 0;
+  pos = 0;
+  corr = 0;
+  integ = 0;
+}
+
+// ratio offset in ppm, positive when consuming faster than nominal
+int32_t asrc_ratio_ppm(void) { return corr * 1000000LL / ASRC_ONE; }
+
+// PI control of the read step from the fill error in frames, once per
+// feedback window. the error is taken on a SOF with the DMA position
+// counted in, so unlike the ring level at a refill it does not jump by a
+// packet as the packets slide past the refills.
+void asrc_servo(int32_t err) {
+  integ += err * ASRC_INTEG_GAIN;
+  if (integ > ASRC_MAX_CORR) {
+    integ = ASRC_MAX_CORR;
+  } else if (integ < -ASRC_MAX_CORR) {
+    integ = -ASRC_MAX_CORR;
+  }
+
+  corr = err * ASRC_PROP_GAIN + integ;
+  if (corr > ASRC_MAX_CORR) {
+    corr = ASRC_MAX_CORR;
+  } else if (corr < -ASRC_MAX_CORR) {
+    corr = -ASRC_MAX_CORR;
+  }
+}
+
+static void asrc_push(const uint32_t *frame) {
+  hist[0][hist_idx] = hist[0][hist_idx + ASRC_TAPS] = frame[0];
+  hist[1][hist_idx] = hist[1][hist_idx + ASRC_TAPS] = frame[1];
+  hist_idx = (hist_idx + 1) & (ASRC_TAPS - 1);
+}
+
+// 16.48 dot product back to Q31
+static q31_t asrc_sat(q63_t acc) {
+  acc >>= 17;
+  if (acc > INT32_MAX) {
+    return INT32_MAX;
+  } else if (acc < INT32_MIN) {
+    return INT32_MIN;
+  }
+  return (q31_t)acc;
+}
+
+// resample the ring into frames stereo Q31 output frames. the input this
+// takes is known up front, if the ring holds less nothing is read and 0 is
+// returned, for playback to treat as an underrun.
+uint32_t asrc_process(uint32_t *dst, uint32_t frames) {
+  uint32_t step = ASRC_ONE + corr;
+  uint32_t need = (pos + (uint64_t)frames * step) >> 24;
+  if (audio_ring_fill(&audio_ring) < need * AUDIO_RING_FRAME_WORDS) {
+    short_cnt++;
+    return 0;
+  }
+  audio_ring_read(&audio_ring, in_buf, need * AUDIO_RING_FRAME_WORDS);
+
+  const uint32_t *in = in_buf;
+  for (uint32_t i = 0; i < frames; i++) {
+    // branch coefficients at the current phase, oldest tap first
+    const q31_t *h = &proto[(ASRC_TAPS - 1) * ASRC_PHASES +
+                            (pos >> ASRC_FRAC_BITS)];
+    int32_t w = (pos & ((1 << ASRC_FRAC_BITS) - 1)) << (31 - ASRC_FRAC_BITS);
+    for (uint32_t j = 0; j < ASRC_TAPS; j++) {
+      coeffs[j] = h[0] + (int32_t)(((int64_t)(h[1] - h[0]) * w) >> 31);
+      h -= ASRC_PHASES;
+    }
+
+    q63_t acc;
+    arm_dot_prod_q31(&hist[0][hist_idx], coeffs, ASRC_TAPS, &acc);
+    dst[0] = asrc_sat(acc);
+    arm_dot_prod_q31(&hist[1][hist_idx], coeffs, ASRC_TAPS, &acc);
+    dst[1] = asrc_sat(acc);
+    dst += AUDIO_RING_FRAME_WORDS;
+
+    pos += step;
+    while (pos >= ASRC_ONE) {
+      asrc_push(in);
+      in += AUDIO_RING_FRAME_WORDS;
+      pos -= ASRC_ONE;
+    }
+  }
+
+  return frames;
+}
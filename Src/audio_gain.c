@@ -0,0 +1,88 @@
+#include "audio_gain.h"
+#include <stm32f411xe.h>
+
+#define GAIN_STEPS (-AUDIO_GAIN_MIN / AUDIO_GAIN_RES + 1)
+
+// 32 x 16 multiplies keeping the top 32 bits, CMSIS has no intrinsic. the
+// C versions are for cores without the DSP extension, i.e. host builds.
+__STATIC_FORCEINLINE int32_t smulwb(uint32_t a, uint32_t b) {
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP == 1
+  int32_t r;
+  __ASM("smulwb %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+  return r;
+#else
+  return ((int64_t)(int32_t)a * (int16_t)b) >> 16;
+#endif
+}
+
+__STATIC_FORCEINLINE int32_t smulwt(uint32_t a, uint32_t b) {
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP == 1
+  int32_t r;
+  __ASM("smulwt %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+  return r;
+#else
+  return ((int64_t)(int32_t)a * (int16_t)(b >> 16)) >> 16;
+#endif
+}
+
+// 10^(-0.5 dB * i / 20) in Q15
+static const uint16_t gain_table[GAIN_STEPS] = {
+    32767, 30934, 29204, 27570, 26028, 24572, 23197, 21900,
+    20675, 19518, 18426, 17395, 16422, 15504, 14636, 13818,
+    13045, 12315, 11626, 10976, 10362, 9782, 9235, 8718,
+    8231, 7770, 7336, 6925, 6538, 6172, 5827, 5501,
+    5193, 4903, 4628, 4370, 4125, 3894, 3677, 3471,
+    3277, 3093, 2920, 2757, 2603, 2457, 2320, 2190,
+    2067, 1952, 1843, 1740, 1642, 1550, 1464, 1382,
+    1304, 1232, 1163, 1098, 1036, 978, 923, 872,
+    823, 777, 734, 693, 654, 617, 583, 550,
+    519, 490, 463, 437, 413, 389, 368, 347,
+    328, 309, 292, 276, 260, 246, 232, 219,
+    207, 195, 184, 174, 164, 155, 146, 138,
+    130, 123, 116, 110, 104, 98, 92, 87,
+    82, 78, 73, 69, 65, 62, 58, 55,
+    52, 49, 46, 44, 41, 39, 37, 35,
+    33,
+};
+
+// 1/256 dB to Q15, rounded to the nearest 0.5 dB step and clamped to the
+// range
+uint16_t audio_gain_q15(int32_t vol) {
+  if (vol > AUDIO_GAIN_MAX) {
+    vol = AUDIO_GAIN_MAX;
+  } else if (vol < AUDIO_GAIN_MIN) {
+    vol = AUDIO_GAIN_MIN;
+  }
+  return gain_table[(-vol + AUDIO_GAIN_RES / 2) / AUDIO_GAIN_RES];
+}
+
+// scale a block of Q31 frames in place. SMULWB/SMULWT take the 16-bit gain
+// of each channel straight from the packed word, the product is Q30. a
+// changed target is reached over the block with both halfwords stepped by
+// one SADD16 per frame. the steps truncate towards zero, so the ramp never
+// overshoots and the final snap to the target goes the same way.
+void audio_gain_apply(audio_gain_t *g, uint32_t *buf, uint32_t frames) {
+  uint32_t gain = g->gain;
+  uint32_t target = g->target;
+  uint32_t step = 0;
+
+  if (gain == target) {
+    if (gain == AUDIO_GAIN_UNITY) {
+      return;
+    }
+  } else if (frames > 0) {
+    int32_t step_l = ((int16_t)target - (int16_t)gain) / (int32_t)frames;
+    int32_t step_r =
+        ((int32_t)(target >> 16) - (int32_t)(gain >> 16)) / (int32_t)frames;
+    step = (step_l & 0xffff) | ((uint32_t)step_r << 16);
+  }
+
+  for (uint32_t i = 0; i < frames; i++) {
+    buf[0] = (uint32_t)smulwb(buf[0], gain) << 1;
+    buf[1] = (uint32_t)smulwt(buf[1], gain) << 1;
+    buf += 2;
+    gain = __SADD16(gain, step);
+  }
+
+  g->gain = target;
+}
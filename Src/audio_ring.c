@@ -0,0 +1,80 @@
+#include "audio_ring.h"
+#include <stm32f411xe.h>
+
+#define AUDIO_RING_MASK (AUDIO_RING_WORDS - 1)
+
+audio_ring_t audio_ring __attribute__((aligned(4)));
+
+uint32_t audio_ring_fill(const audio_ring_t *ring) {
+  return ring->head - ring->tail;
+}
+
+// producer side: reserve room for a whole packet so it can be written in
+// place, straight from the RX FIFO. a packet that does not fit is refused
+// as a unit, which keeps the sample alignment of the stream.
+int audio_ring_reserve(audio_ring_t *ring, uint32_t words,
+                       audio_ring_span_t *span) {
+  uint32_t head = ring->head;
+  uint32_t free = AUDIO_RING_WORDS - (head - ring->tail);
+
+  if (words > free) {
+    ring->overrun_cnt++;
+    return 0;
+  }
+
+  uint32_t idx = head & AUDIO_RING_MASK;
+  uint32_t first = AUDIO_RING_WORDS - idx;
+  if (first > words) {
+    first = words;
+  }
+
+  span->ptr[0] = &ring->buf[idx];
+  span->len[0] = first;
+  span->ptr[1] = ring->buf;
+  span->len[1] = words - first;
+
+  return 1;
+}
+
+// producer side: publish words written into the reserved span
+void audio_ring_commit(audio_ring_t *ring, uint32_t words) {
+  // data must be visible before the consumer sees the new head
+  __DMB();
+  ring->head += words;
+}
+
+// consumer side: returns the number of words copied. a short read counts
+// as an underrun, the caller is responsible for padding the rest.
+uint32_t audio_ring_read(audio_ring_t *ring, uint32_t *dst, uint32_t words) {
+  uint32_t tail = ring->tail;
+  uint32_t avail = ring->head - tail;
+
+  if (words > avail) {
+    ring->underrun_cnt++;
+    words = avail;
+  }
+  __DMB();
+
+  uint32_t idx = tail & AUDIO_RING_MASK;
+  uint32_t first = AUDIO_RING_WORDS - idx;
+  if (first > words) {
+    first = words;
+  }
+
+  const uint32_t *src = &ring->buf[idx];
+  for (uint32_t i = 0; i < first; i++) {
+    dst[i] = src[i];
+  }
+  src = ring->buf;
+  for (uint32_t i = 0; i < words - first; i++) {
+    dst[first + i] = src[i];
+  }
+
+  __DMB();
+  ring->tail = tail + words;
+
+  return words;
+}
+
+// consumer side: drop everything currently queued
+void audio_ring_flush(audio_ring_t *ring) { ring->tail = ring->head; }
@@ -0,0 +1,62 @@
+#include "audio_unpack.h"
+#include <stm32f411xe.h>
+
+#define LOAD32(p) __UNALIGNED_UINT32_READ(p)
+
+// the internal format is MSB aligned, so widening a sample is a shift or a
+// mask and the sign comes along for free. no per-byte work except for a
+// trailing odd frame of 24-in-3.
+
+void audio_unpack_16(const uint8_t *src, uint32_t *dst, uint32_t frames) {
+  for (; frames >= 2; frames -= 2) {
+    uint32_t w0 = LOAD32(src);
+    uint32_t w1 = LOAD32(src + 4);
+    dst[0] = w0 << 16;
+    dst[1] = w0 & 0xffff0000;
+    dst[2] = w1 << 16;
+    dst[3] = w1 & 0xffff0000;
+    src += 8;
+    dst += 4;
+  }
+  if (frames) {
+    uint32_t w = LOAD32(src);
+    dst[0] = w << 16;
+    dst[1] = w & 0xffff0000;
+  }
+}
+
+// two frames are three words:
+//   w0 = R0[7:0]  L0[23:0]
+//   w1 = L1[15:0] R0[23:8]
+//   w2 = R1[23:0] L1[23:16]
+void audio_unpack_24_3(const uint8_t *src, uint32_t *dst, uint32_t frames) {
+  for (; frames >= 2; frames -= 2) {
+    uint32_t w0 = LOAD32(src);
+    uint32_t w1 = LOAD32(src + 4);
+    uint32_t w2 = LOAD32(src + 8);
+    dst[0] = w0 << 8;
+    // R0[7:0] from the top of w0, R0[23:8] from the bottom of w1
+    dst[1] = __PKHBT(w0 >> 16, w1, 16) & 0xffffff00;
+    dst[2] = ((w1 >> 8) & 0x00ffff00) | (w2 << 24);
+    dst[3] = w2 & 0xffffff00;
+    src += 12;
+    dst += 4;
+  }
+  if (frames) {
+    dst[0] = (src[0] << 8) | (src[1] << 16) | ((uint32_t)src[2] << 24);
+    dst[1] = (src[3] << 8) | (src[4] << 16) | ((uint32_t)src[5] << 24);
+  }
+}
+
+// 24 valid bits MSB justified in a 4-byte subslot
+void audio_unpack_24_4(const uint8_t *src, uint32_t *dst, uint32_t frames) {
+  for (uint32_t i = 0; i < 2 * frames; i++) {
+    dst[i] = LOAD32(src + 4 * i) & 0xffffff00;
+  }
+}
+
+void audio_unpack_32(const uint8_t *src, uint32_t *dst, uint32_t frames) {
+  for (uint32_t i = 0; i < 2 * frames; i++) {
+    dst[i] = LOAD32(src + 4 * i);
+  }
+}
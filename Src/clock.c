@@ -22,3 +22,16 @@ void clock_init(void) {
   RCC->CFGR &= RCC_CFGR_SW;
   RCC->CFGR |= RCC_CFGR_SW_PLL;
 }
+
+void clock_plli2s_init(uint32_t m, uint32_t n, uint32_t r) {
+  RCC->CR &= ~RCC_CR_PLLI2SON;
+  while (RCC->CR & RCC_CR_PLLI2SRDY_Msk)
+    ;
+
+  RCC->PLLI2SCFGR = (m << RCC_PLLI2SCFGR_PLLI2SM_Pos) |
+                    (n << RCC_PLLI2SCFGR_PLLI2SN_Pos) |
+                    (r << RCC_PLLI2SCFGR_PLLI2SR_Pos);
+  RCC->CR |= RCC_CR_PLLI2SON;
+  while (!(RCC->CR & RCC_CR_PLLI2SRDY_Msk))
+    ;
+}
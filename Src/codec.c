@@ -0,0 +1,146 @@
+#include "codec.h"
+#include "i2c.h"
+#include <stddef.h>
+#include <stm32f411xe.h>
+
+// CS43L22 control port, AD0 tied low
+#define CODEC_ADDR 0x94
+// MAP bit for auto-incrementing register writes
+#define CODEC_INCR 0x80
+
+#define REG_POWER_CTL1 0x02
+#define REG_PLAYBACK_CTL2 0x0f
+#define REG_MASTER_A_VOL 0x20
+
+// headphone mute bits of PLAYBACK_CTL2
+#define HPA_MUTE 0x40
+#define HPB_MUTE 0x80
+
+// controls waiting to be written
+#define SYNC_VOLUME 0x01
+#define SYNC_MUTE 0x02
+
+// everything before the final power up, queued as one batch. the first
+// five writes are the required initialization settings of the datasheet.
+static const i2c_xfer_t power_up[] = {
+    {CODEC_ADDR, 0x00, 1, 0, {0x99}, NULL},
+    {CODEC_ADDR, 0x47, 1, 0, {0x80}, NULL},
+    {CODEC_ADDR, 0x32, 1, 0x80, {0x80}, NULL},
+    {CODEC_ADDR, 0x32, 1, 0x80, {0x00}, NULL},
+    {CODEC_ADDR, 0x00, 1, 0, {0x00}, NULL},
+    // headphones on and speaker off, clock auto detect, I2S slave up to
+    // 24 bits
+    {CODEC_ADDR, CODEC_INCR | 0x04, 3, 0, {0xaf, 0x80, 0x04}, NULL},
+};
+
+static uint8_t volume_regs[2];
+static uint8_t mute_reg;
+static volatile uint8_t dirty;
+static volatile uint8_t busy;
+
+// for debug
+static volatile uint32_t sync_cnt = 0;
+
+static void codec_sync(void);
+
+static void codec_sync_done(void) {
+  busy = 0;
+  codec_sync();
+}
+
+// write the controls changed since the last update. one batch is in flight
+// at a time and whatever changes meanwhile goes out with the next, so a
+// volume ramp from the host never backs up the I2C queue.
+static void codec_sync(void) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint8_t todo = busy ? 0 : dirty;
+  if (todo) {
+    busy = 1;
+    dirty = 0;
+  }
+  __set_PRIMASK(primask);
+
+  if (!todo) {
+    return;
+  }
+
+  sync_cnt++;
+  i2c_xfer_t volume = {CODEC_ADDR, CODEC_INCR | REG_MASTER_A_VOL, 2, 0,
+                       {volume_regs[0], volume_regs[1]}, NULL};
+  i2c_xfer_t mute = {CODEC_ADDR, REG_PLAYBACK_CTL2, 1, 0, {mute_reg}, NULL};
+
+  // the last write of the batch reports back
+  uint8_t last = (todo & SYNC_MUTE) ? SYNC_MUTE : SYNC_VOLUME;
+  if (last == SYNC_MUTE) {
+    mute.done = codec_sync_done;
+  } else {
+    volume.done = codec_sync_done;
+  }
+
+  uint8_t failed = 0;
+  if ((todo & SYNC_VOLUME) && !i2c_submit(&volume)) {
+    failed |= SYNC_VOLUME;
+  }
+  if ((todo & SYNC_MUTE) && !i2c_submit(&mute)) {
+    failed |= SYNC_MUTE;
+  }
+
+  // a full queue only delays the update until the next change
+  if (failed) {
+    __disable_irq();
+    dirty |= failed;
+    if (failed & last) {
+      busy = 0;
+    }
+    __set_PRIMASK(primask);
+  }
+}
+
+static void codec_mark(uint8_t bits) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  dirty |= bits;
+  __set_PRIMASK(primask);
+
+  codec_sync();
+}
+
+// queue the whole bring-up and return, it runs from the I2C interrupt
+// while USB enumerates. MCLK is already running from playback_init().
+// controls set in the meantime are written once the codec is powered.
+void codec_init(void) {
+  static const i2c_xfer_t power_on = {
+      CODEC_ADDR, REG_POWER_CTL1, 1, 0, {0x9e}, codec_sync_done};
+
+  // reset was held low since gpio_init() while the supplies settled
+  GPIOD->BSRR = GPIO_BSRR_BS4;
+
+  busy = 1;
+  dirty = SYNC_VOLUME | SYNC_MUTE;
+  for (uint8_t i = 0; i < sizeof(power_up) / sizeof(power_up[0]); i++) {
+    i2c_submit(&power_up[i]);
+  }
+  i2c_submit(&power_on);
+}
+
+// 1/256 dB to a master volume register, 0.5 dB steps in two's complement
+static uint8_t volume_reg(int16_t vol) {
+  if (vol < CODEC_VOLUME_MIN) {
+    vol = CODEC_VOLUME_MIN;
+  } else if (vol > CODEC_VOLUME_MAX) {
+    vol = CODEC_VOLUME_MAX;
+  }
+  return (uint8_t)((vol + CODEC_VOLUME_RES / 2) >> 7);
+}
+
+void codec_set_volume(int16_t left, int16_t right) {
+  volume_regs[0] = volume_reg(left);
+  volume_regs[1] = volume_reg(right);
+  codec_mark(SYNC_VOLUME);
+}
+
+void codec_set_mute(uint8_t left, uint8_t right) {
+  mute_reg = (left ? HPA_MUTE : 0) | (right ? HPB_MUTE : 0);
+  codec_mark(SYNC_MUTE);
+}
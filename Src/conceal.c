@@ -0,0 +1,53 @@
+#include "conceal.h"
+#include "audio_ring.h"
+
+#if CONCEAL_FADE_MS < 1 || CONCEAL_FADE_MS > 10
+#error "CONCEAL_FADE_MS must be between 1 and 10"
+#endif
+
+// the gain moves one step per frame between 0 and fade_len, linearly
+static uint32_t fade_len;
+static uint32_t gain;
+// Q31 gain of one step
+static int32_t step;
+
+volatile conceal_stats_t conceal_stats;
+
+// the output starts silent and fades in with the first data
+void conceal_set_rate(uint32_t rate) {
+  fade_len = rate / 1000 * CONCEAL_FADE_MS;
+  step = INT32_MAX / fade_len;
+  gain = 0;
+}
+
+uint32_t conceal_fade_frames(void) { return fade_len; }
+
+// frames left until silence when fading out
+uint32_t conceal_gain(void) { return gain; }
+
+// drop to silence at once, after the data ran out mid-fade
+void conceal_silence(void) { gain = 0; }
+
+// fade stereo Q31 frames towards silence or back to full scale. at full
+// scale and not going down the samples are left alone.
+void conceal_ramp(uint32_t *buf, uint32_t frames, uint8_t down) {
+  if (!down && gain == fade_len) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < frames; i++) {
+    if (down) {
+      if (gain > 0) {
+        gain--;
+      }
+    } else if (gain < fade_len) {
+      gain++;
+    }
+
+    int32_t g = (int32_t)gain * step;
+    for (uint32_t ch = 0; ch < AUDIO_RING_FRAME_WORDS; ch++) {
+      buf[ch] = ((int64_t)(int32_t)buf[ch] * g) >> 31;
+    }
+    buf += AUDIO_RING_FRAME_WORDS;
+  }
+}
@@ -0,0 +1,214 @@
+#include "conv.h"
+#include <arm_math.h>
+
+#if CONV_MAX_TAPS & (CONV_MAX_TAPS - 1) || CONV_MAX_TAPS < CONV_MAX_PARTITION
+#error "CONV_MAX_TAPS must be a power of two of at least CONV_MAX_PARTITION"
+#endif
+
+#define CONV_CHANNELS 2
+
+// uniformly partitioned overlap-save. every partition of the impulse
+// response is held as the spectrum of itself zero-padded to two partitions,
+// every input block as the spectrum of itself and the block before. one
+// output block is the sum over k of partition k times the input spectrum
+// k blocks back, of which the inverse transform keeps the second half.
+static float32_t ir[CONV_CHANNELS][2 * CONV_MAX_TAPS];
+// frequency-domain delay line, a ring of input spectra
+static float32_t fdl[CONV_CHANNELS][2 * CONV_MAX_TAPS];
+// last two input blocks, the newest filling up
+static float32_t overlap[CONV_CHANNELS][2 * CONV_MAX_PARTITION];
+// output block played while the next input block fills
+static float32_t out[CONV_CHANNELS][CONV_MAX_PARTITION];
+static float32_t fft_buf[2 * CONV_MAX_PARTITION];
+static float32_t acc[2 * CONV_MAX_PARTITION];
+
+static arm_rfft_fast_instance_f32 rfft;
+static uint32_t partition;
+static uint32_t parts;
+static uint32_t fill;
+static uint32_t slot;
+// partitions used are parts >> shorten, at least one, when the CPU is short
+static uint8_t shorten = 0;
+
+// the impulse response is written in the time domain, one partition at the
+// start of each spectrum slot, and transformed when the engine is enabled
+static uint8_t loading;
+// enabled from USB, running from the audio side. the audio side follows
+// at the start of each block, the buffers are only touched from USB once
+// both are clear.
+static volatile uint8_t enabled;
+static volatile uint8_t running;
+
+// for debug
+static volatile uint32_t part_cnt = 0;
+
+// pass-through with one partition of latency until the host loads a
+// response
+void conv_init(void) { conv_setup(CONV_DEFAULT_PARTITION, 1); }
+
+// start loading a new impulse response of the given length, a unit impulse
+// until written. returns 0 for unsupported sizes or while running.
+int conv_setup(uint16_t new_partition, uint16_t taps) {
+  if (running || new_partition < CONV_MIN_PARTITION ||
+      new_partition > CONV_MAX_PARTITION ||
+      (new_partition & (new_partition - 1)) || taps == 0 ||
+      taps > CONV_MAX_TAPS) {
+    return 0;
+  }
+
+  partition = new_partition;
+  parts = (taps + partition - 1) / partition;
+  arm_rfft_fast_init_f32(&rfft, 2 * partition);
+
+  for (uint32_t ch = 0; ch < CONV_CHANNELS; ch++) {
+    for (uint32_t i = 0; i < 2 * CONV_MAX_TAPS; i++) {
+      ir[ch][i] = 0.0f;
+    }
+    ir[ch][0] = 1.0f;
+  }
+  loading = 1;
+  return 1;
+}
+
+// write taps of the left (bit 0) and/or right (bit 1) channel
+int conv_load(uint8_t channels, uint16_t first, uint16_t count,
+              const float *taps) {
+  if (running || !loading || (uint32_t)first + count > parts * partition) {
+    return 0;
+  }
+
+  for (uint32_t ch = 0; ch < CONV_CHANNELS; ch++) {
+    if (!(channels & (1 << ch))) {
+      continue;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t tap = first + i;
+      ir[ch][2 * partition * (tap / partition) + tap % partition] = taps[i];
+    }
+  }
+  return 1;
+}
+
+// enabling transforms a freshly loaded response and starts from silence.
+// disabling bypasses the engine from the next block on.
+int conv_enable(uint8_t enable) {
+  if (!enable) {
+    enabled = 0;
+    return 1;
+  }
+  if (enabled) {
+    return 1;
+  }
+  if (running) {
+    return 0;
+  }
+
+  uint32_t n = 2 * partition;
+  if (loading) {
+    loading = 0;
+    for (uint32_t ch = 0; ch < CONV_CHANNELS; ch++) {
+      for (uint32_t k = 0; k < parts; k++) {
+        float32_t *h = &ir[ch][k * n];
+        for (uint32_t i = 0; i < n; i++) {
+          fft_buf[i] = i < partition ? h[i] : 0.0f;
+        }
+        arm_rfft_fast_f32(&rfft, fft_buf, h, 0);
+      }
+    }
+  }
+
+  for (uint32_t ch = 0; ch < CONV_CHANNELS; ch++) {
+    for (uint32_t i = 0; i < parts * n; i++) {
+      fdl[ch][i] = 0.0f;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      overlap[ch][i] = 0.0f;
+    }
+    for (uint32_t i = 0; i < partition; i++) {
+      out[ch][i] = 0.0f;
+    }
+  }
+  fill = 0;
+  slot = 0;
+
+  running = 1;
+  enabled = 1;
+  return 1;
+}
+
+// once per block from the audio interrupt, before any processing
+void conv_sync(void) { running = enabled; }
+
+uint8_t conv_active(void) { return running; }
+
+// drop the tail of the response, from the audio side. the delay line keeps
+// running in full, so the tail comes back without a gap in its history.
+void conv_set_shorten(uint8_t shift) { shorten = shift; }
+
+// acc += h * x for spectra in the packed format of arm_rfft_fast_f32: DC
+// and Nyquist as two reals, then complex bins
+static void conv_mac(const float32_t *h, const float32_t *x, uint32_t n) {
+  acc[0] += h[0] * x[0];
+  acc[1] += h[1] * x[1];
+  for (uint32_t i = 2; i < n; i += 2) {
+    acc[i] += h[i] * x[i] - h[i + 1] * x[i + 1];
+    acc[i + 1] += h[i] * x[i + 1] + h[i + 1] * x[i];
+  }
+}
+
+static void conv_partition(void) {
+  uint32_t n = 2 * partition;
+  uint32_t used = parts >> shorten;
+
+  if (used == 0) {
+    used = 1;
+  }
+  part_cnt++;
+  for (uint32_t ch = 0; ch < CONV_CHANNELS; ch++) {
+    for (uint32_t i = 0; i < n; i++) {
+      fft_buf[i] = overlap[ch][i];
+    }
+    arm_rfft_fast_f32(&rfft, fft_buf, &fdl[ch][slot * n], 0);
+    for (uint32_t i = 0; i < partition; i++) {
+      overlap[ch][i] = overlap[ch][partition + i];
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+      acc[i] = 0.0f;
+    }
+    uint32_t s = slot;
+    for (uint32_t k = 0; k < used; k++) {
+      conv_mac(&ir[ch][k * n], &fdl[ch][s * n], n);
+      s = s ? s - 1 : parts - 1;
+    }
+
+    arm_rfft_fast_f32(&rfft, acc, fft_buf, 1);
+    for (uint32_t i = 0; i < partition; i++) {
+      out[ch][i] = fft_buf[partition + i];
+    }
+  }
+
+  slot = (slot + 1 < parts) ? slot + 1 : 0;
+}
+
+// filter interleaved stereo frames in place, one partition behind. a
+// partition is processed each time its input is complete, so the cost per
+// block depends on how the partitions fall.
+void conv_process(float32_t *buf, uint32_t frames) {
+  if (!running) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < frames; i++) {
+    for (uint32_t ch = 0; ch < CONV_CHANNELS; ch++) {
+      overlap[ch][partition + fill] = buf[ch];
+      buf[ch] = out[ch][fill];
+    }
+    buf += CONV_CHANNELS;
+
+    if (++fill == partition) {
+      fill = 0;
+      conv_partition();
+    }
+  }
+}
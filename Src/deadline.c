@@ -0,0 +1,107 @@
+#include "deadline.h"
+#include "conv.h"
+#include "peq.h"
+#include "playback.h"
+#include "spectrum.h"
+
+// what runs at each tier, cheapest loss first. the limiter is never shed.
+typedef struct {
+  uint8_t peq_bands;
+  uint8_t conv_shorten; // response cut to 1 / 2^conv_shorten
+  uint8_t spectrum;
+} deadline_tier_t;
+
+static const deadline_tier_t tiers[DEADLINE_TIERS] = {
+    {PEQ_MAX_BANDS, 0, 1},
+    {PEQ_MAX_BANDS, 0, 0},
+    {PEQ_MAX_BANDS, 1, 0},
+    {PEQ_MAX_BANDS / 2, 2, 0},
+    {2, 3, 0},
+};
+
+volatile deadline_stats_t deadline_stats;
+
+// refills in a row with the margin above DEADLINE_HIGH
+static uint32_t good;
+// cost of the tier before each one relative to it in Q8, from the refills
+// either side of the last step down. 0 until the refill after the step,
+// shed_cost is the one before it.
+static uint32_t ratio[DEADLINE_TIERS];
+static uint32_t shed_cost;
+
+static void deadline_apply(uint8_t tier, uint16_t margin) {
+  const deadline_tier_t *t = &tiers[tier];
+  volatile deadline_event_t *e = &deadline_stats.log[deadline_stats.log_pos];
+
+  e->pos = playback_position();
+  e->from = deadline_stats.tier;
+  e->to = tier;
+  e->margin = margin;
+  deadline_stats.log_pos = (deadline_stats.log_pos + 1) % DEADLINE_LOG;
+  deadline_stats.tier = tier;
+
+  peq_set_limit(t->peq_bands);
+  conv_set_shorten(t->conv_shorten);
+  spectrum_set_bypass(!t->spectrum);
+}
+
+void deadline_init(void) { deadline_stats.margin_min = DEADLINE_FULL; }
+
+// after each refill, with the frames the DMA still had to play before
+// reaching the refilled half. a miss or near miss sheds a tier at once, a
+// tier comes back only after a stretch of comfortable margins, and only if
+// the cost it added when last shed, scaled to the load now, still leaves
+// the margin above DEADLINE_LOW. a tier can cost more than the difference
+// between the thresholds once the stages run slow.
+void deadline_check(uint32_t left, uint32_t frames) {
+  uint16_t margin = 0;
+
+  if (left > frames) {
+    deadline_stats.miss_cnt++;
+  } else {
+    margin = (uint64_t)left * DEADLINE_FULL / frames;
+    if (margin < DEADLINE_LOW) {
+      deadline_stats.near_cnt++;
+    }
+  }
+
+  deadline_stats.refill_cnt++;
+  deadline_stats.margin_last = margin;
+  if (margin < deadline_stats.margin_min) {
+    deadline_stats.margin_min = margin;
+  }
+
+  uint8_t tier = deadline_stats.tier;
+  uint32_t cost = DEADLINE_FULL - margin;
+  if (tier > 0 && ratio[tier] == 0) {
+    ratio[tier] = cost ? (shed_cost << 8) / cost : 1 << 8;
+  }
+  // the margin the tier before would leave at the load now
+  uint32_t restored = DEADLINE_FULL;
+  if (tier > 0) {
+    uint64_t c = (uint64_t)cost * ratio[tier] >> 8;
+    restored = c < DEADLINE_FULL ? DEADLINE_FULL - c : 0;
+  }
+
+  if (margin < DEADLINE_LOW) {
+    good = 0;
+    if (tier + 1 < DEADLINE_TIERS) {
+      deadline_stats.down_cnt++;
+      shed_cost = cost;
+      ratio[tier + 1] = 0;
+      deadline_apply(tier + 1, margin);
+    }
+  } else if (margin < DEADLINE_HIGH || restored < DEADLINE_LOW) {
+    good = 0;
+  } else if (++good >= DEADLINE_HOLD && tier > 0) {
+    good = 0;
+    deadline_stats.up_cnt++;
+    deadline_apply(tier - 1, margin);
+  }
+}
+
+// from USB, which the audio side can not preempt
+void deadline_read(deadline_stats_t *stats) {
+  *stats = deadline_stats;
+  deadline_stats.margin_min = DEADLINE_FULL;
+}
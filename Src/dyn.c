@@ -0,0 +1,433 @@
+#include "dyn.h"
+#include "playback.h"
+#include <math.h>
+#include <string.h>
+#include <stm32f411xe.h>
+
+#define DYN_MAX_LOOKAHEAD (PLAYBACK_MAX_RATE / 1000 * DYN_LOOKAHEAD_MS)
+// entries of the sliding minimum, a power of two above the look-ahead
+#define DYN_HOLD_LEN 128
+#define DYN_HOLD_MASK (DYN_HOLD_LEN - 1)
+#define DYN_MAX_FRAMES PLAYBACK_MAX_HALF_FRAMES
+// highest crossover frequency relative to the rate
+#define DYN_MAX_FREQ 0.45f
+// gain smoothed by the limiter in Q24, exact sums over the look-ahead
+#define DYN_GAIN_ONE (1 << 24)
+
+#define DYN_DB_PER_LOG2 6.0205999f
+
+#if DYN_HOLD_LEN < DYN_MAX_LOOKAHEAD
+#error "DYN_HOLD_LEN must cover the look-ahead"
+#endif
+
+// coefficients per biquad, b0 b1 b2 -a1 -a2 normalized to a0 = 1
+#define DYN_COEFFS 5
+
+typedef enum {
+  XOVER_LOW_PASS,
+  XOVER_HIGH_PASS,
+  XOVER_ALL_PASS,
+} xover_type_t;
+
+// Linkwitz-Riley crossovers of fourth order, each a Butterworth biquad
+// twice. the low band also goes through the allpass the mid/high split
+// adds to the others, so the three bands sum back flat.
+typedef struct {
+  arm_biquad_cascade_stereo_df2T_instance_f32 inst;
+  float32_t coeffs[2 * DYN_COEFFS];
+  float32_t state[2 * 4];
+} xover_t;
+
+typedef struct {
+  float32_t threshold; // dB
+  float32_t slope;     // gain reduction per dB over the threshold
+  float32_t gr;        // smoothed gain reduction, dB
+  float32_t max_gr;
+} band_t;
+
+static dyn_params_t params = {
+    .limiter = 1,
+    .compressor = 0,
+    .ceiling = -64,
+    .release = 50,
+    .xover = {200, 2000},
+    .threshold = {-20 * 256, -20 * 256, -20 * 256},
+    .ratio = {512, 512, 512},
+    .attack = 5,
+    .comp_release = 100,
+};
+static uint32_t rate = PLAYBACK_DEFAULT_RATE;
+
+// settings from USB, taken over by the audio side at the start of a block
+static dyn_params_t next;
+static uint32_t next_rate;
+static volatile uint8_t pending;
+
+static uint8_t limiter_on;
+static uint8_t compressor_on;
+
+static xover_t low_pass[2];
+static xover_t high_pass[2];
+static xover_t all_pass;
+static band_t bands[DYN_BANDS];
+static float32_t attack_coef;
+static float32_t release_coef;
+static float32_t low[DYN_MAX_FRAMES * 2];
+static float32_t mid[DYN_MAX_FRAMES * 2];
+static float32_t high[DYN_MAX_FRAMES * 2];
+
+// limiter. the gain each frame needs to stay under the ceiling is held at
+// its minimum over the look-ahead, released upward only, and averaged over
+// the look-ahead again. the average starts falling one look-ahead before
+// a peak and is at or below the gain the peak needs when it leaves the
+// delay line.
+static float32_t ceiling;
+static float32_t lim_release;
+static uint32_t lookahead;
+static float32_t delay[DYN_MAX_LOOKAHEAD][2];
+static uint32_t delay_pos;
+static float32_t hold_gain[DYN_HOLD_LEN];
+static uint32_t hold_frame[DYN_HOLD_LEN];
+static uint32_t hold_head;
+static uint32_t hold_tail;
+static uint32_t frame;
+static float32_t release_gain;
+static int32_t box[DYN_MAX_LOOKAHEAD];
+static uint32_t box_pos;
+static int32_t box_sum;
+static float32_t box_scale;
+static float32_t lim_max_gr;
+
+// for debug
+static volatile uint32_t update_cnt = 0;
+static volatile uint32_t clamp_cnt = 0;
+
+// log2 and 2^x to about 0.01 dB, a mantissa polynomial each. the M4 build
+// of arm_vlog_f32 and arm_vexp_f32 loops over logf and expf.
+static inline float32_t dyn_log2(float32_t x) {
+  union {
+    float32_t f;
+    uint32_t i;
+  } v = {x};
+  float32_t e = (float32_t)(int32_t)((v.i >> 23) & 0xff) - 128.0f;
+
+  v.i = (v.i & 0x007fffff) | 0x3f800000;
+  return e + (-0.34484843f * v.f + 2.02466578f) * v.f - 0.67487759f;
+}
+
+static inline float32_t dyn_exp2(float32_t x) {
+  union {
+    float32_t f;
+    uint32_t i;
+  } v;
+
+  if (x < -126.0f) {
+    return 0.0f;
+  }
+  int32_t i = (int32_t)x;
+  if ((float32_t)i > x) {
+    i--;
+  }
+  float32_t f = x - (float32_t)i;
+
+  v.i = (uint32_t)(i + 127) << 23;
+  return v.f *
+         (1.0f + f * (0.69606564f + f * (0.22449434f + f * 0.07944024f)));
+}
+
+// RBJ audio EQ cookbook at Q 1/sqrt(2), twice for the low and high pass
+static void dyn_xover(xover_t *x, xover_type_t type, float32_t freq) {
+  float32_t w0 = 2.0f * PI * freq / rate;
+  float32_t cw = cosf(w0);
+  float32_t alpha = sinf(w0) * 0.70710678f;
+  float32_t a0 = 1.0f + alpha;
+  float32_t *c = x->coeffs;
+
+  switch (type) {
+  case XOVER_LOW_PASS:
+    c[0] = c[2] = (1.0f - cw) / (2.0f * a0);
+    c[1] = (1.0f - cw) / a0;
+    break;
+  case XOVER_HIGH_PASS:
+    c[0] = c[2] = (1.0f + cw) / (2.0f * a0);
+    c[1] = -(1.0f + cw) / a0;
+    break;
+  case XOVER_ALL_PASS:
+    c[0] = (1.0f - alpha) / a0;
+    c[1] = -2.0f * cw / a0;
+    c[2] = 1.0f;
+    break;
+  }
+  c[3] = 2.0f * cw / a0;
+  c[4] = -(1.0f - alpha) / a0;
+
+  for (uint8_t i = DYN_COEFFS; i < 2 * DYN_COEFFS; i++) {
+    c[i] = c[i - DYN_COEFFS];
+  }
+}
+
+// coefficient time constant of an exponential smoother
+static float32_t dyn_coef(uint16_t ms) {
+  return 1.0f - expf(-1000.0f / ((ms ? ms : 1) * (float32_t)rate));
+}
+
+static void dyn_limiter_reset(void) {
+  lookahead = rate / 1000 * DYN_LOOKAHEAD_MS;
+  memset(delay, 0, sizeof(delay));
+  delay_pos = 0;
+  hold_head = hold_tail = 0;
+  release_gain = 1.0f;
+  for (uint32_t i = 0; i < lookahead; i++) {
+    box[i] = DYN_GAIN_ONE;
+  }
+  box_pos = 0;
+  box_sum = lookahead * DYN_GAIN_ONE;
+  box_scale = 1.0f / ((float32_t)box_sum);
+}
+
+// derive everything from the settings, from the audio side
+static void dyn_update(uint8_t reset) {
+  float32_t nyquist = DYN_MAX_FREQ * rate;
+  float32_t f1 = params.xover[0] < nyquist ? params.xover[0] : nyquist;
+  float32_t f2 = params.xover[1] < nyquist ? params.xover[1] : nyquist;
+
+  update_cnt++;
+
+  // a limiter switched on starts from a clean delay line, the crossovers
+  // from clean state as well
+  if (reset || (params.limiter && !limiter_on)) {
+    dyn_limiter_reset();
+  }
+  if (reset || (params.compressor && !compressor_on)) {
+    xover_t *x[] = {&low_pass[0], &low_pass[1], &high_pass[0], &high_pass[1],
+                    &all_pass};
+    for (uint8_t i = 0; i < sizeof(x) / sizeof(x[0]); i++) {
+      memset(x[i]->state, 0, sizeof(x[i]->state));
+    }
+    for (uint8_t i = 0; i < DYN_BANDS; i++) {
+      bands[i].gr = 0.0f;
+    }
+  }
+
+  dyn_xover(&low_pass[0], XOVER_LOW_PASS, f1);
+  dyn_xover(&high_pass[0], XOVER_HIGH_PASS, f1);
+  dyn_xover(&low_pass[1], XOVER_LOW_PASS, f2);
+  dyn_xover(&high_pass[1], XOVER_HIGH_PASS, f2);
+  dyn_xover(&all_pass, XOVER_ALL_PASS, f2);
+
+  ceiling = powf(10.0f, params.ceiling / (256.0f * 20.0f));
+  lim_release = dyn_coef(params.release);
+  attack_coef = dyn_coef(params.attack);
+  release_coef = dyn_coef(params.comp_release);
+  for (uint8_t i = 0; i < DYN_BANDS; i++) {
+    bands[i].threshold = params.threshold[i] / 256.0f;
+    bands[i].slope = 1.0f - 256.0f / params.ratio[i];
+  }
+
+  limiter_on = params.limiter;
+  compressor_on = params.compressor;
+}
+
+void dyn_init(void) {
+  xover_t *x[] = {&low_pass[0], &low_pass[1], &high_pass[0], &high_pass[1]};
+  for (uint8_t i = 0; i < sizeof(x) / sizeof(x[0]); i++) {
+    arm_biquad_cascade_stereo_df2T_init_f32(&x[i]->inst, 2, x[i]->coeffs,
+                                            x[i]->state);
+  }
+  arm_biquad_cascade_stereo_df2T_init_f32(&all_pass.inst, 1, all_pass.coeffs,
+                                          all_pass.state);
+
+  next = params;
+  next_rate = rate;
+  pending = 1;
+}
+
+// from the output restart when the rate changes, takes effect with the
+// next block
+void dyn_set_rate(uint32_t new_rate) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  next_rate = new_rate;
+  pending = 1;
+  __set_PRIMASK(primask);
+}
+
+// returns 0 for settings out of range
+int dyn_set_params(const dyn_params_t *p) {
+  if (p->ceiling > 0 || p->ceiling < -24 * 256 || p->xover[0] < 20 ||
+      p->xover[0] >= p->xover[1]) {
+    return 0;
+  }
+  for (uint8_t i = 0; i < DYN_BANDS; i++) {
+    if (p->ratio[i] < 256 || p->threshold[i] > 0) {
+      return 0;
+    }
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  next = *p;
+  pending = 1;
+  __set_PRIMASK(primask);
+  return 1;
+}
+
+void dyn_get_params(dyn_params_t *p) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *p = next;
+  __set_PRIMASK(primask);
+}
+
+// the largest gain reduction since the last read, and start over
+void dyn_read_meter(dyn_meter_t *meter) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  meter->limiter = (uint16_t)(lim_max_gr * 256.0f);
+  lim_max_gr = 0.0f;
+  for (uint8_t i = 0; i < DYN_BANDS; i++) {
+    meter->band[i] = (uint16_t)(bands[i].max_gr * 256.0f);
+    bands[i].max_gr = 0.0f;
+  }
+  __set_PRIMASK(primask);
+}
+
+// take over new settings, from the audio DMA interrupt at the start of a
+// block
+void dyn_sync(void) {
+  if (!pending) {
+    return;
+  }
+
+  __disable_irq();
+  uint8_t reset = next_rate != rate;
+  params = next;
+  rate = next_rate;
+  pending = 0;
+  __enable_irq();
+
+  dyn_update(reset);
+}
+
+uint8_t dyn_active(void) { return limiter_on || compressor_on; }
+
+// compress one band in place, stereo linked
+static void dyn_band(band_t *b, float32_t *x, uint32_t frames) {
+  float32_t gr = b->gr;
+  float32_t max_gr = b->max_gr;
+
+  for (uint32_t i = 0; i < frames; i++, x += 2) {
+    float32_t l = fabsf(x[0]);
+    float32_t r = fabsf(x[1]);
+    float32_t level = DYN_DB_PER_LOG2 * dyn_log2((l > r ? l : r) + 1e-9f);
+    float32_t over = level - b->threshold;
+    float32_t target = over > 0.0f ? over * b->slope : 0.0f;
+
+    gr += (target > gr ? attack_coef : release_coef) * (target - gr);
+    float32_t g = dyn_exp2(gr * (-1.0f / DYN_DB_PER_LOG2));
+    x[0] *= g;
+    x[1] *= g;
+    if (gr > max_gr) {
+      max_gr = gr;
+    }
+  }
+
+  b->gr = gr;
+  b->max_gr = max_gr;
+}
+
+static void dyn_compress(float32_t *buf, uint32_t frames) {
+  arm_biquad_cascade_stereo_df2T_f32(&low_pass[0].inst, buf, low, frames);
+  arm_biquad_cascade_stereo_df2T_f32(&all_pass.inst, low, low, frames);
+  arm_biquad_cascade_stereo_df2T_f32(&high_pass[0].inst, buf, mid, frames);
+  arm_biquad_cascade_stereo_df2T_f32(&high_pass[1].inst, mid, high, frames);
+  arm_biquad_cascade_stereo_df2T_f32(&low_pass[1].inst, mid, mid, frames);
+
+  dyn_band(&bands[0], low, frames);
+  dyn_band(&bands[1], mid, frames);
+  dyn_band(&bands[2], high, frames);
+
+  arm_add_f32(low, mid, buf, 2 * frames);
+  arm_add_f32(buf, high, buf, 2 * frames);
+}
+
+static void dyn_limit(float32_t *buf, uint32_t frames) {
+  float32_t min_gain = 1.0f;
+
+  for (uint32_t i = 0; i < frames; i++, buf += 2, frame++) {
+    float32_t l = fabsf(buf[0]);
+    float32_t r = fabsf(buf[1]);
+    float32_t peak = l > r ? l : r;
+    float32_t need = peak > ceiling ? ceiling / peak : 1.0f;
+
+    // sliding minimum over the look-ahead, increasing from the head
+    while (hold_tail != hold_head &&
+           hold_gain[(hold_tail - 1) & DYN_HOLD_MASK] >= need) {
+      hold_tail--;
+    }
+    hold_gain[hold_tail & DYN_HOLD_MASK] = need;
+    hold_frame[hold_tail & DYN_HOLD_MASK] = frame;
+    hold_tail++;
+    if (frame - hold_frame[hold_head & DYN_HOLD_MASK] >= lookahead) {
+      hold_head++;
+    }
+    float32_t hold = hold_gain[hold_head & DYN_HOLD_MASK];
+
+    if (hold < release_gain) {
+      release_gain = hold;
+    } else {
+      release_gain += lim_release * (hold - release_gain);
+    }
+
+    // truncated to Q24, never above the gain released
+    int32_t q = (int32_t)(release_gain * DYN_GAIN_ONE);
+    box_sum += q - box[box_pos];
+    box[box_pos] = q;
+    if (++box_pos == lookahead) {
+      box_pos = 0;
+    }
+    float32_t g = box_sum * box_scale;
+
+    // delayed by one look-ahead less a frame, the average ends on the
+    // frame going out
+    float32_t out_l = delay[delay_pos][0] * g;
+    float32_t out_r = delay[delay_pos][1] * g;
+    delay[delay_pos][0] = buf[0];
+    delay[delay_pos][1] = buf[1];
+    if (++delay_pos == lookahead - 1) {
+      delay_pos = 0;
+    }
+
+    // rounding only
+    if (fabsf(out_l) > ceiling || fabsf(out_r) > ceiling) {
+      clamp_cnt++;
+      out_l = out_l > ceiling ? ceiling : out_l < -ceiling ? -ceiling : out_l;
+      out_r = out_r > ceiling ? ceiling : out_r < -ceiling ? -ceiling : out_r;
+    }
+    buf[0] = out_l;
+    buf[1] = out_r;
+
+    if (g < min_gain) {
+      min_gain = g;
+    }
+  }
+
+  float32_t gr = -DYN_DB_PER_LOG2 * dyn_log2(min_gain);
+  if (gr > lim_max_gr) {
+    lim_max_gr = gr;
+  }
+}
+
+// compress and limit interleaved stereo frames in place
+void dyn_process(float32_t *buf, uint32_t frames) {
+  if (frames == 0) {
+    return;
+  }
+
+  if (compressor_on) {
+    dyn_compress(buf, frames);
+  }
+  if (limiter_on) {
+    dyn_limit(buf, frames);
+  }
+}
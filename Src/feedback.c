@@ -0,0 +1,133 @@
+#include "feedback.h"
+#include "asrc.h"
+#include "audio_ring.h"
+#include "playback.h"
+#include "prof.h"
+#include <stm32f411xe.h>
+
+// SOFs per measurement window (power of two)
+#define FEEDBACK_WINDOW_SHIFT 6
+// time constant of the rate low-pass, in windows (power of two)
+#define FEEDBACK_FILTER_SHIFT 3
+// 10.14 correction per frame of ring fill error, pulls the fill level back
+// to the center of the ring with a time constant of about one second
+#define FEEDBACK_FILL_GAIN 16
+
+// a fill error this large in frames for this many windows in a row, about
+// a second, means the host is not following the feedback. the resampler
+// takes over the rate matching from then on. a quarter of the ring leaves
+// room for that second at 1000 ppm and the fade to the resampler.
+#define FEEDBACK_IGNORED_FILL 256
+#define FEEDBACK_IGNORED_WINDOWS 16
+
+// samples per frame in 10.14
+#define FEEDBACK_NOMINAL(rate) ((uint32_t)(((rate) << 14) / 1000))
+
+// nominal value of the current rate, the output is kept within 1/64 of it
+static uint32_t nominal;
+// frames queued ahead of the I2S with the ring at its center, the DMA
+// buffer holding a half-buffer and a half on average
+static uint32_t center;
+static volatile uint32_t feedback;
+static uint32_t rate_acc;
+static uint32_t last_pos = 0;
+static uint8_t primed = 0;
+static uint8_t ignored = 0;
+
+// for debug
+static volatile uint32_t window_cnt = 0;
+static volatile uint32_t last_delta = 0;
+
+// TIM2 counts OTG_FS SOF pulses through ITR1 and interrupts once per
+// measurement window. the window handler samples how many frames I2S has
+// consumed, which gives the device clock measured in host frames.
+void feedback_init(void) {
+  RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+  feedback_set_rate(playback_rate());
+
+  TIM2->OR = TIM_OR_ITR1_RMP_1;
+  TIM2->SMCR = (1 << TIM_SMCR_TS_Pos) | (7 << TIM_SMCR_SMS_Pos);
+  TIM2->PSC = 0;
+  TIM2->ARR = (1 << FEEDBACK_WINDOW_SHIFT) - 1;
+  TIM2->EGR = TIM_EGR_UG;
+  TIM2->SR &= ~TIM_SR_UIF;
+  TIM2->DIER |= TIM_DIER_UIE;
+  // same priority as the I2S DMA so playback_position() is never torn
+  NVIC_SetPriority(TIM2_IRQn, 1);
+  NVIC_EnableIRQ(TIM2_IRQn);
+  TIM2->CR1 |= TIM_CR1_CEN;
+}
+
+// restart the measurement from the nominal value after a rate change
+void feedback_set_rate(uint32_t rate) {
+  nominal = FEEDBACK_NOMINAL(rate);
+  center = AUDIO_RING_WORDS / 2 / AUDIO_RING_FRAME_WORDS +
+           3 * (rate / 1000 * PLAYBACK_BUFFER_MS) / 2;
+  feedback = nominal;
+  rate_acc = nominal << FEEDBACK_FILTER_SHIFT;
+  primed = 0;
+  ignored = 0;
+}
+
+// samples per frame in 10.14 format, as sent on the feedback endpoint
+uint32_t feedback_value(void) { return feedback; }
+
+// one measurement window
+static void feedback_window(void) {
+  window_cnt++;
+
+  uint32_t pos = playback_position();
+  uint32_t delta = pos - last_pos;
+  last_pos = pos;
+  if (!primed) {
+    primed = 1;
+    return;
+  }
+  last_delta = delta;
+
+  uint32_t rate = delta << (14 - FEEDBACK_WINDOW_SHIFT);
+  rate_acc += rate - (rate_acc >> FEEDBACK_FILTER_SHIFT);
+
+  // the window does not line up with the refills, so the DMA buffer is
+  // counted in to keep the error from jumping by a half-buffer
+  int32_t err = (int32_t)(audio_ring_fill(&audio_ring) /
+                              AUDIO_RING_FRAME_WORDS +
+                          playback_queued() - center);
+
+  // with the resampler on the host gets the nominal rate and the ring
+  // fill is left to the resampler
+  if (playback_asrc()) {
+    feedback = nominal;
+    ignored = 0;
+    asrc_servo(err);
+    return;
+  }
+  if (playback_playing() &&
+      (err >= FEEDBACK_IGNORED_FILL || err <= -FEEDBACK_IGNORED_FILL)) {
+    if (++ignored >= FEEDBACK_IGNORED_WINDOWS) {
+      playback_set_asrc(1);
+    }
+  } else {
+    ignored = 0;
+  }
+
+  int32_t fb = (int32_t)(rate_acc >> FEEDBACK_FILTER_SHIFT) -
+               err * FEEDBACK_FILL_GAIN;
+
+  uint32_t limit = nominal >> 6;
+  if (fb > (int32_t)(nominal + limit)) {
+    fb = nominal + limit;
+  } else if (fb < (int32_t)(nominal - limit)) {
+    fb = nominal - limit;
+  }
+  feedback = fb;
+}
+
+void TIM2_IRQHandler(void) {
+  PROF_BEGIN(start);
+  if (TIM2->SR & TIM_SR_UIF_Msk) {
+    TIM2->SR &= ~TIM_SR_UIF;
+    feedback_window();
+  }
+  PROF_END(PROF_FEEDBACK, start);
+}
@@ -2,7 +2,9 @@
 #include <stm32f411xe.h>
 
 void gpio_init(void) {
-  RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN | RCC_AHB1ENR_GPIODEN;
+  RCC->AHB1ENR |=
+      RCC_AHB1ENR_GPIOAEN | RCC_AHB1ENR_GPIOBEN | RCC_AHB1ENR_GPIOCEN |
+      RCC_AHB1ENR_GPIODEN;
 
   GPIOA->MODER &= ~(GPIO_MODER_MODE11 | GPIO_MODER_MODE12);
   GPIOA->MODER |= GPIO_MODER_MODE11_1 | GPIO_MODER_MODE12_1;
@@ -10,6 +12,41 @@ void gpio_init(void) {
       (10 << GPIO_AFRH_AFSEL11_Pos) | (10 << GPIO_AFRH_AFSEL12_Pos);
   GPIOA->OSPEEDR |= GPIO_OSPEEDR_OSPEED11 | GPIO_OSPEEDR_OSPEED12;
 
-  GPIOD->MODER &= ~GPIO_MODER_MODE15;
-  GPIOD->MODER |= GPIO_MODER_MODE15_0;
+  // I2S3: PA4 WS, PC7 MCK, PC10 SCK, PC12 SD
+  GPIOA->MODER &= ~GPIO_MODER_MODE4;
+  GPIOA->MODER |= GPIO_MODER_MODE4_1;
+  GPIOA->AFR[0] |= 6 << GPIO_AFRL_AFSEL4_Pos;
+  GPIOA->OSPEEDR |= GPIO_OSPEEDR_OSPEED4;
+
+  GPIOC->MODER &= ~(GPIO_MODER_MODE7 | GPIO_MODER_MODE10 | GPIO_MODER_MODE12);
+  GPIOC->MODER |=
+      GPIO_MODER_MODE7_1 | GPIO_MODER_MODE10_1 | GPIO_MODER_MODE12_1;
+  GPIOC->AFR[0] |= 6 << GPIO_AFRL_AFSEL7_Pos;
+  GPIOC->AFR[1] |=
+      (6 << GPIO_AFRH_AFSEL10_Pos) | (6 << GPIO_AFRH_AFSEL12_Pos);
+  GPIOC->OSPEEDR |=
+      GPIO_OSPEEDR_OSPEED7 | GPIO_OSPEEDR_OSPEED10 | GPIO_OSPEEDR_OSPEED12;
+
+  // I2S2 for the MP45DT02: PB10 CK, PC3 SD
+  GPIOB->MODER &= ~GPIO_MODER_MODE10;
+  GPIOB->MODER |= GPIO_MODER_MODE10_1;
+  GPIOB->AFR[1] |= 5 << GPIO_AFRH_AFSEL10_Pos;
+  GPIOB->OSPEEDR |= GPIO_OSPEEDR_OSPEED10;
+
+  GPIOC->MODER &= ~GPIO_MODER_MODE3;
+  GPIOC->MODER |= GPIO_MODER_MODE3_1;
+  GPIOC->AFR[0] |= 5 << GPIO_AFRL_AFSEL3_Pos;
+
+  // I2C1 for the CS43L22: PB6 SCL, PB9 SDA, open drain to the board's
+  // pull-ups
+  GPIOB->MODER &= ~(GPIO_MODER_MODE6 | GPIO_MODER_MODE9);
+  GPIOB->MODER |= GPIO_MODER_MODE6_1 | GPIO_MODER_MODE9_1;
+  GPIOB->OTYPER |= GPIO_OTYPER_OT6 | GPIO_OTYPER_OT9;
+  GPIOB->AFR[0] |= 4 << GPIO_AFRL_AFSEL6_Pos;
+  GPIOB->AFR[1] |= 4 << GPIO_AFRH_AFSEL9_Pos;
+
+  // PD4 CS43L22 reset, low until codec_init()
+  GPIOD->BSRR = GPIO_BSRR_BR4;
+  GPIOD->MODER &= ~(GPIO_MODER_MODE4 | GPIO_MODER_MODE15);
+  GPIOD->MODER |= GPIO_MODER_MODE4_0 | GPIO_MODER_MODE15_0;
 }
@@ -0,0 +1,319 @@
+#include "graph.h"
+#include "conv.h"
+#include "dyn.h"
+#include "peq.h"
+#include "playback.h"
+#include "prof.h"
+#include <arm_math.h>
+#include <math.h>
+#include <stm32f411xe.h>
+
+#define GRAPH_CHANNELS 2
+// frames of a 1 ms block at the highest rate
+#define GRAPH_BLOCK_MAX (PLAYBACK_MAX_RATE / 1000)
+// lowest meter reading, 1/256 dB
+#define GRAPH_METER_FLOOR INT16_MIN
+
+// a node with its signals bound to arena slots
+typedef struct {
+  uint8_t type;
+  uint8_t in[2];
+  uint8_t out;
+  float32_t gain; // linear, GRAPH_GAIN
+} graph_step_t;
+
+typedef struct {
+  graph_step_t steps[GRAPH_MAX_NODES];
+  uint8_t count;
+  uint8_t out; // slot played
+} graph_plan_t;
+
+// runs a step in place on its output slot, the input already copied there
+typedef void (*graph_fn_t)(const graph_step_t *step, uint8_t index,
+                           float32_t *buf, uint32_t frames);
+
+static graph_node_t nodes[GRAPH_MAX_NODES];
+static uint8_t node_count;
+
+// double-buffered plans, the same handover as the EQ coefficients. the
+// USB side plans into the one not in use and marks it pending, the audio
+// side switches at the start of a refill.
+static graph_plan_t plans[2];
+static volatile uint8_t active = 0;
+static volatile uint8_t pending = 0;
+
+// every buffer the graph uses. slot 0 takes the input of each block.
+static float32_t arena[GRAPH_MAX_SLOTS][GRAPH_BLOCK_MAX * GRAPH_CHANNELS];
+static volatile uint32_t block = PLAYBACK_DEFAULT_RATE / 1000;
+
+// per node index and kept across plans, so a gain resent with the same
+// topology ramps from where it was
+static float32_t gain_now[GRAPH_MAX_NODES];
+static float32_t peak[GRAPH_MAX_NODES];
+// a read from USB only flags the meters, each starts over at its next block
+static volatile uint8_t meter_reset[GRAPH_MAX_NODES];
+
+// for debug
+static volatile uint32_t swap_cnt = 0;
+static volatile uint32_t block_cnt = 0;
+
+static void graph_gain(const graph_step_t *step, uint8_t index,
+                       float32_t *buf, uint32_t frames) {
+  float32_t g = gain_now[index];
+  float32_t inc = (step->gain - g) / frames;
+
+  for (uint32_t i = 0; i < frames; i++, buf += GRAPH_CHANNELS) {
+    g += inc;
+    buf[0] *= g;
+    buf[1] *= g;
+  }
+  gain_now[index] = step->gain;
+}
+
+static void graph_peq(const graph_step_t *step, uint8_t index,
+                      float32_t *buf, uint32_t frames) {
+  peq_process(buf, frames);
+}
+
+static void graph_conv(const graph_step_t *step, uint8_t index,
+                       float32_t *buf, uint32_t frames) {
+  conv_process(buf, frames);
+}
+
+static void graph_dyn(const graph_step_t *step, uint8_t index,
+                      float32_t *buf, uint32_t frames) {
+  dyn_process(buf, frames);
+}
+
+static void graph_meter(const graph_step_t *step, uint8_t index,
+                        float32_t *buf, uint32_t frames) {
+  float32_t max = peak[index];
+
+  if (meter_reset[index]) {
+    meter_reset[index] = 0;
+    max = 0.0f;
+  }
+  for (uint32_t i = 0; i < frames * GRAPH_CHANNELS; i++) {
+    float32_t v = fabsf(buf[i]);
+    if (v > max) {
+      max = v;
+    }
+  }
+  peak[index] = max;
+}
+
+static const graph_fn_t graph_fns[GRAPH_NUM_TYPES] = {
+    [GRAPH_GAIN] = graph_gain,   [GRAPH_PEQ] = graph_peq,
+    [GRAPH_CONV] = graph_conv,   [GRAPH_DYN] = graph_dyn,
+    [GRAPH_METER] = graph_meter,
+};
+
+// bind every signal to a slot from its producer to its last reader. slots
+// freed by the last read of an input are taken by the output of the same
+// node, in place on the first input where possible. returns 0 for a
+// malformed graph or one that needs more slots than the arena has.
+static int graph_plan(uint8_t count, const graph_node_t *src,
+                      graph_plan_t *plan) {
+  uint8_t last_use[GRAPH_MAX_NODES + 1] = {0};
+  uint8_t slot_of[GRAPH_MAX_NODES + 1];
+  uint32_t modules = 0;
+  uint32_t free_slots = ((1u << GRAPH_MAX_SLOTS) - 1) & ~1u;
+
+  if (count > GRAPH_MAX_NODES) {
+    return 0;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    const graph_node_t *node = &src[i];
+    uint8_t inputs = node->type == GRAPH_MIX ? 2 : 1;
+
+    if (node->type >= GRAPH_NUM_TYPES) {
+      return 0;
+    }
+    if (node->type == GRAPH_PEQ || node->type == GRAPH_CONV ||
+        node->type == GRAPH_DYN) {
+      if (modules & (1u << node->type)) {
+        return 0;
+      }
+      modules |= 1u << node->type;
+    }
+    for (uint8_t k = 0; k < inputs; k++) {
+      if (node->in[k] > i) {
+        return 0;
+      }
+      last_use[node->in[k]] = i + 1;
+    }
+  }
+  // the played signal is read after the last node
+  last_use[count] = count + 1;
+
+  slot_of[0] = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const graph_node_t *node = &src[i];
+    graph_step_t *step = &plan->steps[i];
+    uint8_t inputs = node->type == GRAPH_MIX ? 2 : 1;
+
+    step->type = node->type;
+    step->in[1] = 0;
+    for (uint8_t k = 0; k < inputs; k++) {
+      step->in[k] = slot_of[node->in[k]];
+      if (last_use[node->in[k]] == i + 1) {
+        free_slots |= 1u << step->in[k];
+      }
+    }
+
+    uint8_t slot = step->in[0];
+    if (!(free_slots & (1u << slot))) {
+      if (free_slots == 0) {
+        return 0;
+      }
+      slot = __CLZ(__RBIT(free_slots));
+    }
+    free_slots &= ~(1u << slot);
+    // nothing reads it, the slot is free again right after
+    if (last_use[i + 1] == 0) {
+      free_slots |= 1u << slot;
+    }
+    slot_of[i + 1] = slot;
+    step->out = slot;
+    step->gain = powf(10.0f, node->param / (256.0f * 20.0f));
+  }
+
+  plan->count = count;
+  plan->out = slot_of[count];
+  return 1;
+}
+
+// the chain the firmware had before the graph: EQ, room correction and
+// dynamics in place
+void graph_init(void) {
+  static const graph_node_t chain[] = {
+      {GRAPH_PEQ, {0, 0}, 0, 0},
+      {GRAPH_CONV, {1, 0}, 0, 0},
+      {GRAPH_DYN, {2, 0}, 0, 0},
+  };
+
+  for (uint8_t i = 0; i < GRAPH_MAX_NODES; i++) {
+    gain_now[i] = 1.0f;
+  }
+  graph_set_nodes(sizeof(chain) / sizeof(chain[0]), chain);
+}
+
+void graph_set_rate(uint32_t rate) { block = rate / 1000; }
+
+// plan a new graph from USB, played from the next refill on. returns 0,
+// keeping the current graph, if it can not be planned.
+int graph_set_nodes(uint8_t count, const graph_node_t *src) {
+  graph_plan_t *plan = &plans[active ^ 1];
+
+  if (!graph_plan(count, src, plan)) {
+    return 0;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    nodes[i] = src[i];
+  }
+  node_count = count;
+  pending = 1;
+  return 1;
+}
+
+uint8_t graph_get_nodes(graph_node_t *dst) {
+  for (uint8_t i = 0; i < node_count; i++) {
+    dst[i] = nodes[i];
+  }
+  return node_count;
+}
+
+// peak of every meter node since the last read in 1/256 dBFS, by node
+// index, and start over
+void graph_read_meters(int16_t *peaks) {
+  for (uint8_t i = 0; i < GRAPH_MAX_NODES; i++) {
+    float32_t p = meter_reset[i] ? 0.0f : peak[i];
+    int32_t level = GRAPH_METER_FLOOR;
+    if (p > 0.0f) {
+      level = (int32_t)(20.0f * 256.0f * log10f(p));
+    }
+    if (level < GRAPH_METER_FLOOR) {
+      level = GRAPH_METER_FLOOR;
+    } else if (level > INT16_MAX) {
+      level = INT16_MAX;
+    }
+    peaks[i] = level;
+    meter_reset[i] = 1;
+  }
+}
+
+// take over a pending plan, from the audio DMA interrupt at the start of a
+// refill
+void graph_sync(void) {
+  if (pending) {
+    __disable_irq();
+    active ^= 1;
+    pending = 0;
+    __enable_irq();
+    swap_cnt++;
+  }
+}
+
+// whether running the graph changes anything, so the conversions can be
+// skipped
+uint8_t graph_active(void) {
+  const graph_plan_t *plan = &plans[active];
+
+  for (uint8_t i = 0; i < plan->count; i++) {
+    switch (plan->steps[i].type) {
+    case GRAPH_PEQ:
+      if (peq_active()) {
+        return 1;
+      }
+      break;
+    case GRAPH_CONV:
+      if (conv_active()) {
+        return 1;
+      }
+      break;
+    case GRAPH_DYN:
+      if (dyn_active()) {
+        return 1;
+      }
+      break;
+    default:
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// run interleaved stereo Q31 frames through the graph in place, in blocks
+// of 1 ms and a shorter one for what is left
+void graph_process(int32_t *buf, uint32_t frames) {
+  const graph_plan_t *plan = &plans[active];
+
+  while (frames > 0) {
+    uint32_t n = frames < block ? frames : block;
+
+    arm_q31_to_float(buf, arena[0], n * GRAPH_CHANNELS);
+    for (uint8_t i = 0; i < plan->count; i++) {
+      const graph_step_t *step = &plan->steps[i];
+      float32_t *out = arena[step->out];
+      PROF_BEGIN(start);
+
+      if (step->type == GRAPH_MIX) {
+        arm_add_f32(arena[step->in[0]], arena[step->in[1]], out,
+                    n * GRAPH_CHANNELS);
+      } else {
+        if (step->in[0] != step->out) {
+          arm_copy_f32(arena[step->in[0]], out, n * GRAPH_CHANNELS);
+        }
+        graph_fns[step->type](step, i, out, n);
+      }
+      PROF_END(PROF_GRAPH_GAIN + step->type, start);
+    }
+    arm_float_to_q31(arena[plan->out], buf, n * GRAPH_CHANNELS);
+
+    buf += n * GRAPH_CHANNELS;
+    frames -= n;
+    block_cnt++;
+  }
+}
@@ -0,0 +1,234 @@
+#include "i2c.h"
+#include <stddef.h>
+#include <stm32f411xe.h>
+
+#define I2C_QUEUE_MASK (I2C_QUEUE_LEN - 1)
+
+// APB1 clock in MHz
+#define I2C_PCLK_MHZ 48
+// APB2 timer clock in MHz
+#define I2C_TIM_MHZ 96
+// a STOP is over within a few microseconds at 100 kHz
+#define I2C_RETRY_US 10
+// standard mode, the CS43L22 control port stops at 100 kHz
+#define I2C_SCL_HZ 100000
+
+typedef enum {
+  I2C_IDLE,
+  I2C_START,      // waiting for SB, then ADDR of the write
+  I2C_TX,         // register address and data, one byte per TXE
+  I2C_LAST,       // last byte handed over, waiting for BTF
+  I2C_READ_START, // repeated START of the read in a read-modify-write
+  I2C_READ,       // waiting for the one byte read
+} i2c_state_t;
+
+// transfers are queued at head and retired at tail, from the interrupt.
+// both are only updated with interrupts masked, so any priority may queue.
+static i2c_xfer_t queue[I2C_QUEUE_LEN];
+static uint32_t head;
+static uint32_t tail;
+static volatile i2c_state_t state = I2C_IDLE;
+static uint8_t tx_idx;
+static uint8_t read_done;
+// a START that had to wait for the previous STOP, retried from TIM11
+static volatile uint8_t start_pending = 0;
+
+// for debug
+static volatile uint32_t xfer_cnt = 0;
+static volatile uint32_t err_cnt = 0;
+static volatile uint32_t queue_full_cnt = 0;
+static volatile uint32_t stop_wait_cnt = 0;
+
+void i2c_init(void) {
+  RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
+
+  I2C1->CR1 = I2C_CR1_SWRST;
+  I2C1->CR1 = 0;
+  I2C1->CR2 = I2C_CR2_ITEVTEN | I2C_CR2_ITERREN |
+              (I2C_PCLK_MHZ << I2C_CR2_FREQ_Pos);
+  I2C1->CCR = I2C_PCLK_MHZ * 1000000 / (2 * I2C_SCL_HZ);
+  // 1000 ns maximum rise time
+  I2C1->TRISE = I2C_PCLK_MHZ + 1;
+
+  // the lowest priority in use, a late event only stretches the clock
+  NVIC_SetPriority(I2C1_EV_IRQn, 3);
+  NVIC_SetPriority(I2C1_ER_IRQn, 3);
+  NVIC_EnableIRQ(I2C1_EV_IRQn);
+  NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+  // one-shot of I2C_RETRY_US that retries a START held by a STOP, at the
+  // same priority so it never preempts the event interrupt
+  RCC->APB2ENR |= RCC_APB2ENR_TIM11EN;
+  TIM11->CR1 = TIM_CR1_OPM;
+  TIM11->PSC = I2C_TIM_MHZ - 1;
+  TIM11->ARR = I2C_RETRY_US - 1;
+  TIM11->DIER = TIM_DIER_UIE;
+  NVIC_SetPriority(TIM1_TRG_COM_TIM11_IRQn, 3);
+  NVIC_EnableIRQ(TIM1_TRG_COM_TIM11_IRQn);
+
+  // ACK stays off, nothing longer than one byte is ever read
+  I2C1->CR1 = I2C_CR1_PE;
+}
+
+// start the transfer at the tail, interrupts masked. CR1 must not be
+// written while a STOP is still being generated, the start is then retried
+// by the TIM11 one-shot rather than at once.
+static void i2c_start(void) {
+  if (I2C1->CR1 & I2C_CR1_STOP) {
+    stop_wait_cnt++;
+    start_pending = 1;
+    TIM11->CNT = 0;
+    TIM11->CR1 |= TIM_CR1_CEN;
+    return;
+  }
+
+  start_pending = 0;
+  state = I2C_START;
+  read_done = 0;
+  I2C1->CR1 |= I2C_CR1_START;
+}
+
+// the event interrupt starts the waiting transfer, or waits again
+void TIM1_TRG_COM_TIM11_IRQHandler(void) {
+  TIM11->SR &= ~TIM_SR_UIF;
+  if (start_pending) {
+    NVIC_SetPendingIRQ(I2C1_EV_IRQn);
+  }
+}
+
+// queue a register write. returns 0, dropping it, if the queue is full
+int i2c_submit(const i2c_xfer_t *xfer) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  if (head - tail >= I2C_QUEUE_LEN) {
+    queue_full_cnt++;
+    __set_PRIMASK(primask);
+    return 0;
+  }
+
+  queue[head & I2C_QUEUE_MASK] = *xfer;
+  head++;
+  if (state == I2C_IDLE) {
+    i2c_start();
+  }
+
+  __set_PRIMASK(primask);
+  return 1;
+}
+
+// retire the current transfer. the next one follows with a repeated START,
+// the bus is only released once the queue is empty or after an error.
+static void i2c_finish(uint8_t failed) {
+  i2c_done_t done = queue[tail & I2C_QUEUE_MASK].done;
+
+  tail++;
+  xfer_cnt++;
+  if (done != NULL) {
+    done();
+  }
+
+  __disable_irq();
+  if (!failed && head != tail) {
+    state = I2C_START;
+    read_done = 0;
+    I2C1->CR1 |= I2C_CR1_START;
+  } else {
+    state = I2C_IDLE;
+    I2C1->CR1 |= I2C_CR1_STOP;
+    if (head != tail) {
+      i2c_start();
+    }
+  }
+  __enable_irq();
+}
+
+// one event per interrupt. flags the current state does not wait for, like
+// BTF until the requested START or STOP is on the bus, are left alone.
+void I2C1_EV_IRQHandler(void) {
+  uint32_t sr1 = I2C1->SR1;
+  i2c_xfer_t *xfer = &queue[tail & I2C_QUEUE_MASK];
+
+  switch (state) {
+  case I2C_IDLE:
+    __disable_irq();
+    if (state == I2C_IDLE && head != tail) {
+      i2c_start();
+    }
+    __enable_irq();
+    break;
+
+  case I2C_START:
+    if (sr1 & I2C_SR1_SB_Msk) {
+      I2C1->DR = xfer->addr;
+    } else if (sr1 & I2C_SR1_ADDR_Msk) {
+      (void)I2C1->SR2;
+      tx_idx = 0;
+      state = I2C_TX;
+      I2C1->CR2 |= I2C_CR2_ITBUFEN;
+    }
+    break;
+
+  case I2C_TX:
+    if (sr1 & I2C_SR1_TXE_Msk) {
+      // the read half of a read-modify-write only sends the address
+      uint8_t len = (xfer->mask && !read_done) ? 0 : xfer->len;
+      I2C1->DR = (tx_idx == 0) ? xfer->reg : xfer->data[tx_idx - 1];
+      if (tx_idx++ == len) {
+        I2C1->CR2 &= ~I2C_CR2_ITBUFEN;
+        state = I2C_LAST;
+      }
+    }
+    break;
+
+  case I2C_LAST:
+    if (sr1 & I2C_SR1_BTF_Msk) {
+      if (xfer->mask && !read_done) {
+        state = I2C_READ_START;
+        I2C1->CR1 |= I2C_CR1_START;
+      } else {
+        i2c_finish(0);
+      }
+    }
+    break;
+
+  case I2C_READ_START:
+    if (sr1 & I2C_SR1_SB_Msk) {
+      I2C1->DR = xfer->addr | 1;
+    } else if (sr1 & I2C_SR1_ADDR_Msk) {
+      // single byte read: the repeated START of the write half has to be
+      // requested right after ADDR is cleared, before the byte is in
+      __disable_irq();
+      (void)I2C1->SR2;
+      I2C1->CR1 |= I2C_CR1_START;
+      __enable_irq();
+      state = I2C_READ;
+      I2C1->CR2 |= I2C_CR2_ITBUFEN;
+    }
+    break;
+
+  case I2C_READ:
+    if (sr1 & I2C_SR1_RXNE_Msk) {
+      uint8_t val = I2C1->DR;
+      xfer->data[0] = (val & ~xfer->mask) | (xfer->data[0] & xfer->mask);
+      read_done = 1;
+      I2C1->CR2 &= ~I2C_CR2_ITBUFEN;
+      state = I2C_START;
+    }
+    break;
+  }
+}
+
+// a NACK, bus error or lost arbitration drops the current transfer
+void I2C1_ER_IRQHandler(void) {
+  uint32_t errs = I2C1->SR1 & (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF |
+                               I2C_SR1_OVR | I2C_SR1_TIMEOUT);
+
+  I2C1->SR1 = ~errs;
+  err_cnt++;
+  I2C1->CR2 &= ~I2C_CR2_ITBUFEN;
+
+  if (state != I2C_IDLE) {
+    i2c_finish(1);
+  }
+}
@@ -0,0 +1,82 @@
+#include "load.h"
+#include <stm32f411xe.h>
+
+// core clock as set up by clock_init
+#define LOAD_CYCLES_PER_MS 96000
+
+volatile load_stats_t load_stats;
+
+static uint32_t window_start;
+static uint32_t idle;
+// sums of the 1 ms windows of the running 100 ms and 1 s windows
+static uint32_t tenth_busy, tenth_total, tenth_cnt;
+static uint32_t second_busy, second_total, second_cnt;
+static uint16_t second_max;
+
+static uint16_t load_of(uint32_t busy, uint32_t total) {
+  return (uint64_t)busy * LOAD_FULL / total;
+}
+
+// close the 1 ms window and the longer ones it completes
+static void load_window(uint32_t total) {
+  uint32_t busy = total - idle;
+  uint16_t load = load_of(busy, total);
+
+  load_stats.window_cnt++;
+  load_stats.load_1ms = load;
+  if (total >= 2 * LOAD_CYCLES_PER_MS) {
+    load_stats.late_cnt++;
+  }
+  if (load > second_max) {
+    second_max = load;
+  }
+
+  tenth_busy += busy;
+  tenth_total += total;
+  if (++tenth_cnt < 100) {
+    return;
+  }
+  load_stats.load_100ms = load_of(tenth_busy, tenth_total);
+  second_busy += tenth_busy;
+  second_total += tenth_total;
+  tenth_busy = 0;
+  tenth_total = 0;
+  tenth_cnt = 0;
+  if (++second_cnt < 10) {
+    return;
+  }
+  load_stats.load_1s = load_of(second_busy, second_total);
+  load_stats.max_1ms = second_max;
+  second_busy = 0;
+  second_total = 0;
+  second_cnt = 0;
+  second_max = 0;
+}
+
+// the cycle counter runs from prof_init() on
+void load_init(void) {
+  // keep the core clock, and with it the cycle counter, running in sleep
+  DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+
+  window_start = DWT->CYCCNT;
+}
+
+// one pass of the main loop. sleeps until an interrupt is pending, with
+// interrupts masked so that the handler runs after the idle time has been
+// taken and counts as busy.
+void load_idle(void) {
+  __disable_irq();
+  uint32_t start = DWT->CYCCNT;
+  __DSB();
+  __WFI();
+  uint32_t end = DWT->CYCCNT;
+  __enable_irq();
+
+  idle += end - start;
+  uint32_t total = end - window_start;
+  if (total >= LOAD_CYCLES_PER_MS) {
+    load_window(total);
+    window_start = end;
+    idle = 0;
+  }
+}
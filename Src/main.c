@@ -1,15 +1,32 @@
 #include "clock.h"
+#include "codec.h"
+#include "feedback.h"
 #include "gpio.h"
+#include "i2c.h"
+#include "load.h"
+#include "mic.h"
+#include "playback.h"
+#include "prof.h"
+#include "spectrum.h"
 #include "tim.h"
 #include "usb.h"
 #include <stm32f411xe.h>
 
 int main(void) {
   clock_init();
+  prof_init();
   gpio_init();
   tim1_init();
+  playback_init();
+  mic_init();
+  spectrum_init();
+  i2c_init();
+  codec_init();
+  feedback_init();
   usb_init();
+  load_init();
 
-  while (1)
-    ;
+  while (1) {
+    load_idle();
+  }
 }
@@ -0,0 +1,297 @@
+#include "mic.h"
+#include "playback.h"
+#include "prof.h"
+#include "spectrum.h"
+#include <arm_math.h>
+#include <stm32f411xe.h>
+
+// PDM bits per PCM sample. 64 keeps the bit clock near 3 MHz up to 48 kHz,
+// above that the MP45DT02 clock limit halves it.
+#define MIC_DECIMATION(rate) ((rate) > 48000 ? 32 : 64)
+
+// the first stage turns every PDM byte into one sample, the rest halves
+// the rate per stage down to MIC_BLOCK_FRAMES
+#define CIC_DECIMATION 8
+#define MAX_CIC_FRAMES (MIC_BLOCK_FRAMES * 64 / CIC_DECIMATION)
+// 16-bit DMA transfers per half-buffer
+#define MAX_PDM_XFERS (MAX_CIC_FRAMES / 2)
+
+#define HBA_TAPS 11
+#define HBB_TAPS 19
+#define FINAL_TAPS 64
+// fast Q31 FIR input headroom, log2(FINAL_TAPS)
+#define FINAL_HEADROOM 6
+
+// sinc^4 CIC: 29 taps spread over the 32 bits of the last four bytes. each
+// table holds the partial sum of one byte position, so a sample costs four
+// lookups. the gain is 8^4 = 4096, centered on 2048.
+static uint16_t cic_lut[4][256];
+static uint8_t cic_hist[3];
+
+// half-band, Kaiser beta 6, > 69 dB stopband above 0.448 fs
+static const q15_t hba_coeffs[HBA_TAPS] = {
+    31, 0, -1179, 0, 9340, 16384, 9340, 0,
+    -1179, 0, 31,
+};
+
+// half-band, Kaiser beta 8, > 77 dB stopband above 0.396 fs
+static const q15_t hbb_coeffs[HBB_TAPS] = {
+    3, 0, -97, 0, 596, 0, -2269, 0,
+    9959, 16385, 9959, 0, -2269, 0, 596, 0,
+    -97, 0, 3,
+};
+
+// low-pass, Kaiser beta 8, passband to 0.208 fs within 0.001 dB, > 81 dB
+// stopband above 0.292 fs. what lands between 20 and 24 kHz after
+// decimation may alias, the audible band stays clean.
+static const q31_t final_coeffs[FINAL_TAPS] = {
+    -35889, -84479, 159971, 270787,
+    -426820, -639528, 922019, 1289134,
+    -1757535, -2345815, 3074649, 3966990,
+    -5048388, -6347435, 7896448, 9732475,
+    -11898790, -14447123, 17441001, 20960839,
+    -25111809, -30036368, 35934813, 43100479,
+    -51983182, -63311289, 78346959, 99481617,
+    -131852056, -188834736, 319516384, 965808500,
+    965808500, 319516384, -188834736, -131852056,
+    99481617, 78346959, -63311289, -51983182,
+    43100479, 35934813, -30036368, -25111809,
+    20960839, 17441001, -14447123, -11898790,
+    9732475, 7896448, -6347435, -5048388,
+    3966990, 3074649, -2345815, -1757535,
+    1289134, 922019, -639528, -426820,
+    270787, 159971, -84479, -35889,
+};
+
+static arm_fir_decimate_instance_q15 hba;
+static arm_fir_decimate_instance_q15 hbb;
+static arm_fir_decimate_instance_q31 final;
+static q15_t hba_state[HBA_TAPS + MAX_CIC_FRAMES - 1];
+static q15_t hbb_state[HBB_TAPS + MAX_CIC_FRAMES / 2 - 1];
+static q31_t final_state[FINAL_TAPS + MIC_BLOCK_FRAMES * 2 - 1];
+
+static uint16_t pdm_buf[2 * MAX_PDM_XFERS];
+static q15_t cic_out[MAX_CIC_FRAMES];
+static q15_t hba_out[MAX_CIC_FRAMES / 2];
+static q15_t hbb_out[MIC_BLOCK_FRAMES * 2];
+static q31_t final_in[MIC_BLOCK_FRAMES * 2];
+static q31_t pcm[MIC_BLOCK_FRAMES];
+
+static uint32_t decimation;
+static uint32_t pdm_xfers;
+static uint32_t block_budget;
+// rate to restart at, 0 if none. the filters and block size change under
+// the running pipeline, so this is left to the mic's own DMA interrupt.
+static volatile uint32_t rate_pending = 0;
+
+audio_ring_t mic_ring __attribute__((aligned(4)));
+volatile mic_stats_t mic_stats;
+
+// for debug
+static volatile uint32_t dma_err_cnt = 0;
+
+static void cic_init(void) {
+  uint32_t h[32] = {0};
+
+  // (1 + z^-1 + ... + z^-7)^4 by repeated boxcar convolution
+  h[0] = 1;
+  for (uint8_t order = 0; order < 4; order++) {
+    uint32_t acc[32] = {0};
+    for (uint8_t i = 0; i < 32; i++) {
+      for (uint8_t k = 0; k < CIC_DECIMATION && i + k < 32; k++) {
+        acc[i + k] += h[i];
+      }
+    }
+    for (uint8_t i = 0; i < 32; i++) {
+      h[i] = acc[i];
+    }
+  }
+
+  // byte j covers bits 8j..8j+7 of the window in time order, MSB first
+  for (uint8_t j = 0; j < 4; j++) {
+    for (uint32_t b = 0; b < 256; b++) {
+      uint32_t sum = 0;
+      for (uint8_t i = 0; i < 8; i++) {
+        if (b & (0x80 >> i)) {
+          sum += h[8 * j + i];
+        }
+      }
+      cic_lut[j][b] = sum;
+    }
+  }
+}
+
+// one Q15 sample per PDM byte. I2S shifts in MSB first, so the high byte
+// of each transfer is the older one.
+static void cic_decimate(const uint16_t *pdm, q15_t *dst, uint32_t xfers) {
+  uint32_t b0 = cic_hist[0];
+  uint32_t b1 = cic_hist[1];
+  uint32_t b2 = cic_hist[2];
+
+  for (uint32_t i = 0; i < xfers; i++) {
+    uint32_t hi = pdm[i] >> 8;
+    uint32_t lo = pdm[i] & 0xff;
+    int32_t y0 = cic_lut[0][b0] + cic_lut[1][b1] + cic_lut[2][b2] +
+                 cic_lut[3][hi];
+    int32_t y1 = cic_lut[0][b1] + cic_lut[1][b2] + cic_lut[2][hi] +
+                 cic_lut[3][lo];
+
+    dst[0] = (y0 - 2048) << 3;
+    dst[1] = (y1 - 2048) << 3;
+    dst += 2;
+
+    b0 = b2;
+    b1 = hi;
+    b2 = lo;
+  }
+
+  cic_hist[0] = b0;
+  cic_hist[1] = b1;
+  cic_hist[2] = b2;
+}
+
+// one half-buffer of PDM to MIC_BLOCK_FRAMES PCM samples
+static void mic_process(const uint16_t *pdm) {
+  uint32_t start = DWT->CYCCNT;
+  uint32_t n = pdm_xfers * 2;
+  const q15_t *hb_in = cic_out;
+
+  cic_decimate(pdm, cic_out, pdm_xfers);
+
+  if (decimation == 64) {
+    arm_fir_decimate_q15(&hba, cic_out, hba_out, n);
+    hb_in = hba_out;
+    n /= 2;
+  }
+  arm_fir_decimate_q15(&hbb, hb_in, hbb_out, n);
+  n /= 2;
+
+  // Q15 to Q31 less the headroom the fast FIR needs, restored afterwards
+  // with saturation. the extra bit makes up for the CIC output scaling.
+  for (uint32_t i = 0; i < n; i++) {
+    final_in[i] = (q31_t)hbb_out[i] << (16 - FINAL_HEADROOM);
+  }
+  arm_fir_decimate_fast_q31(&final, final_in, pcm, n);
+  arm_shift_q31(pcm, FINAL_HEADROOM + 1, pcm, MIC_BLOCK_FRAMES);
+  spectrum_feed(SPECTRUM_CAPTURE, pcm, MIC_BLOCK_FRAMES, 1);
+
+  audio_ring_span_t span;
+  if (audio_ring_reserve(&mic_ring, MIC_BLOCK_FRAMES, &span)) {
+    const q31_t *src = pcm;
+    for (uint8_t s = 0; s < 2; s++) {
+      for (uint32_t i = 0; i < span.len[s]; i++) {
+        span.ptr[s][i] = *src++;
+      }
+    }
+    audio_ring_commit(&mic_ring, MIC_BLOCK_FRAMES);
+  }
+
+  uint32_t cycles = DWT->CYCCNT - start;
+  mic_stats.block_cnt++;
+  mic_stats.cycles_last = cycles;
+  if (cycles > mic_stats.cycles_max) {
+    mic_stats.cycles_max = cycles;
+  }
+  if (cycles > block_budget) {
+    mic_stats.over_budget_cnt++;
+  }
+  PROF_RECORD(PROF_MIC, cycles);
+}
+
+void mic_init(void) {
+  RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+  RCC->APB1ENR |= RCC_APB1ENR_SPI2EN;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  cic_init();
+
+  // below the playback stream and USB, a late block only delays capture
+  NVIC_SetPriority(DMA1_Stream3_IRQn, 2);
+  NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+
+  mic_set_rate(playback_rate());
+}
+
+// the PDM bit clock is I2SCLK / (2 * I2SDIV) with a 16-bit frame and no
+// MCLK, i.e. rate * decimation
+static void pdm_start(uint32_t rate) {
+  SPI2->I2SCFGR &= ~SPI_I2SCFGR_I2SE;
+  DMA1_Stream3->CR = 0;
+  while (DMA1_Stream3->CR & DMA_SxCR_EN_Msk)
+    ;
+
+  decimation = MIC_DECIMATION(rate);
+  pdm_xfers = MIC_BLOCK_FRAMES * decimation / 16;
+  block_budget =
+      (uint64_t)MIC_CYCLES_PER_MS * MIC_BLOCK_FRAMES * 1000 / rate;
+  // alternating bits are what the modulator sends for silence
+  cic_hist[0] = cic_hist[1] = cic_hist[2] = 0x55;
+
+  arm_fir_decimate_init_q15(&hba, HBA_TAPS, 2, hba_coeffs, hba_state,
+                            pdm_xfers * 2);
+  arm_fir_decimate_init_q15(&hbb, HBB_TAPS, 2, hbb_coeffs, hbb_state,
+                            MIC_BLOCK_FRAMES * 4);
+  arm_fir_decimate_init_q31(&final, FINAL_TAPS, 2, final_coeffs, final_state,
+                            MIC_BLOCK_FRAMES * 2);
+
+  // master receive, LSB justified, 16-bit frame, clock idles high
+  SPI2->I2SCFGR = SPI_I2SCFGR_I2SMOD | SPI_I2SCFGR_I2SCFG |
+                  SPI_I2SCFGR_I2SSTD_1 | SPI_I2SCFGR_CKPOL;
+  SPI2->I2SPR = (playback_i2s_prescaler() * 256 / decimation / 2)
+                << SPI_I2SPR_I2SDIV_Pos;
+  SPI2->CR2 = SPI_CR2_RXDMAEN;
+
+  // DMA1 stream 3 channel 0 = SPI2_RX
+  DMA1->LIFCR = DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 |
+                DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3;
+  DMA1_Stream3->PAR = (uint32_t)&SPI2->DR;
+  DMA1_Stream3->M0AR = (uint32_t)pdm_buf;
+  DMA1_Stream3->NDTR = 2 * pdm_xfers;
+  DMA1_Stream3->CR = (0 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL_1 |
+                     DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC |
+                     DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE |
+                     DMA_SxCR_TEIE;
+
+  DMA1_Stream3->CR |= DMA_SxCR_EN;
+  SPI2->I2SCFGR |= SPI_I2SCFGR_I2SE;
+}
+
+// I2S2 runs from the same PLLI2S as the playback clock, so it has to be
+// restarted whenever that changes. the restart waits for the next block
+// boundary, or happens right here if the stream is not running.
+void mic_set_rate(uint32_t rate) {
+  rate_pending = rate;
+  if (!(DMA1_Stream3->CR & DMA_SxCR_EN_Msk)) {
+    rate_pending = 0;
+    pdm_start(rate);
+  }
+}
+
+void DMA1_Stream3_IRQHandler(void) {
+  uint32_t lisr = DMA1->LISR;
+
+  // the restart clears the flags, they belong to the old buffer
+  if (rate_pending != 0) {
+    uint32_t rate = rate_pending;
+    rate_pending = 0;
+    pdm_start(rate);
+    return;
+  }
+
+  if (lisr & DMA_LISR_HTIF3_Msk) {
+    DMA1->LIFCR = DMA_LIFCR_CHTIF3;
+    mic_process(&pdm_buf[0]);
+  }
+
+  if (lisr & DMA_LISR_TCIF3_Msk) {
+    DMA1->LIFCR = DMA_LIFCR_CTCIF3;
+    mic_process(&pdm_buf[pdm_xfers]);
+  }
+
+  if (lisr & DMA_LISR_TEIF3_Msk) {
+    DMA1->LIFCR = DMA_LIFCR_CTEIF3;
+    dma_err_cnt++;
+  }
+}
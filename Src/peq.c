@@ -0,0 +1,230 @@
+#include "peq.h"
+#include <arm_math.h>
+#include <math.h>
+#include <stm32f411xe.h>
+
+// coefficients per biquad, b0 b1 b2 -a1 -a2 normalized to a0 = 1
+#define PEQ_COEFFS 5
+// highest usable band frequency relative to the rate
+#define PEQ_MAX_FREQ 0.45f
+
+// double-buffered coefficient sets. the USB side writes the set the audio
+// side is not using and marks it pending, the audio side switches over at
+// the start of a block. bands keep their stage, so the filter state stays
+// valid across a switch and a band in between the enabled ones passes
+// through unchanged.
+typedef struct {
+  float32_t coeffs[PEQ_MAX_BANDS * PEQ_COEFFS];
+  uint8_t stages;
+  uint8_t clear; // a rate change, the old state means nothing now
+} peq_set_t;
+
+static peq_band_t bands[PEQ_MAX_BANDS];
+static float32_t coeffs[PEQ_MAX_BANDS * PEQ_COEFFS];
+static uint32_t rate;
+// a rate change, the audio side redesigns at the start of a block
+static uint32_t next_rate;
+static volatile uint8_t rate_pending = 0;
+
+static peq_set_t sets[2];
+static volatile uint8_t active = 0;
+static volatile uint8_t pending = 0;
+
+static arm_biquad_cascade_stereo_df2T_instance_f32 cascade;
+static float32_t state[4 * PEQ_MAX_BANDS];
+// stages of the active set, and how many of them run when the CPU is short
+static uint8_t set_stages = 0;
+static uint8_t limit = PEQ_MAX_BANDS;
+
+// for debug
+static volatile uint32_t swap_cnt = 0;
+
+// RBJ audio EQ cookbook
+static void peq_design(const peq_band_t *band, float32_t *c) {
+  float32_t f = band->freq;
+  float32_t q = band->q / 256.0f;
+
+  if (band->type == PEQ_OFF || f <= 0.0f || f > PEQ_MAX_FREQ * rate ||
+      q <= 0.0f) {
+    c[0] = 1.0f;
+    c[1] = c[2] = c[3] = c[4] = 0.0f;
+    return;
+  }
+
+  float32_t w0 = 2.0f * PI * f / rate;
+  float32_t cw = cosf(w0);
+  float32_t alpha = sinf(w0) / (2.0f * q);
+  float32_t a = powf(10.0f, band->gain / (256.0f * 40.0f));
+  float32_t sa = 2.0f * sqrtf(a) * alpha;
+  float32_t b0, b1, b2, a0, a1, a2;
+
+  switch (band->type) {
+  case PEQ_PEAK:
+    b0 = 1.0f + alpha * a;
+    b1 = -2.0f * cw;
+    b2 = 1.0f - alpha * a;
+    a0 = 1.0f + alpha / a;
+    a1 = -2.0f * cw;
+    a2 = 1.0f - alpha / a;
+    break;
+  case PEQ_LOW_SHELF:
+    b0 = a * ((a + 1.0f) - (a - 1.0f) * cw + sa);
+    b1 = 2.0f * a * ((a - 1.0f) - (a + 1.0f) * cw);
+    b2 = a * ((a + 1.0f) - (a - 1.0f) * cw - sa);
+    a0 = (a + 1.0f) + (a - 1.0f) * cw + sa;
+    a1 = -2.0f * ((a - 1.0f) + (a + 1.0f) * cw);
+    a2 = (a + 1.0f) + (a - 1.0f) * cw - sa;
+    break;
+  case PEQ_HIGH_SHELF:
+    b0 = a * ((a + 1.0f) + (a - 1.0f) * cw + sa);
+    b1 = -2.0f * a * ((a - 1.0f) + (a + 1.0f) * cw);
+    b2 = a * ((a + 1.0f) + (a - 1.0f) * cw - sa);
+    a0 = (a + 1.0f) - (a - 1.0f) * cw + sa;
+    a1 = 2.0f * ((a - 1.0f) - (a + 1.0f) * cw);
+    a2 = (a + 1.0f) - (a - 1.0f) * cw - sa;
+    break;
+  case PEQ_LOW_PASS:
+    b0 = b2 = (1.0f - cw) / 2.0f;
+    b1 = 1.0f - cw;
+    a0 = 1.0f + alpha;
+    a1 = -2.0f * cw;
+    a2 = 1.0f - alpha;
+    break;
+  case PEQ_HIGH_PASS:
+    b0 = b2 = (1.0f + cw) / 2.0f;
+    b1 = -(1.0f + cw);
+    a0 = 1.0f + alpha;
+    a1 = -2.0f * cw;
+    a2 = 1.0f - alpha;
+    break;
+  default: // PEQ_NOTCH
+    b0 = b2 = 1.0f;
+    b1 = -2.0f * cw;
+    a0 = 1.0f + alpha;
+    a1 = -2.0f * cw;
+    a2 = 1.0f - alpha;
+    break;
+  }
+
+  c[0] = b0 / a0;
+  c[1] = b1 / a0;
+  c[2] = b2 / a0;
+  c[3] = -a1 / a0;
+  c[4] = -a2 / a0;
+}
+
+// hand the current coefficients to the audio side. runs from the USB
+// interrupt, which the audio DMA interrupt cannot preempt, or from the
+// audio side with interrupts masked, so the set not in use is never read
+// while it is written.
+static void peq_publish(uint8_t clear) {
+  peq_set_t *set = &sets[active ^ 1];
+  uint8_t stages = 0;
+
+  for (uint8_t i = 0; i < PEQ_MAX_BANDS; i++) {
+    if (bands[i].type != PEQ_OFF) {
+      stages = i + 1;
+    }
+  }
+  for (uint32_t i = 0; i < PEQ_MAX_BANDS * PEQ_COEFFS; i++) {
+    set->coeffs[i] = coeffs[i];
+  }
+  set->stages = stages;
+  // a clear still pending from an earlier set must not get lost
+  set->clear = clear || (pending && set->clear);
+  pending = 1;
+}
+
+// when the rate changes, every band is redesigned with the next block
+void peq_set_rate(uint32_t new_rate) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  next_rate = new_rate;
+  rate_pending = 1;
+  __set_PRIMASK(primask);
+}
+
+// returns 0 for a band out of range, nothing is changed then. all bands
+// of one call take effect in the same block.
+int peq_set_bands(uint8_t first, uint8_t count, const peq_band_t *src) {
+  if (first >= PEQ_MAX_BANDS || count > PEQ_MAX_BANDS - first) {
+    return 0;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    bands[first + i] = src[i];
+    peq_design(&src[i], &coeffs[(first + i) * PEQ_COEFFS]);
+  }
+  peq_publish(0);
+  return 1;
+}
+
+void peq_get_bands(uint8_t first, uint8_t count, peq_band_t *dst) {
+  for (uint8_t i = 0; i < count && first + i < PEQ_MAX_BANDS; i++) {
+    dst[i] = bands[first + i];
+  }
+}
+
+// run the first bands within the limit. stages enabled since the last call
+// start from rest.
+static void peq_run(void) {
+  uint8_t n = set_stages < limit ? set_stages : limit;
+
+  for (uint32_t i = 4 * cascade.numStages; i < 4 * n; i++) {
+    state[i] = 0.0f;
+  }
+  cascade.numStages = n;
+}
+
+// take over a pending rate and coefficient set, from the audio DMA
+// interrupt at the start of a block. the redesign masks interrupts, as the
+// USB side designs into the same coefficients.
+void peq_sync(void) {
+  if (rate_pending) {
+    __disable_irq();
+    rate = next_rate;
+    rate_pending = 0;
+    for (uint8_t i = 0; i < PEQ_MAX_BANDS; i++) {
+      peq_design(&bands[i], &coeffs[i * PEQ_COEFFS]);
+    }
+    peq_publish(1);
+    __enable_irq();
+  }
+
+  if (pending) {
+    __disable_irq();
+    active ^= 1;
+    pending = 0;
+    __enable_irq();
+
+    peq_set_t *set = &sets[active];
+    if (set->clear) {
+      for (uint32_t i = 0; i < 4 * PEQ_MAX_BANDS; i++) {
+        state[i] = 0.0f;
+      }
+    }
+    cascade.pCoeffs = set->coeffs;
+    cascade.pState = state;
+    set_stages = set->stages;
+    peq_run();
+    swap_cnt++;
+  }
+}
+
+// run only the first bands, from the audio side. bands dropped or brought
+// back switch in abruptly.
+void peq_set_limit(uint8_t count) {
+  limit = count;
+  peq_run();
+}
+
+uint8_t peq_active(void) { return cascade.numStages != 0; }
+
+// filter interleaved stereo frames in place
+void peq_process(float32_t *buf, uint32_t frames) {
+  if (cascade.numStages == 0 || frames == 0) {
+    return;
+  }
+
+  arm_biquad_cascade_stereo_df2T_f32(&cascade, buf, buf, frames);
+}
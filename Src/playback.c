@@ -0,0 +1,422 @@
+#include "playback.h"
+#include "asrc.h"
+#include "audio_ring.h"
+#include "clock.h"
+#include "conceal.h"
+#include "conv.h"
+#include "deadline.h"
+#include "dyn.h"
+#include "feedback.h"
+#include "graph.h"
+#include "mic.h"
+#include "peq.h"
+#include "prof.h"
+#include "spectrum.h"
+#include <stddef.h>
+#include <stm32f411xe.h>
+
+#if PLAYBACK_BUFFER_MS < 1 || PLAYBACK_BUFFER_MS > 10
+#error "PLAYBACK_BUFFER_MS must be between 1 and 10"
+#endif
+
+// start consuming once the ring is half full so the fill level begins
+// centered, and fall back to this state after every underrun
+#define PLAYBACK_START_FILL (AUDIO_RING_WORDS / 2)
+
+typedef struct {
+  uint32_t rate;
+  uint8_t pllm;
+  uint16_t plln;
+  uint8_t pllr;
+  uint8_t i2sdiv;
+  uint8_t odd;
+} i2s_clock_t;
+
+// PLLI2S and I2S prescaler per rate, MCLK = 256 fs. fs = 8 MHz / M * N / R
+// / (256 * (2 * I2SDIV + ODD)). within the 100-432 MHz VCO range only 48
+// kHz is exact from the 8 MHz HSE, the others are the closest settings
+// found. the feedback endpoint reports the real rate, so the host follows
+// the small offset and nothing is lost.
+static const i2s_clock_t i2s_clocks[] = {
+    {44100, 7, 326, 3, 5, 1}, // 44101.7 Hz, +39 ppm
+    {48000, 5, 192, 5, 2, 1}, // exact
+    {88200, 5, 254, 3, 3, 0}, // 88194.4 Hz, -63 ppm
+    {96000, 7, 172, 2, 2, 0}, // 95982.1 Hz, -186 ppm
+};
+
+#define NUM_RATES (sizeof(i2s_clocks) / sizeof(i2s_clocks[0]))
+
+// two words per frame, left first, each a Q31 sample with its halves
+// swapped as the DMA feeds the I2S data register MSB half first. sized for
+// the highest rate, only the first 2 * half_frames frames are used.
+#define DMA_FRAME_WORDS AUDIO_RING_FRAME_WORDS
+// halfword transfers per frame
+#define DMA_FRAME_XFERS (2 * DMA_FRAME_WORDS)
+
+static uint32_t dma_buf[2 * PLAYBACK_MAX_HALF_FRAMES * DMA_FRAME_WORDS];
+static uint32_t half_frames;
+static uint32_t rate;
+static uint8_t prescaler;
+static volatile uint8_t playing = 0;
+// set by a rate change, the consumer drops what was queued at the old rate
+static volatile uint8_t flush_pending = 0;
+// clock setting of a requested rate change. restarting the I2S and its
+// PLL waits for lock, so it is done by the DMA interrupt, not the caller.
+static const i2s_clock_t *volatile clock_pending = NULL;
+// the DMA interrupt is restarting the output, a new setting waits for it
+static volatile uint8_t restarting = 0;
+// resampler requested from outside and in use by the consumer. the switch
+// happens at the next refill.
+static volatile uint8_t asrc_enable = 0;
+static uint8_t asrc_active = 0;
+// fading out after a ring overflow, the queue is dropped once silent
+static uint8_t overflow = 0;
+static uint32_t last_overruns = 0;
+
+#if PLAYBACK_SOFT_VOLUME
+static audio_gain_t gain = {AUDIO_GAIN_UNITY, AUDIO_GAIN_UNITY};
+static int16_t volume[2];
+static uint8_t mute[2];
+#endif
+
+// for debug
+static volatile uint32_t half_cnt = 0;
+static volatile uint32_t full_cnt = 0;
+static volatile uint32_t dma_err_cnt = 0;
+
+// (re)start I2S3 and its DMA at the given clock setting
+static void playback_start(const i2s_clock_t *clk) {
+  SPI3->I2SCFGR &= ~SPI_I2SCFGR_I2SE;
+  DMA1_Stream5->CR = 0;
+  while (DMA1_Stream5->CR & DMA_SxCR_EN_Msk)
+    ;
+
+  rate = clk->rate;
+  prescaler = 2 * clk->i2sdiv + clk->odd;
+  half_frames = clk->rate / 1000 * PLAYBACK_BUFFER_MS;
+  full_cnt = 0;
+  conceal_set_rate(rate);
+  for (uint32_t i = 0; i < 2 * half_frames * DMA_FRAME_WORDS; i++) {
+    dma_buf[i] = 0;
+  }
+
+  clock_plli2s_init(clk->pllm, clk->plln, clk->pllr);
+
+  // I2S3 master transmit, Philips standard, 24-bit data in 32-bit frame
+  SPI3->I2SCFGR = SPI_I2SCFGR_I2SMOD | SPI_I2SCFGR_I2SCFG_1 |
+                  SPI_I2SCFGR_DATLEN_0 | SPI_I2SCFGR_CHLEN;
+  SPI3->I2SPR = SPI_I2SPR_MCKOE | (clk->odd ? SPI_I2SPR_ODD : 0) |
+                (clk->i2sdiv << SPI_I2SPR_I2SDIV_Pos);
+  SPI3->CR2 = SPI_CR2_TXDMAEN;
+
+  // DMA1 stream 5 channel 0 = SPI3_TX
+  DMA1->HIFCR = DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5 |
+                DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5;
+  DMA1_Stream5->PAR = (uint32_t)&SPI3->DR;
+  DMA1_Stream5->M0AR = (uint32_t)dma_buf;
+  DMA1_Stream5->NDTR = 2 * half_frames * DMA_FRAME_XFERS;
+  DMA1_Stream5->CR = (0 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL |
+                     DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC |
+                     DMA_SxCR_CIRC | DMA_SxCR_DIR_0 | DMA_SxCR_HTIE |
+                     DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+
+  DMA1_Stream5->CR |= DMA_SxCR_EN;
+  SPI3->I2SCFGR |= SPI_I2SCFGR_I2SE;
+}
+
+void playback_init(void) {
+  RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+  RCC->APB1ENR |= RCC_APB1ENR_SPI3EN;
+
+  NVIC_SetPriority(DMA1_Stream5_IRQn, 1);
+  NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+
+  conv_init();
+  dyn_init();
+  graph_init();
+  deadline_init();
+  playback_set_rate(PLAYBACK_DEFAULT_RATE);
+}
+
+// the pending clock setting, or NULL. a USB request may set another one
+// at any time, so it is taken and cleared in one go.
+static const i2s_clock_t *playback_take_clock(void) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const i2s_clock_t *clk = clock_pending;
+  clock_pending = NULL;
+  __set_PRIMASK(primask);
+  return clk;
+}
+
+// restart the output at the given clock setting. whatever was queued at
+// the old rate is dropped, and the feedback gets another chance.
+static void playback_apply_rate(const i2s_clock_t *clk) {
+  playing = 0;
+  asrc_enable = 0;
+  flush_pending = 1;
+  playback_start(clk);
+  peq_set_rate(clk->rate);
+  dyn_set_rate(clk->rate);
+  spectrum_set_rate(clk->rate);
+  graph_set_rate(clk->rate);
+}
+
+// returns 0 for a rate without clock setting. playback_rate() reports the
+// new rate at once, the output switches over at the next DMA interrupt,
+// or right here if the stream is not running.
+int playback_set_rate(uint32_t new_rate) {
+  for (uint8_t i = 0; i < NUM_RATES; i++) {
+    if (i2s_clocks[i].rate == new_rate) {
+      rate = new_rate;
+      clock_pending = &i2s_clocks[i];
+      if (!(DMA1_Stream5->CR & DMA_SxCR_EN_Msk) && !restarting) {
+        playback_apply_rate(playback_take_clock());
+      }
+      return 1;
+    }
+  }
+  return 0;
+}
+
+uint32_t playback_rate(void) { return rate; }
+
+// I2SCLK / MCLK at the current rate, i.e. 2 * I2SDIV + ODD. I2SCLK itself
+// is 256 * rate times this.
+uint32_t playback_i2s_prescaler(void) { return prescaler; }
+
+// supported rates in ascending order, 0 past the last one
+uint32_t playback_rate_at(uint8_t index) {
+  return index < NUM_RATES ? i2s_clocks[index].rate : 0;
+}
+
+// consume the ring through the resampler, paced by its fill level instead
+// of relying on the host to follow the feedback endpoint. selected by the
+// host or by the feedback once ignored, until the next stream or rate.
+void playback_set_asrc(uint8_t enable) { asrc_enable = enable ? 1 : 0; }
+
+uint8_t playback_asrc(void) { return asrc_enable; }
+
+// consuming the ring, i.e. started and not in underrun
+uint8_t playback_playing(void) { return playing; }
+
+#if PLAYBACK_SOFT_VOLUME
+// a muted channel ramps down to zero like any other gain change
+static void gain_update(void) {
+  uint32_t left = mute[0] ? 0 : audio_gain_q15(volume[0]);
+  uint32_t right = mute[1] ? 0 : audio_gain_q15(volume[1]);
+
+  gain.target = left | (right << 16);
+}
+#endif
+
+// volume in 1/256 dB per channel, clamped to the supported range
+void playback_set_volume(int16_t left, int16_t right) {
+#if PLAYBACK_SOFT_VOLUME
+  volume[0] = left;
+  volume[1] = right;
+  gain_update();
+#else
+  codec_set_volume(left, right);
+#endif
+}
+
+void playback_set_mute(uint8_t left, uint8_t right) {
+#if PLAYBACK_SOFT_VOLUME
+  mute[0] = left;
+  mute[1] = right;
+  gain_update();
+#else
+  codec_set_mute(left, right);
+#endif
+}
+
+// frames from the ring, through the resampler when it is on. returns the
+// number of words written.
+static uint32_t playback_read(uint32_t *dst, uint32_t frames) {
+  if (asrc_active) {
+    return asrc_process(dst, frames) * DMA_FRAME_WORDS;
+  }
+  return audio_ring_read(&audio_ring, dst, frames * DMA_FRAME_WORDS);
+}
+
+// the processing graph, by default equalizer, room correction and dynamics
+static void playback_process(uint32_t *buf, uint32_t frames) {
+  if (frames == 0 || !graph_active()) {
+    return;
+  }
+
+  graph_process((int32_t *)buf, frames);
+}
+
+// frames the DMA still plays before it reaches dst, more than half_frames
+// once it is already inside the half starting there
+static uint32_t playback_lead(const uint32_t *dst) {
+  uint32_t frames = 2 * half_frames;
+  uint32_t total = frames * DMA_FRAME_XFERS;
+  uint32_t pos = (total - DMA1_Stream5->NDTR) / DMA_FRAME_XFERS;
+  uint32_t start = (dst - dma_buf) / DMA_FRAME_WORDS;
+
+  return (start + frames - pos) % frames;
+}
+
+// fill one half-buffer from the ring, straight or resampled. this is the
+// only place samples are touched on their way out. nothing stops or starts
+// abruptly: the output fades out while the ring still has data to fade,
+// ahead of starvation, and fades back in once it is refilled.
+void playback_refill(uint32_t *dst, uint32_t frames) {
+  PROF_BEGIN(start);
+  uint32_t n = 0;
+
+  conv_sync();
+  peq_sync();
+  dyn_sync();
+  graph_sync();
+
+  if (flush_pending) {
+    flush_pending = 0;
+    overflow = 0;
+    audio_ring_flush(&audio_ring);
+    asrc_reset();
+  }
+
+  // a packet refused on overflow leaves a splice in the queue. fade out and
+  // drop the queue rather than play across it.
+  uint32_t overruns = audio_ring.overrun_cnt;
+  if (overruns != last_overruns) {
+    last_overruns = overruns;
+    if (playing && !overflow) {
+      overflow = 1;
+      conceal_stats.overrun_cnt++;
+      conceal_stats.overrun_pos = playback_position();
+    }
+  }
+
+  // the resampler starts from an empty history, switch while silent
+  if (asrc_active != asrc_enable && conceal_gain() == 0) {
+    asrc_active = asrc_enable;
+    asrc_reset();
+  }
+
+  uint32_t avail = audio_ring_fill(&audio_ring) / DMA_FRAME_WORDS;
+  if (!playing && avail >= PLAYBACK_START_FILL / DMA_FRAME_WORDS) {
+    playing = 1;
+    conceal_stats.resume_cnt++;
+    conceal_stats.resume_pos = playback_position();
+  }
+
+  if (playing) {
+    // the resampler may take two frames more than it puts out
+    uint8_t low = avail < frames + conceal_fade_frames() + 2;
+    uint8_t down = low || overflow || asrc_active != asrc_enable;
+    uint32_t want = frames;
+    if (down && conceal_gain() < frames) {
+      want = conceal_gain();
+    }
+
+    // the fade goes ahead of the processing, so that what the graph holds
+    // back, the limiter's look-ahead or a partition of convolution, is the
+    // faded signal and drains as such once the queue is dropped
+    n = playback_read(dst, want);
+    conceal_ramp(dst, n / DMA_FRAME_WORDS, down);
+    if (n < want * DMA_FRAME_WORDS) {
+      conceal_silence();
+      conceal_stats.cut_cnt++;
+      conceal_stats.cut_pos = playback_position();
+    }
+
+    // silent now. an overflow restarts from an empty queue, a pending
+    // resampler switch fades straight back in with the next refill.
+    if (down && conceal_gain() == 0) {
+      if (overflow) {
+        overflow = 0;
+        playing = 0;
+        audio_ring_flush(&audio_ring);
+      } else if (low) {
+        playing = 0;
+        conceal_stats.underrun_cnt++;
+        conceal_stats.underrun_pos = playback_position();
+      }
+    }
+  }
+
+  for (uint32_t i = n; i < frames * DMA_FRAME_WORDS; i++) {
+    dst[i] = 0;
+  }
+  // whole blocks, silence included, for the same reason
+  playback_process(dst, frames);
+#if PLAYBACK_SOFT_VOLUME
+  audio_gain_apply(&gain, dst, frames);
+#endif
+  spectrum_feed(SPECTRUM_PLAYBACK, (const int32_t *)dst, frames, 2);
+  for (uint32_t i = 0; i < frames * DMA_FRAME_WORDS; i++) {
+    dst[i] = __ROR(dst[i], 16);
+  }
+  PROF_END(PROF_PLAYBACK, start);
+  deadline_check(playback_lead(dst), frames);
+}
+
+// frames consumed by the DMA since start. must be called at the same
+// priority as the DMA interrupt so full_cnt cannot change underneath.
+uint32_t playback_position(void) {
+  uint32_t wraps = full_cnt;
+  uint32_t ndtr = DMA1_Stream5->NDTR;
+  uint32_t total = 2 * half_frames * DMA_FRAME_XFERS;
+
+  // wrapped but transfer-complete not serviced yet
+  if ((DMA1->HISR & DMA_HISR_TCIF5_Msk) && ndtr > total / 2) {
+    wraps++;
+  }
+
+  return wraps * 2 * half_frames + (total - ndtr) / DMA_FRAME_XFERS;
+}
+
+// frames in the DMA buffer not played yet, between one and two half-buffers
+// as the refill keeps ahead. the ring fill alone steps by a half-buffer at
+// every refill, this added to it does not. same priority as the DMA
+// interrupt, as for playback_position().
+uint32_t playback_queued(void) {
+  uint32_t total = 2 * half_frames * DMA_FRAME_XFERS;
+  uint32_t pos = (total - DMA1_Stream5->NDTR) / DMA_FRAME_XFERS;
+  uint32_t queued = 2 * half_frames - pos % half_frames;
+
+  // a half played out but not refilled yet
+  if (DMA1->HISR & (DMA_HISR_HTIF5_Msk | DMA_HISR_TCIF5_Msk)) {
+    queued -= half_frames;
+  }
+  return queued;
+}
+
+void DMA1_Stream5_IRQHandler(void) {
+  uint32_t hisr = DMA1->HISR;
+
+  // the restart clears the flags, they belong to the old buffer. the mic
+  // shares PLLI2S and the feedback measures it, both follow the new clock.
+  // a request landing meanwhile stays pending for the next interrupt.
+  const i2s_clock_t *clk = playback_take_clock();
+  if (clk != NULL) {
+    restarting = 1;
+    playback_apply_rate(clk);
+    restarting = 0;
+    mic_set_rate(clk->rate);
+    feedback_set_rate(clk->rate);
+    return;
+  }
+
+  if (hisr & DMA_HISR_HTIF5_Msk) {
+    DMA1->HIFCR = DMA_HIFCR_CHTIF5;
+    half_cnt++;
+    playback_refill(&dma_buf[0], half_frames);
+  }
+
+  if (hisr & DMA_HISR_TCIF5_Msk) {
+    DMA1->HIFCR = DMA_HIFCR_CTCIF5;
+    full_cnt++;
+    playback_refill(&dma_buf[half_frames * DMA_FRAME_WORDS], half_frames);
+  }
+
+  if (hisr & DMA_HISR_TEIF5_Msk) {
+    DMA1->HIFCR = DMA_HIFCR_CTEIF5;
+    dma_err_cnt++;
+  }
+}
@@ -0,0 +1,95 @@
+#include "prof.h"
+#include <stddef.h>
+
+volatile prof_stats_t prof_stats[PROF_NUM_PROBES];
+
+// for the debugger
+const char *const prof_names[PROF_NUM_PROBES] = {
+    [PROF_USB] = "usb",
+    [PROF_TIM1] = "tim1",
+    [PROF_FEEDBACK] = "feedback",
+    [PROF_PLAYBACK] = "playback",
+    [PROF_MIC] = "mic",
+    [PROF_SPECTRUM] = "spectrum",
+    [PROF_GRAPH_GAIN] = "graph gain",
+    [PROF_GRAPH_PEQ] = "graph peq",
+    [PROF_GRAPH_CONV] = "graph conv",
+    [PROF_GRAPH_DYN] = "graph dyn",
+    [PROF_GRAPH_METER] = "graph meter",
+    [PROF_GRAPH_MIX] = "graph mix",
+};
+
+// a reset from USB is left to the next record of the probe, every probe
+// is only written from its own interrupt
+static volatile uint8_t reset_pending[PROF_NUM_PROBES];
+
+static void prof_clear(volatile prof_stats_t *s) {
+  s->count = 0;
+  s->min = UINT32_MAX;
+  s->max = 0;
+  s->last = 0;
+  s->total = 0;
+  for (uint8_t i = 0; i < PROF_BUCKETS; i++) {
+    s->hist[i] = 0;
+  }
+}
+
+void prof_init(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  for (uint8_t i = 0; i < PROF_NUM_PROBES; i++) {
+    prof_clear(&prof_stats[i]);
+  }
+}
+
+void prof_record(uint8_t probe, uint32_t cycles) {
+  volatile prof_stats_t *s = &prof_stats[probe];
+  uint32_t bucket = cycles >> PROF_BUCKET_SHIFT;
+
+  if (reset_pending[probe]) {
+    reset_pending[probe] = 0;
+    prof_clear(s);
+  }
+
+  if (bucket != 0) {
+    bucket = 32 - __CLZ(bucket);
+    if (bucket >= PROF_BUCKETS) {
+      bucket = PROF_BUCKETS - 1;
+    }
+  }
+
+  s->count++;
+  s->last = cycles;
+  s->total += cycles;
+  if (cycles < s->min) {
+    s->min = cycles;
+  }
+  if (cycles > s->max) {
+    s->max = cycles;
+  }
+  s->hist[bucket]++;
+}
+
+// copy of one probe, from USB. nothing preempts USB, so the copy is
+// consistent. returns 0 for an unknown probe.
+int prof_read(uint8_t probe, prof_stats_t *stats, uint8_t reset) {
+  if (probe >= PROF_NUM_PROBES) {
+    return 0;
+  }
+
+  volatile prof_stats_t *s = &prof_stats[probe];
+  stats->count = s->count;
+  stats->min = s->min;
+  stats->max = s->max;
+  stats->last = s->last;
+  stats->total = s->total;
+  for (uint8_t i = 0; i < PROF_BUCKETS; i++) {
+    stats->hist[i] = s->hist[i];
+  }
+  if (reset) {
+    reset_pending[probe] = 1;
+  }
+  return 1;
+}
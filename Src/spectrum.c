@@ -0,0 +1,457 @@
+#include "spectrum.h"
+#include "playback.h"
+#include "prof.h"
+#include "usb.h"
+#include <arm_math.h>
+#include <math.h>
+#include <stm32f411xe.h>
+
+#if SPECTRUM_MAX_SIZE & (SPECTRUM_MAX_SIZE - 1)
+#error "SPECTRUM_MAX_SIZE must be a power of two"
+#endif
+
+// SPI4 is not used, its interrupt line runs the analysis in the background
+// below every audio and USB interrupt
+#define SPECTRUM_IRQn SPI4_IRQn
+#define SPECTRUM_IRQHandler SPI4_IRQHandler
+#define SPECTRUM_PRIORITY 15
+
+// input history, the longest frame and what the audio interrupts may add
+// while it is being copied out
+#define TAP_LEN (SPECTRUM_MAX_SIZE + PLAYBACK_MAX_HALF_FRAMES)
+
+// center of band 0, 1 kHz * 2^(-17/3), and the half-band factor 2^(1/6)
+#define BAND_FIRST_FC 19.686266f
+#define BAND_STEP 1.2599210f
+#define BAND_HALF 1.1224620f
+
+// lowest level reported, 1/256 dB
+#define LEVEL_FLOOR INT16_MIN
+
+// first half of a periodic Hann window of SPECTRUM_MAX_SIZE points, shorter
+// frames take every n-th value
+static const float32_t hann[SPECTRUM_MAX_SIZE / 2 + 1] = {
+    0.00000000f, 0.00000235f, 0.00000941f, 0.00002118f, 0.00003765f,
+    0.00005883f, 0.00008471f, 0.00011530f, 0.00015059f, 0.00019059f,
+    0.00023529f, 0.00028470f, 0.00033881f, 0.00039762f, 0.00046114f,
+    0.00052935f, 0.00060227f, 0.00067989f, 0.00076221f, 0.00084923f,
+    0.00094094f, 0.00103736f, 0.00113847f, 0.00124427f, 0.00135477f,
+    0.00146996f, 0.00158985f, 0.00171443f, 0.00184369f, 0.00197765f,
+    0.00211629f, 0.00225962f, 0.00240764f, 0.00256033f, 0.00271771f,
+    0.00287978f, 0.00304651f, 0.00321793f, 0.00339403f, 0.00357479f,
+    0.00376023f, 0.00395034f, 0.00414512f, 0.00434457f, 0.00454868f,
+    0.00475746f, 0.00497089f, 0.00518899f, 0.00541175f, 0.00563915f,
+    0.00587122f, 0.00610793f, 0.00634929f, 0.00659530f, 0.00684595f,
+    0.00710125f, 0.00736118f, 0.00762575f, 0.00789495f, 0.00816879f,
+    0.00844726f, 0.00873035f, 0.00901807f, 0.00931040f, 0.00960736f,
+    0.00990893f, 0.01021512f, 0.01052591f, 0.01084131f, 0.01116132f,
+    0.01148593f, 0.01181513f, 0.01214893f, 0.01248733f, 0.01283031f,
+    0.01317788f, 0.01353002f, 0.01388675f, 0.01424805f, 0.01461393f,
+    0.01498437f, 0.01535938f, 0.01573895f, 0.01612308f, 0.01651176f,
+    0.01690500f, 0.01730278f, 0.01770510f, 0.01811197f, 0.01852337f,
+    0.01893930f, 0.01935976f, 0.01978474f, 0.02021424f, 0.02064826f,
+    0.02108679f, 0.02152983f, 0.02197737f, 0.02242942f, 0.02288595f,
+    0.02334698f, 0.02381249f, 0.02428249f, 0.02475696f, 0.02523591f,
+    0.02571933f, 0.02620720f, 0.02669954f, 0.02719634f, 0.02769758f,
+    0.02820327f, 0.02871340f, 0.02922797f, 0.02974696f, 0.03027039f,
+    0.03079823f, 0.03133049f, 0.03186717f, 0.03240825f, 0.03295372f,
+    0.03350360f, 0.03405787f, 0.03461652f, 0.03517955f, 0.03574696f,
+    0.03631874f, 0.03689488f, 0.03747538f, 0.03806023f, 0.03864944f,
+    0.03924298f, 0.03984086f, 0.04044307f, 0.04104961f, 0.04166047f,
+    0.04227564f, 0.04289512f, 0.04351890f, 0.04414698f, 0.04477935f,
+    0.04541601f, 0.04605694f, 0.04670215f, 0.04735162f, 0.04800535f,
+    0.04866334f, 0.04932558f, 0.04999205f, 0.05066277f, 0.05133771f,
+    0.05201688f, 0.05270026f, 0.05338785f, 0.05407965f, 0.05477564f,
+    0.05547582f, 0.05618019f, 0.05688873f, 0.05760145f, 0.05831833f,
+    0.05903937f, 0.05976456f, 0.06049389f, 0.06122735f, 0.06196495f,
+    0.06270667f, 0.06345251f, 0.06420246f, 0.06495650f, 0.06571465f,
+    0.06647688f, 0.06724319f, 0.06801357f, 0.06878802f, 0.06956653f,
+    0.07034909f, 0.07113569f, 0.07192634f, 0.07272101f, 0.07351970f,
+    0.07432240f, 0.07512912f, 0.07593983f, 0.07675453f, 0.07757322f,
+    0.07839588f, 0.07922251f, 0.08005310f, 0.08088765f, 0.08172614f,
+    0.08256856f, 0.08341492f, 0.08426519f, 0.08511938f, 0.08597748f,
+    0.08683947f, 0.08770535f, 0.08857511f, 0.08944874f, 0.09032624f,
+    0.09120759f, 0.09209279f, 0.09298184f, 0.09387471f, 0.09477140f,
+    0.09567191f, 0.09657622f, 0.09748433f, 0.09839623f, 0.09931191f,
+    0.10023137f, 0.10115458f, 0.10208155f, 0.10301226f, 0.10394671f,
+    0.10488489f, 0.10582679f, 0.10677239f, 0.10772170f, 0.10867470f,
+    0.10963139f, 0.11059174f, 0.11155577f, 0.11252345f, 0.11349477f,
+    0.11446974f, 0.11544833f, 0.11643054f, 0.11741637f, 0.11840579f,
+    0.11939881f, 0.12039541f, 0.12139558f, 0.12239931f, 0.12340660f,
+    0.12441743f, 0.12543180f, 0.12644970f, 0.12747111f, 0.12849602f,
+    0.12952444f, 0.13055634f, 0.13159172f, 0.13263056f, 0.13367286f,
+    0.13471862f, 0.13576780f, 0.13682042f, 0.13787646f, 0.13893590f,
+    0.13999875f, 0.14106498f, 0.14213459f, 0.14320757f, 0.14428390f,
+    0.14536359f, 0.14644661f, 0.14753296f, 0.14862263f, 0.14971560f,
+    0.15081188f, 0.15191143f, 0.15301427f, 0.15412037f, 0.15522973f,
+    0.15634233f, 0.15745817f, 0.15857723f, 0.15969950f, 0.16082498f,
+    0.16195365f, 0.16308550f, 0.16422052f, 0.16535871f, 0.16650004f,
+    0.16764451f, 0.16879211f, 0.16994283f, 0.17109665f, 0.17225357f,
+    0.17341358f, 0.17457666f, 0.17574280f, 0.17691199f, 0.17808423f,
+    0.17925949f, 0.18043778f, 0.18161907f, 0.18280336f, 0.18399063f,
+    0.18518088f, 0.18637409f, 0.18757026f, 0.18876936f, 0.18997139f,
+    0.19117635f, 0.19238420f, 0.19359496f, 0.19480860f, 0.19602511f,
+    0.19724448f, 0.19846670f, 0.19969176f, 0.20091965f, 0.20215035f,
+    0.20338385f, 0.20462015f, 0.20585923f, 0.20710107f, 0.20834567f,
+    0.20959302f, 0.21084310f, 0.21209590f, 0.21335142f, 0.21460963f,
+    0.21587052f, 0.21713409f, 0.21840033f, 0.21966921f, 0.22094073f,
+    0.22221488f, 0.22349165f, 0.22477101f, 0.22605297f, 0.22733751f,
+    0.22862461f, 0.22991426f, 0.23120646f, 0.23250119f, 0.23379844f,
+    0.23509819f, 0.23640043f, 0.23770516f, 0.23901235f, 0.24032200f,
+    0.24163410f, 0.24294863f, 0.24426557f, 0.24558493f, 0.24690668f,
+    0.24823081f, 0.24955731f, 0.25088617f, 0.25221737f, 0.25355090f,
+    0.25488676f, 0.25622492f, 0.25756538f, 0.25890811f, 0.26025312f,
+    0.26160038f, 0.26294989f, 0.26430163f, 0.26565559f, 0.26701175f,
+    0.26837011f, 0.26973064f, 0.27109335f, 0.27245821f, 0.27382521f,
+    0.27519434f, 0.27656558f, 0.27793893f, 0.27931437f, 0.28069188f,
+    0.28207146f, 0.28345309f, 0.28483676f, 0.28622245f, 0.28761016f,
+    0.28899986f, 0.29039156f, 0.29178522f, 0.29318084f, 0.29457841f,
+    0.29597792f, 0.29737934f, 0.29878267f, 0.30018790f, 0.30159501f,
+    0.30300398f, 0.30441481f, 0.30582748f, 0.30724197f, 0.30865828f,
+    0.31007640f, 0.31149629f, 0.31291797f, 0.31434140f, 0.31576659f,
+    0.31719350f, 0.31862214f, 0.32005248f, 0.32148452f, 0.32291824f,
+    0.32435362f, 0.32579066f, 0.32722934f, 0.32866964f, 0.33011156f,
+    0.33155507f, 0.33300017f, 0.33444685f, 0.33589508f, 0.33734485f,
+    0.33879616f, 0.34024898f, 0.34170331f, 0.34315913f, 0.34461642f,
+    0.34607518f, 0.34753539f, 0.34899703f, 0.35046009f, 0.35192456f,
+    0.35339042f, 0.35485766f, 0.35632627f, 0.35779623f, 0.35926753f,
+    0.36074016f, 0.36221409f, 0.36368932f, 0.36516584f, 0.36664362f,
+    0.36812266f, 0.36960294f, 0.37108445f, 0.37256717f, 0.37405109f,
+    0.37553620f, 0.37702247f, 0.37850991f, 0.37999849f, 0.38148820f,
+    0.38297902f, 0.38447095f, 0.38596396f, 0.38745804f, 0.38895319f,
+    0.39044938f, 0.39194660f, 0.39344484f, 0.39494408f, 0.39644431f,
+    0.39794552f, 0.39944768f, 0.40095079f, 0.40245484f, 0.40395980f,
+    0.40546567f, 0.40697242f, 0.40848006f, 0.40998855f, 0.41149789f,
+    0.41300806f, 0.41451906f, 0.41603085f, 0.41754344f, 0.41905680f,
+    0.42057093f, 0.42208580f, 0.42360141f, 0.42511773f, 0.42663476f,
+    0.42815248f, 0.42967088f, 0.43118994f, 0.43270965f, 0.43422999f,
+    0.43575094f, 0.43727251f, 0.43879466f, 0.44031739f, 0.44184068f,
+    0.44336452f, 0.44488890f, 0.44641379f, 0.44793918f, 0.44946507f,
+    0.45099143f, 0.45251825f, 0.45404552f, 0.45557322f, 0.45710134f,
+    0.45862987f, 0.46015878f, 0.46168807f, 0.46321772f, 0.46474771f,
+    0.46627804f, 0.46780868f, 0.46933963f, 0.47087087f, 0.47240238f,
+    0.47393415f, 0.47546616f, 0.47699841f, 0.47853087f, 0.48006354f,
+    0.48159639f, 0.48312941f, 0.48466260f, 0.48619593f, 0.48772939f,
+    0.48926296f, 0.49079664f, 0.49233040f, 0.49386423f, 0.49539812f,
+    0.49693206f, 0.49846602f, 0.50000000f, 0.50153398f, 0.50306794f,
+    0.50460188f, 0.50613577f, 0.50766960f, 0.50920336f, 0.51073704f,
+    0.51227061f, 0.51380407f, 0.51533740f, 0.51687059f, 0.51840361f,
+    0.51993646f, 0.52146913f, 0.52300159f, 0.52453384f, 0.52606585f,
+    0.52759762f, 0.52912913f, 0.53066037f, 0.53219132f, 0.53372196f,
+    0.53525229f, 0.53678228f, 0.53831193f, 0.53984122f, 0.54137013f,
+    0.54289866f, 0.54442678f, 0.54595448f, 0.54748175f, 0.54900857f,
+    0.55053493f, 0.55206082f, 0.55358621f, 0.55511110f, 0.55663548f,
+    0.55815932f, 0.55968261f, 0.56120534f, 0.56272749f, 0.56424906f,
+    0.56577001f, 0.56729035f, 0.56881006f, 0.57032912f, 0.57184752f,
+    0.57336524f, 0.57488227f, 0.57639859f, 0.57791420f, 0.57942907f,
+    0.58094320f, 0.58245656f, 0.58396915f, 0.58548094f, 0.58699194f,
+    0.58850211f, 0.59001145f, 0.59151994f, 0.59302758f, 0.59453433f,
+    0.59604020f, 0.59754516f, 0.59904921f, 0.60055232f, 0.60205448f,
+    0.60355569f, 0.60505592f, 0.60655516f, 0.60805340f, 0.60955062f,
+    0.61104681f, 0.61254196f, 0.61403604f, 0.61552905f, 0.61702098f,
+    0.61851180f, 0.62000151f, 0.62149009f, 0.62297753f, 0.62446380f,
+    0.62594891f, 0.62743283f, 0.62891555f, 0.63039706f, 0.63187734f,
+    0.63335638f, 0.63483416f, 0.63631068f, 0.63778591f, 0.63925984f,
+    0.64073247f, 0.64220377f, 0.64367373f, 0.64514234f, 0.64660958f,
+    0.64807544f, 0.64953991f, 0.65100297f, 0.65246461f, 0.65392482f,
+    0.65538358f, 0.65684087f, 0.65829669f, 0.65975102f, 0.66120384f,
+    0.66265515f, 0.66410492f, 0.66555315f, 0.66699983f, 0.66844493f,
+    0.66988844f, 0.67133036f, 0.67277066f, 0.67420934f, 0.67564638f,
+    0.67708176f, 0.67851548f, 0.67994752f, 0.68137786f, 0.68280650f,
+    0.68423341f, 0.68565860f, 0.68708203f, 0.68850371f, 0.68992360f,
+    0.69134172f, 0.69275803f, 0.69417252f, 0.69558519f, 0.69699602f,
+    0.69840499f, 0.69981210f, 0.70121733f, 0.70262066f, 0.70402208f,
+    0.70542159f, 0.70681916f, 0.70821478f, 0.70960844f, 0.71100014f,
+    0.71238984f, 0.71377755f, 0.71516324f, 0.71654691f, 0.71792854f,
+    0.71930812f, 0.72068563f, 0.72206107f, 0.72343442f, 0.72480566f,
+    0.72617479f, 0.72754179f, 0.72890665f, 0.73026936f, 0.73162989f,
+    0.73298825f, 0.73434441f, 0.73569837f, 0.73705011f, 0.73839962f,
+    0.73974688f, 0.74109189f, 0.74243462f, 0.74377508f, 0.74511324f,
+    0.74644910f, 0.74778263f, 0.74911383f, 0.75044269f, 0.75176919f,
+    0.75309332f, 0.75441507f, 0.75573443f, 0.75705137f, 0.75836590f,
+    0.75967800f, 0.76098765f, 0.76229484f, 0.76359957f, 0.76490181f,
+    0.76620156f, 0.76749881f, 0.76879354f, 0.77008574f, 0.77137539f,
+    0.77266249f, 0.77394703f, 0.77522899f, 0.77650835f, 0.77778512f,
+    0.77905927f, 0.78033079f, 0.78159967f, 0.78286591f, 0.78412948f,
+    0.78539037f, 0.78664858f, 0.78790410f, 0.78915690f, 0.79040698f,
+    0.79165433f, 0.79289893f, 0.79414077f, 0.79537985f, 0.79661615f,
+    0.79784965f, 0.79908035f, 0.80030824f, 0.80153330f, 0.80275552f,
+    0.80397489f, 0.80519140f, 0.80640504f, 0.80761580f, 0.80882365f,
+    0.81002861f, 0.81123064f, 0.81242974f, 0.81362591f, 0.81481912f,
+    0.81600937f, 0.81719664f, 0.81838093f, 0.81956222f, 0.82074051f,
+    0.82191577f, 0.82308801f, 0.82425720f, 0.82542334f, 0.82658642f,
+    0.82774643f, 0.82890335f, 0.83005717f, 0.83120789f, 0.83235549f,
+    0.83349996f, 0.83464129f, 0.83577948f, 0.83691450f, 0.83804635f,
+    0.83917502f, 0.84030050f, 0.84142277f, 0.84254183f, 0.84365767f,
+    0.84477027f, 0.84587963f, 0.84698573f, 0.84808857f, 0.84918812f,
+    0.85028440f, 0.85137737f, 0.85246704f, 0.85355339f, 0.85463641f,
+    0.85571610f, 0.85679243f, 0.85786541f, 0.85893502f, 0.86000125f,
+    0.86106410f, 0.86212354f, 0.86317958f, 0.86423220f, 0.86528138f,
+    0.86632714f, 0.86736944f, 0.86840828f, 0.86944366f, 0.87047556f,
+    0.87150398f, 0.87252889f, 0.87355030f, 0.87456820f, 0.87558257f,
+    0.87659340f, 0.87760069f, 0.87860442f, 0.87960459f, 0.88060119f,
+    0.88159421f, 0.88258363f, 0.88356946f, 0.88455167f, 0.88553026f,
+    0.88650523f, 0.88747655f, 0.88844423f, 0.88940826f, 0.89036861f,
+    0.89132530f, 0.89227830f, 0.89322761f, 0.89417321f, 0.89511511f,
+    0.89605329f, 0.89698774f, 0.89791845f, 0.89884542f, 0.89976863f,
+    0.90068809f, 0.90160377f, 0.90251567f, 0.90342378f, 0.90432809f,
+    0.90522860f, 0.90612529f, 0.90701816f, 0.90790721f, 0.90879241f,
+    0.90967376f, 0.91055126f, 0.91142489f, 0.91229465f, 0.91316053f,
+    0.91402252f, 0.91488062f, 0.91573481f, 0.91658508f, 0.91743144f,
+    0.91827386f, 0.91911235f, 0.91994690f, 0.92077749f, 0.92160412f,
+    0.92242678f, 0.92324547f, 0.92406017f, 0.92487088f, 0.92567760f,
+    0.92648030f, 0.92727899f, 0.92807366f, 0.92886431f, 0.92965091f,
+    0.93043347f, 0.93121198f, 0.93198643f, 0.93275681f, 0.93352312f,
+    0.93428535f, 0.93504350f, 0.93579754f, 0.93654749f, 0.93729333f,
+    0.93803505f, 0.93877265f, 0.93950611f, 0.94023544f, 0.94096063f,
+    0.94168167f, 0.94239855f, 0.94311127f, 0.94381981f, 0.94452418f,
+    0.94522436f, 0.94592035f, 0.94661215f, 0.94729974f, 0.94798312f,
+    0.94866229f, 0.94933723f, 0.95000795f, 0.95067442f, 0.95133666f,
+    0.95199465f, 0.95264838f, 0.95329785f, 0.95394306f, 0.95458399f,
+    0.95522065f, 0.95585302f, 0.95648110f, 0.95710488f, 0.95772436f,
+    0.95833953f, 0.95895039f, 0.95955693f, 0.96015914f, 0.96075702f,
+    0.96135056f, 0.96193977f, 0.96252462f, 0.96310512f, 0.96368126f,
+    0.96425304f, 0.96482045f, 0.96538348f, 0.96594213f, 0.96649640f,
+    0.96704628f, 0.96759175f, 0.96813283f, 0.96866951f, 0.96920177f,
+    0.96972961f, 0.97025304f, 0.97077203f, 0.97128660f, 0.97179673f,
+    0.97230242f, 0.97280366f, 0.97330046f, 0.97379280f, 0.97428067f,
+    0.97476409f, 0.97524304f, 0.97571751f, 0.97618751f, 0.97665302f,
+    0.97711405f, 0.97757058f, 0.97802263f, 0.97847017f, 0.97891321f,
+    0.97935174f, 0.97978576f, 0.98021526f, 0.98064024f, 0.98106070f,
+    0.98147663f, 0.98188803f, 0.98229490f, 0.98269722f, 0.98309500f,
+    0.98348824f, 0.98387692f, 0.98426105f, 0.98464062f, 0.98501563f,
+    0.98538607f, 0.98575195f, 0.98611325f, 0.98646998f, 0.98682212f,
+    0.98716969f, 0.98751267f, 0.98785107f, 0.98818487f, 0.98851407f,
+    0.98883868f, 0.98915869f, 0.98947409f, 0.98978488f, 0.99009107f,
+    0.99039264f, 0.99068960f, 0.99098193f, 0.99126965f, 0.99155274f,
+    0.99183121f, 0.99210505f, 0.99237425f, 0.99263882f, 0.99289875f,
+    0.99315405f, 0.99340470f, 0.99365071f, 0.99389207f, 0.99412878f,
+    0.99436085f, 0.99458825f, 0.99481101f, 0.99502911f, 0.99524254f,
+    0.99545132f, 0.99565543f, 0.99585488f, 0.99604966f, 0.99623977f,
+    0.99642521f, 0.99660597f, 0.99678207f, 0.99695349f, 0.99712022f,
+    0.99728229f, 0.99743967f, 0.99759236f, 0.99774038f, 0.99788371f,
+    0.99802235f, 0.99815631f, 0.99828557f, 0.99841015f, 0.99853004f,
+    0.99864523f, 0.99875573f, 0.99886153f, 0.99896264f, 0.99905906f,
+    0.99915077f, 0.99923779f, 0.99932011f, 0.99939773f, 0.99947065f,
+    0.99953886f, 0.99960238f, 0.99966119f, 0.99971530f, 0.99976471f,
+    0.99980941f, 0.99984941f, 0.99988470f, 0.99991529f, 0.99994117f,
+    0.99996235f, 0.99997882f, 0.99999059f, 0.99999765f, 1.00000000f,
+};
+
+static float32_t tap[TAP_LEN];
+static uint32_t tap_pos;
+// samples fed in total, wrapping. read twice around the copy of a frame.
+static volatile uint32_t tap_total;
+static uint32_t tap_due;
+
+// settings from USB. the audio side follows source and interval right
+// away, the background takes over size and rate at the next frame.
+static spectrum_config_t config = {SPECTRUM_OFF, 0, SPECTRUM_DEFAULT_SIZE,
+                                   SPECTRUM_DEFAULT_INTERVAL};
+static uint32_t rate = PLAYBACK_DEFAULT_RATE;
+static volatile uint8_t source = SPECTRUM_OFF;
+static volatile uint32_t interval;
+static volatile uint8_t setup_pending = 1;
+// a frame is pended or being worked on
+static volatile uint8_t busy;
+// no feeding and no frames while the CPU is short
+static volatile uint8_t bypass;
+
+static arm_rfft_fast_instance_f32 rfft;
+static uint32_t size;
+static float32_t norm;
+static uint16_t band_first[SPECTRUM_BANDS];
+static uint16_t band_last[SPECTRUM_BANDS];
+static float32_t frame[SPECTRUM_MAX_SIZE];
+static float32_t bins[SPECTRUM_MAX_SIZE];
+static spectrum_report_t report __attribute__((aligned(4)));
+
+volatile spectrum_stats_t spectrum_stats;
+
+void spectrum_init(void) {
+  NVIC_SetPriority(SPECTRUM_IRQn, SPECTRUM_PRIORITY);
+  NVIC_EnableIRQ(SPECTRUM_IRQn);
+}
+
+static void spectrum_apply(void) {
+  interval = (uint32_t)config.interval * rate / 1000;
+  tap_due = interval;
+  source = config.source;
+  setup_pending = 1;
+}
+
+void spectrum_set_rate(uint32_t new_rate) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  rate = new_rate;
+  spectrum_apply();
+  __set_PRIMASK(primask);
+}
+
+// returns 0 for settings out of range
+int spectrum_set_config(const spectrum_config_t *c) {
+  if (c->source > SPECTRUM_CAPTURE || c->size < SPECTRUM_MIN_SIZE ||
+      c->size > SPECTRUM_MAX_SIZE || (c->size & (c->size - 1)) ||
+      c->interval < SPECTRUM_MIN_INTERVAL) {
+    return 0;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  config = *c;
+  config.reserved = 0;
+  spectrum_apply();
+  __set_PRIMASK(primask);
+  return 1;
+}
+
+void spectrum_get_config(spectrum_config_t *c) { *c = config; }
+
+void spectrum_set_bypass(uint8_t enable) { bypass = enable; }
+
+// append Q31 samples of the given source, mixing stereo down. called from
+// the playback and mic interrupts, it only copies and pends the background
+// once a report is due.
+void spectrum_feed(uint8_t src, const int32_t *in, uint32_t frames,
+                   uint32_t channels) {
+  if (src != source || bypass || frames == 0) {
+    return;
+  }
+
+  uint32_t pos = tap_pos;
+  for (uint32_t i = 0; i < frames; i++, in += channels) {
+    int32_t s = channels == 2 ? (in[0] >> 1) + (in[1] >> 1) : in[0];
+    tap[pos] = s * (1.0f / 2147483648.0f);
+    if (++pos == TAP_LEN) {
+      pos = 0;
+    }
+  }
+  tap_pos = pos;
+  tap_total += frames;
+
+  if (tap_due > frames) {
+    tap_due -= frames;
+    return;
+  }
+  tap_due = interval;
+  if (busy) {
+    spectrum_stats.skip_cnt++;
+    return;
+  }
+  busy = 1;
+  NVIC_SetPendingIRQ(SPECTRUM_IRQn);
+}
+
+// FFT length and the bins of each band. a band narrower than the bin
+// spacing takes the bin at its center, the lowest ones share bin 1.
+static void spectrum_setup(void) {
+  __disable_irq();
+  size = config.size;
+  float32_t df = (float32_t)rate / size;
+  setup_pending = 0;
+  __enable_irq();
+
+  arm_rfft_fast_init_f32(&rfft, size);
+
+  float32_t fc = BAND_FIRST_FC;
+  for (uint8_t b = 0; b < SPECTRUM_BANDS; b++, fc *= BAND_STEP) {
+    uint32_t first = (uint32_t)(fc / BAND_HALF / df + 0.5f);
+    uint32_t last = (uint32_t)(fc * BAND_HALF / df + 0.5f);
+    if (last <= first) {
+      first = (uint32_t)(fc / df + 0.5f);
+      last = first + 1;
+    }
+    // DC and the Nyquist bin are left out
+    if (first < 1) {
+      first = 1;
+      last = last > first ? last : first + 1;
+    }
+    if (last > size / 2) {
+      last = size / 2;
+    }
+    band_first[b] = first;
+    band_last[b] = last;
+  }
+
+  // a full scale sine through the window sums to 3 N^2 / 32 over the
+  // positive bins
+  norm = 32.0f / (3.0f * size * size);
+}
+
+// the newest frame through the window. returns 0 if the audio side wrote
+// over part of it meanwhile.
+static int spectrum_window(void) {
+  __disable_irq();
+  uint32_t pos = tap_pos;
+  uint32_t total = tap_total;
+  __enable_irq();
+
+  uint32_t step = SPECTRUM_MAX_SIZE / size;
+  pos = (pos + TAP_LEN - size) % TAP_LEN;
+  for (uint32_t i = 0; i < size; i++) {
+    uint32_t w = i <= size / 2 ? i : size - i;
+    frame[i] = tap[pos] * hann[w * step];
+    if (++pos == TAP_LEN) {
+      pos = 0;
+    }
+  }
+
+  // the copy is done before the count is read again
+  __DMB();
+  return tap_total - total <= TAP_LEN - size;
+}
+
+static void spectrum_bands(void) {
+  for (uint8_t b = 0; b < SPECTRUM_BANDS; b++) {
+    float32_t power = 0.0f;
+    for (uint32_t k = band_first[b]; k < band_last[b]; k++) {
+      float32_t re = bins[2 * k];
+      float32_t im = bins[2 * k + 1];
+      power += re * re + im * im;
+    }
+
+    int32_t level = LEVEL_FLOOR;
+    if (power > 0.0f) {
+      level = (int32_t)(10.0f * 256.0f * log10f(power * norm));
+    }
+    if (level < LEVEL_FLOOR) {
+      level = LEVEL_FLOOR;
+    } else if (level > INT16_MAX) {
+      level = INT16_MAX;
+    }
+    report.band[b] = level;
+  }
+}
+
+// one frame, below everything else. a report the host has not picked up
+// yet is replaced by nothing, the next one is newer anyway.
+void SPECTRUM_IRQHandler(void) {
+  uint32_t start = DWT->CYCCNT;
+
+  if (setup_pending) {
+    spectrum_setup();
+  }
+
+  if (!spectrum_window()) {
+    spectrum_stats.late_cnt++;
+    busy = 0;
+    return;
+  }
+  arm_rfft_fast_f32(&rfft, frame, bins, 0);
+  spectrum_bands();
+
+  report.seq++;
+  report.source = source;
+  if (!usb_report_send(&report, sizeof(report))) {
+    spectrum_stats.busy_cnt++;
+  }
+
+  uint32_t cycles = DWT->CYCCNT - start;
+  spectrum_stats.frame_cnt++;
+  spectrum_stats.cycles_last = cycles;
+  if (cycles > spectrum_stats.cycles_max) {
+    spectrum_stats.cycles_max = cycles;
+  }
+  PROF_RECORD(PROF_SPECTRUM, cycles);
+  busy = 0;
+}
@@ -1,4 +1,5 @@
 #include "tim.h"
+#include "prof.h"
 #include <stm32f411xe.h>
 
 void tim1_init(void) {
@@ -13,8 +14,10 @@ void tim1_init(void) {
 }
 
 void TIM1_UP_TIM10_IRQHandler(void) {
+  PROF_BEGIN(start);
   if (TIM1->SR & TIM_SR_UIF_Msk) {
     TIM1->SR &= ~TIM_SR_UIF;
     GPIOD->ODR ^= 1 << GPIO_ODR_OD15_Pos;
   }
+  PROF_END(PROF_TIM1, start);
 }
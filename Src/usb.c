@@ -1,196 +1,77 @@
 #include "usb.h"
+#include "audio_ring.h"
+#include "feedback.h"
+#include "mic.h"
+#include "playback.h"
+#include "prof.h"
+#include "usb_audio.h"
+#include "usb_desc.h"
+#include "usb_fifo.h"
+#include "usb_regs.h"
+#include "usb_vendor.h"
 #include <stddef.h>
 #include <stdint.h>
-#include <stm32f411xe.h>
-
-#define USB USB_OTG_FS
-#define USB_DEV                                                                \
-  ((USB_OTG_DeviceTypeDef *)((uint32_t)USB_OTG_FS_PERIPH_BASE +                \
-                             USB_OTG_DEVICE_BASE))
-#define USB_INEP                                                               \
-  ((USB_OTG_INEndpointTypeDef *)((uint32_t)USB_OTG_FS_PERIPH_BASE +            \
-                                 USB_OTG_IN_ENDPOINT_BASE))
-#define USB_OUTEP                                                              \
-  ((USB_OTG_OUTEndpointTypeDef *)((uint32_t)USB_OTG_FS_PERIPH_BASE +           \
-                                  USB_OTG_OUT_ENDPOINT_BASE))
-#define USB_FIFO(ep)                                                           \
-  ((uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_FIFO_BASE +                   \
-                ((ep) * USB_OTG_FIFO_SIZE)))
-
-static const uint8_t device_descriptor[] = {
-    0x12, // bLength
-    0x01, // bDescriptorType
-    0x00,
-    0x02,       // bcdUSB
-    0xef,       // bDeviceClass
-    0x02,       // bDeviceSubClass
-    0x01,       // bDeviceProtocol
-    0x40,       // bMaxPacketSize0
-    0x00, 0x00, // idVendor
-    0x00, 0x00, // idProduct
-    0x00, 0x00, // bcdDevice
-    0x01,       // iManufacture
-    0x02,       // iProduct
-    0x00,       // iSerialNumber
-    0x01        // bNumConfigurations
-};
-
-static const uint8_t config_descriptor[] = {
-    // standard configuration descriptor
-    0x09,       // bLength
-    0x02,       // bDescriptorType
-    0x87, 0x00, // wTotalLength
-    0x02,       // bNumInterfaces
-    0x01,       // bConfigurationValue
-    0x00,       // iConfiguration
-    0xc0,       // bmAttributes
-    50,         // bMaxPower
-                //
-
-    // IAD
-    0x08, // bLength
-    0x0b, // bDescriptorType
-    0x00, // bFirstInterface
-    0x02, // bInterfaceCount
-    0x01, // bFunctionClass
-    0x00, // bFunctionSubClass
-    0x20, // bFunctionProtocol
-    0x00, // iFunction
-
-    // standard AC interface descriptor (interface 0)
-    0x09, // bLength
-    0x04, // bDescriptorType
-    0x00, // bInterfaceNubmer
-    0x00, // bAlternateSetting
-    0x00, // bNumEndpoints
-    0x01, // bInterfaceClass
-    0x01, // bInterfaceSubClass
-    0x20, // bInterfaceProtocol
-    0x00, // iInterface
-
-    // class specific AC interface descriptor
-    0x09,       // bLength
-    0x24,       // bDescriptorType
-    0x01,       // bDescriptorSubType
-    0x00, 0x02, // bcdADC
-    0x01,       // bCategory
-    0x2e, 0x00, // wTotalLength
-    0x11,       // bmControls
-
-    // clock source descriptor
-    0x08, // bLength
-    0x24, // bDescripterType
-    0x0a, // bDescriptorSubtype
-    0x01, // bClockID
-    0x01, // bmAttributes
-    0x00, // bmControls
-    0x00, // bAssocTerminal
-    0x00, // iCockSource
-
-    // input terminal descriptor
-    0x11,                   // bLength
-    0x24,                   // bDescriptorType
-    0x02,                   // bDescriptorSubType
-    0x01,                   // bTerminalID
-    0x01, 0x02,             // wTerminalType
-    0x01,                   // bAssocTerminal
-    0x01,                   // bCSourceID
-    0x01,                   // bNrChannels
-    0x01, 0x00, 0x00, 0x00, // bmChannelConfig
-    0x00,                   // iChannelNames
-    0x00, 0x00,             // bmControls
-    0x00,                   // iTerminal
-
-    // output terminal descriptor
-    0x0c,       // bLength
-    0x24,       // bDescriptorType
-    0x03,       // bDescriptorSubType
-    0x02,       // bTerminalID
-    0x01, 0x03, // wTerminalType
-    0x00,       // bAssocTerminal
-    0x01,       // bSourceID
-    0x01,       // bCSourceID
-    0x00, 0x00, // bmControls
-    0x00,       // iTerminal
-
-    // standard AS interface descriptor (interface 1, alt 0)
-    0x09, // bLength
-    0x04, // bDescriptorType
-    0x01, // bInterfaceNumber
-    0x00, // bAlternateSetting
-    0x00, // bNumEndpoints
-    0x01, // bInterfaceClass
-    0x02, // bInterfaceSubClass
-    0x20, // bInterfaceProtocol
-    0x00, // iInterface
-
-    // standard AS interface descriptor (interface 1, alt 1)
-    0x09, // bLength
-    0x04, // bDescriptorType
-    0x01, // bInterfaceNumber
-    0x01, // bAlternateSetting
-    0x01, // bNumEndpoints
-    0x01, // bInterfaceClass
-    0x02, // bInterfaceSubClass
-    0x20, // bInterfaceProtocol
-    0x00, // iInterface
-
-    // class-specific AS interface descriptor
-    0x10,                   // bLength
-    0x24,                   // bDescriptorType
-    0x01,                   // bDescriptorSubType
-    0x01,                   // bTerminalLink
-    0x00,                   // bmControls
-    0x01,                   // bFormatType
-    0x01, 0x00, 0x00, 0x00, // bmFormats
-    0x02,                   // bNrChannels
-    0x03, 0x00, 0x00, 0x00, // bmChannelConfig
-    0x00,                   // iChannelNames
-
-    // format type descriptor
-    0x0e,             // bLength
-    0x24,             // bDescriptorType
-    0x02,             // bDescriptorSubType
-    0x01,             // bFormatType
-    0x02,             // bNrChannels
-    0x02,             // bSubFrameSize
-    0x10,             // bBitResolution
-    0x01,             // bSamFreqType
-    0x80, 0xbb, 0x00, // tLowerSamFreq
-    0x80, 0xbb, 0x00, // tUpperSamFreq
-
-    // standard isochronous endpoint descriptor
-    0x07,       // bLength
-    0x05,       // bDescriptorType
-    0x01,       // bEndpointAddress
-    0x05,       // bmAttributes
-    0xc0, 0x00, // wMaxPacketSize
-    0x01,       // bInterval
-
-    // class-specific endpoint descriptor
-    0x08,      // bLength
-    0x25,      // bDescriptorType
-    0x01,      // bDescriptorSubType
-    0x00,      // bmAttributes
-    0x00,      // bmControls
-    0x00,      // bLockDelayUnits
-    0x00, 0x00 // wLockDelay
-};
-
-// String Descriptors も追加
-static const uint8_t string_descriptor_0[] = {
-    0x04, 0x03, 0x09, 0x04 // Language ID: English (US)
-};
-
-static const uint8_t string_descriptor_1[] = {
-    0x1A, 0x03, // bLength, bDescriptorType
-    'S',  0,    'T', 0, 'M', 0, 'i', 0, 'c', 0, 'r', 0,
-    'o',  0,    'e', 0, 'l', 0, 'e', 0, 'c', 0, 't', 0};
 
-static const uint8_t string_descriptor_2[] = {
-    0x20, 0x03, // bLength (32 bytes), bDescriptorType (STRING)
-    'U',  0,    'S', 0, 'B', 0, ' ', 0, 'A', 0, 'u', 0, 'd', 0, 'i', 0,
-    'o',  0,    ' ', 0, 'D', 0, 'e', 0, 'v', 0, 'i', 0, 'c', 0, 'e', 0};
+#define EP0_MPS 64
+
+#define EP_TYPE_ISO (1 << USB_OTG_DIEPCTL_EPTYP_Pos)
+#define EP_TYPE_INTR (3 << USB_OTG_DIEPCTL_EPTYP_Pos)
+// DOEPCTL has the same even/odd frame status bit, the header only names it
+// for DIEPCTL
+#define EP_EONUM USB_OTG_DIEPCTL_EONUM_DPID_Msk
+
+// standard requests
+#define USB_REQ_GET_STATUS 0x00
+#define USB_REQ_CLEAR_FEATURE 0x01
+#define USB_REQ_SET_FEATURE 0x03
+#define USB_REQ_SET_ADDRESS 0x05
+#define USB_REQ_GET_DESCRIPTOR 0x06
+#define USB_REQ_GET_CONFIGURATION 0x08
+#define USB_REQ_SET_CONFIGURATION 0x09
+#define USB_REQ_GET_INTERFACE 0x0a
+#define USB_REQ_SET_INTERFACE 0x0b
+
+#define USB_FEATURE_ENDPOINT_HALT 0x00
+
+typedef enum {
+  EP0_IDLE,
+  EP0_DATA_IN,
+  EP0_DATA_OUT,
+  EP0_STATUS_IN,
+  EP0_STATUS_OUT,
+} ep0_state_t;
+
+typedef void (*ep_rx_handler_t)(uint32_t bc);
+typedef void (*ep_int_handler_t)(uint32_t epint);
+
+// FIFO words unpacked at a time, whole frames of every format
+#define EP1_WINDOW_WORDS 12
+// largest mic packet, in Q31 samples before they are packed
+#define EP2_IN_MAX_FRAMES (PLAYBACK_MAX_RATE / 1000 + 1)
+
+// mic ring level the IN packet sizes steer towards, two capture blocks
+#define MIC_IN_TARGET (2 * MIC_BLOCK_FRAMES)
+
+// endpoints the alternate settings of the AS interfaces use, EP0 included,
+// for the FIFO planner. packet sizes follow the format and the sample rate.
+// the feedback FIFO is kept while the speaker is idle, so starting
+// playback does not move the mic FIFO stacked below it.
+static void as_eps(const uint8_t *alts, usb_fifo_eps_t *eps) {
+  const usb_audio_format_t *fmt = usb_audio_format(alts[USB_AS_INTERFACE]);
+
+  eps->out_mps = EP0_MPS;
+  eps->in_mps[0] = EP0_MPS;
+  eps->in_mps[1] = 3;
+  eps->in_mps[2] = 0;
+  eps->in_mps[USB_REPORT_EP] = USB_REPORT_MPS;
+
+  if (fmt != NULL) {
+    eps->out_mps = usb_audio_out_mps(fmt);
+  }
+  if (alts[USB_MIC_INTERFACE] != 0) {
+    eps->in_mps[2] = usb_audio_in_mps();
+  }
+}
 
 static void usb_core_reset(void) {
   USB->GRSTCTL |= USB_OTG_GRSTCTL_CSRST;
@@ -199,27 +80,31 @@ static void usb_core_reset(void) {
 }
 
 void usb_init(void) {
-  RCC->AHB2ENR |= RCC_AHB2ENR_OTGFSEN;
+  USB_CLK_ENABLE();
 
   usb_core_reset();
+  USB_CYCCNT_INIT();
 
   USB->GCCFG |= USB_OTG_GCCFG_PWRDWN | USB_OTG_GCCFG_VBUSBSEN;
   USB->GUSBCFG |= USB_OTG_GUSBCFG_FDMOD;
-  USB->GRXFSIZ = 128;
-  USB->DIEPTXF0_HNPTXFSIZ = (64 << USB_OTG_DIEPTXF_INEPTXFD_Pos) | 128;
-  USB->DIEPTXF[0] = (128 << USB_OTG_DIEPTXF_INEPTXFD_Pos) | 192;
+  uint8_t alts[USB_NUM_INTERFACES] = {0};
+  usb_fifo_eps_t eps;
+  usb_fifo_plan_t plan;
+  as_eps(alts, &eps);
+  usb_fifo_plan(&eps, &plan);
+  usb_fifo_apply(&plan);
   USB_DEV->DCFG |= USB_OTG_DCFG_DSPD;
   USB_DEV->DIEPMSK |= USB_OTG_DIEPMSK_XFRCM;
   USB_DEV->DOEPMSK |= USB_OTG_DOEPMSK_XFRCM;
 
   USB->GINTMSK |= USB_OTG_GINTMSK_USBRST | USB_OTG_GINTMSK_ENUMDNEM |
                   USB_OTG_GINTMSK_RXFLVLM | USB_OTG_GINTMSK_IEPINT |
-                  USB_OTG_GINTMSK_OEPINT;
-  USB_INEP[0].DIEPINT |= USB_OTG_DIEPINT_XFRC;
+                  USB_OTG_GINTMSK_OEPINT | USB_OTG_GINTMSK_IISOIXFRM |
+                  USB_OTG_GINTMSK_PXFRM_IISOOXFRM;
+  USB_INT_CLEAR(USB_INEP[0].DIEPINT, USB_OTG_DIEPINT_XFRC);
   USB->GAHBCFG |= USB_OTG_GAHBCFG_GINT;
 
-  NVIC_SetPriority(OTG_FS_IRQn, 0);
-  NVIC_EnableIRQ(OTG_FS_IRQn);
+  USB_IRQ_ENABLE();
 
   USB_DEV->DCTL &= ~USB_OTG_DCTL_SDIS;
 }
@@ -227,242 +112,942 @@ void usb_init(void) {
 // for debug
 static volatile uint32_t reset_cnt = 0;
 static volatile uint32_t setup_cnt = 0;
+static volatile uint32_t stall_cnt = 0;
 static volatile uint32_t set_interface_cnt = 0;
 static volatile uint32_t alt_setting_0_cnt = 0;
-static volatile uint32_t alt_setting_1_cnt = 0;
+static volatile uint32_t alt_setting_n_cnt = 0;
 static volatile uint32_t oepint_cnt = 0;
 static volatile uint32_t ep1_xfrc_cnt = 0;
 static volatile uint32_t ep1_out_data_cnt = 0;
 static volatile uint32_t daint_reg = 0;
 
+volatile usb_stats_t usb_stats;
+
+static volatile uint32_t ep1_in_xfrc_cnt = 0;
+static volatile uint32_t ep2_in_xfrc_cnt = 0;
+
+static union {
+  uint32_t raw[2];
+  usb_setup_t req;
+} setup;
+
+static ep0_state_t ep0_state = EP0_IDLE;
 static const uint8_t *ep0_tx_ptr;
-static uint16_t ep0_tx_remeining;
+static uint16_t ep0_tx_remaining;
+static uint8_t ep0_tx_zlp;
+static uint8_t *ep0_rx_ptr;
+static uint16_t ep0_rx_remaining;
+static usb_ctrl_handler_t ep0_rx_done;
+static uint8_t ep0_reply[2];
+
+static uint8_t configuration = 0;
+static uint8_t alt_setting[USB_NUM_INTERFACES];
+static const uint8_t num_alts[USB_NUM_INTERFACES] = {
+    [USB_AS_INTERFACE] = USB_AS_NUM_ALTS,
+    [USB_MIC_INTERFACE] = USB_MIC_NUM_ALTS,
+};
+static uint16_t ep1_out_mps;
+static const usb_audio_format_t *ep1_format;
+static uint8_t stream_restart_pending;
+
+// staged mic packet, Q31 samples until they are packed in place
+static uint32_t ep2_pkt[EP2_IN_MAX_FRAMES];
+static uint16_t ep2_pkt_len;
+static uint16_t mic_frac;
+static uint8_t mic_primed;
+
+// isochronous endpoints re-targeted after an incomplete transfer, one bit
+// per endpoint number
+static uint8_t iso_in_missed;
+static uint8_t iso_out_missed;
+
+static uint32_t usb_frame(void) {
+  return (USB_DEV->DSTS & USB_OTG_DSTS_FNSOF_Msk) >> USB_OTG_DSTS_FNSOF_Pos;
+}
 
-void OTG_FS_IRQHandler(void) {
-  uint32_t gintsts = USB->GINTSTS;
+// even/odd frame bits that target the frame after the current one, at the
+// same position in DIEPCTL and DOEPCTL
+static uint32_t iso_next_frame(void) {
+  return (usb_frame() & 1) ? USB_OTG_DIEPCTL_SD0PID_SEVNFRM
+                           : USB_OTG_DIEPCTL_SODDFRM;
+}
 
-  if (gintsts & USB_OTG_GINTSTS_USBRST_Msk) {
-    reset_cnt++;
-    USB_DEV->DCFG &= ~USB_OTG_DCFG_DAD;
+// queue the next feedback value on EP1 IN for the upcoming frame
+static void ep1_feedback_send(void) {
+  if (!usb_fifo_room(1, 3)) {
+    return;
+  }
 
-    USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_USBAEP |
-                           (64 << USB_OTG_DIEPCTL_MPSIZ_Pos) |
-                           USB_OTG_DIEPCTL_CNAK;
-    USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_USBAEP |
-                            (64 << USB_OTG_DOEPCTL_MPSIZ_Pos) |
-                            USB_OTG_DOEPCTL_CNAK;
+  uint32_t fb = feedback_value();
+  USB_INEP[1].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_MULCNT_Pos) |
+                         (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | 3;
+  USB_INEP[1].DIEPCTL |=
+      iso_next_frame() | USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+  usb_fifo_write(1, (const uint8_t *)&fb, 3);
+}
 
-    USB_DEV->DAINTMSK |=
-        (1 << USB_OTG_DAINTMSK_IEPM_Pos) | (1 << USB_OTG_DAINTMSK_OEPM_Pos);
+// convert the next mic packet ahead of time, so the IN interrupt only has
+// to copy it into the TX FIFO. the nominal frame count carries the fraction
+// of 44.1 kHz style rates from packet to packet, and one frame is added or
+// dropped when the capture clock has moved the ring off its target level.
+// zero length packets go out until the ring first reaches it.
+static void ep2_stage(void) {
+  uint32_t rate = playback_rate();
+  uint32_t fill = audio_ring_fill(&mic_ring);
+  uint32_t frames = rate / 1000;
+
+  mic_frac += rate % 1000;
+  if (mic_frac >= 1000) {
+    mic_frac -= 1000;
+    frames++;
+  }
 
-    USB->GINTSTS = USB_OTG_GINTSTS_USBRST;
+  if (!mic_primed) {
+    if (fill < MIC_IN_TARGET) {
+      ep2_pkt_len = 0;
+      return;
+    }
+    mic_primed = 1;
+  }
+  // no dead band: a level left resting below the target is a block short
+  // of an empty ring when the capture clock next falls behind by one
+  if (fill > MIC_IN_TARGET) {
+    frames++;
+  } else if (fill < MIC_IN_TARGET) {
+    frames--;
   }
 
-  if (gintsts & USB_OTG_GINTSTS_RXFLVL_Msk) {
-    uint32_t grxstsp = USB->GRXSTSP;
-    uint8_t pktsts =
-        (grxstsp & USB_OTG_GRXSTSP_PKTSTS_Msk) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
-    uint8_t epnum =
-        (grxstsp & USB_OTG_GRXSTSP_EPNUM_Msk) >> USB_OTG_GRXSTSP_EPNUM_Pos;
-    uint32_t *fifo = USB_FIFO(0);
-
-    if (pktsts == 0x06) {
-      // SETUP packet
-      setup_cnt++;
-      uint32_t setup[2];
-
-      setup[0] = *fifo;
-      setup[1] = *fifo;
-
-      uint8_t bRequest = (setup[0] >> 8) & 0xff;
-      uint8_t bmRequestType = setup[0] & 0xff;
-      uint16_t wValue = (setup[0] >> 16) & 0xffff;
-      uint16_t wLength = (setup[1] >> 16) & 0xffff;
-      uint16_t wIndex = setup[1] & 0xffff;
-
-      if (bRequest == 0x06) {
-        // GET_DESCRIPTOR
-        uint8_t desc_type = wValue >> 8;
-        uint8_t desc_index = wValue & 0xff;
-        uint16_t len = 0;
-        const uint8_t *data = NULL;
-
-        if (desc_type == 0x01) {
-          // Device
-          data = device_descriptor;
-          len = sizeof(device_descriptor);
-
-        } else if (desc_type == 0x02) {
-          data = config_descriptor;
-          len = sizeof(config_descriptor);
-
-        } else if (desc_type == 0x03) {
-          switch (desc_index) {
-          case 0:
-            data = string_descriptor_0;
-            len = sizeof(string_descriptor_0);
-            break;
-
-          case 1:
-            data = string_descriptor_1;
-            len = sizeof(string_descriptor_1);
-            break;
-
-          case 2:
-            data = string_descriptor_2;
-            len = sizeof(string_descriptor_2);
-            break;
-
-          default:
-            USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_STALL;
-            return;
-          }
-        } else {
-          USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_STALL;
-        }
+  // word i of the packet takes samples 2i and 2i+1, both read by then
+  frames = audio_ring_read(&mic_ring, ep2_pkt, frames);
+  for (uint32_t i = 0; i < frames / 2; i++) {
+    ep2_pkt[i] = __PKHTB(ep2_pkt[2 * i + 1], ep2_pkt[2 * i], 16);
+  }
+  if (frames & 1) {
+    ep2_pkt[frames / 2] = ep2_pkt[frames - 1] >> 16;
+  }
+  ep2_pkt_len = frames * USB_AUDIO_MIC_FRAME_BYTES;
+}
 
-        if (data) {
-          if (len > wLength) {
-            len = wLength;
-          }
-
-          ep0_tx_ptr = data;
-          ep0_tx_remeining = len;
-
-          uint16_t pkt_len = (ep0_tx_remeining > 64) ? 64 : ep0_tx_remeining;
-
-          USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) |
-                                 ((pkt_len & USB_OTG_DIEPTSIZ_XFRSIZ_Msk)
-                                  << USB_OTG_DIEPTSIZ_XFRSIZ_Pos);
-          USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
-
-          for (uint8_t i = 0; i < (pkt_len + 3) / 4; i++) {
-            uint32_t val = 0;
-            for (uint8_t b = 0; b < 4; b++) {
-              if (4 * i + b < pkt_len) {
-                val |= ((uint32_t)ep0_tx_ptr[4 * i + b]) << (8 * b);
-              }
-            }
-            *fifo = val;
-          }
-
-          ep0_tx_ptr += pkt_len;
-          ep0_tx_remeining -= pkt_len;
-        }
+// queue the staged mic packet on EP2 IN for the upcoming frame
+static void ep2_mic_send(void) {
+  if (!usb_fifo_room(2, ep2_pkt_len)) {
+    return;
+  }
 
-      } else if (bRequest == 0x05) {
-        uint8_t addr = wValue & 0x7f;
-        USB_DEV->DCFG |= addr << USB_OTG_DCFG_DAD_Pos;
-        USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos);
-        USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
-
-      } else if (bRequest == 0x0b && (bmRequestType & 0x1f) == 0x01) {
-        // SET_INTERFACE request
-        set_interface_cnt++;
-        uint8_t interface_num = wIndex & 0xff;
-        uint8_t alt_settings = wValue & 0xff;
-
-        if (interface_num == 1) {
-          // AS interface
-          if (alt_settings == 0) {
-            alt_setting_0_cnt++;
-            USB_INEP[1].DIEPCTL &= ~USB_OTG_DIEPCTL_EPENA;
-            USB_OUTEP[1].DOEPCTL &= ~USB_OTG_DOEPCTL_EPENA;
-          } else if (alt_settings == 1) {
-            alt_setting_1_cnt++;
-            USB_INEP[1].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | 192;
-            USB_INEP[1].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
-            USB_OUTEP[1].DOEPTSIZ = (1 << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | 192;
-            USB_OUTEP[1].DOEPCTL |=
-                USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
-          }
-        }
+  USB_INEP[2].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_MULCNT_Pos) |
+                         (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | ep2_pkt_len;
+  USB_INEP[2].DIEPCTL |=
+      iso_next_frame() | USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+  usb_fifo_write(2, (const uint8_t *)ep2_pkt, ep2_pkt_len);
+}
 
-        // Status stage
-        USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos);
-        USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+// arm EP1 OUT for the audio packet of the next frame
+static void ep1_out_arm(void) {
+  USB_OUTEP[1].DOEPTSIZ = (1 << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | ep1_out_mps;
+  USB_OUTEP[1].DOEPCTL |=
+      iso_next_frame() | USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+}
 
-      } else if (bRequest == 0x09) {
-        // SET_CONFIGURATION
-        USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | 0;
-        USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+// bounded so a core that never acknowledges can not hang the interrupt
+static void ep_in_disable(uint8_t ep) {
+  if (!(USB_INEP[ep].DIEPCTL & USB_OTG_DIEPCTL_EPENA)) {
+    return;
+  }
 
-      } else {
-        USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_STALL;
-        USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_STALL;
-      }
+  USB_INEP[ep].DIEPCTL |= USB_OTG_DIEPCTL_SNAK;
+  for (uint32_t i = 0; i < 10000; i++) {
+    if (USB_INEP[ep].DIEPINT & USB_OTG_DIEPINT_INEPNE_Msk) {
+      break;
+    }
+  }
+  USB_INEP[ep].DIEPCTL |= USB_OTG_DIEPCTL_EPDIS;
+  for (uint32_t i = 0; i < 10000; i++) {
+    if (USB_INEP[ep].DIEPINT & USB_OTG_DIEPINT_EPDISD_Msk) {
+      break;
+    }
+  }
+  USB_INT_CLEAR(USB_INEP[ep].DIEPINT,
+                USB_OTG_DIEPINT_INEPNE | USB_OTG_DIEPINT_EPDISD);
+  usb_fifo_flush(ep);
+}
 
-    } else if (pktsts == 0x03) {
-      // SETUP complete
-      USB_OUTEP[0].DOEPTSIZ = (1 << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | 64;
-      USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
-
-    } else if (pktsts == 0x04) {
-      uint32_t bc =
-          (grxstsp & USB_OTG_GRXSTSP_BCNT_Msk) >> USB_OTG_GRXSTSP_BCNT_Pos;
-      if (epnum == 1) {
-        ep1_out_data_cnt++;
-        uint32_t *fifo1 = USB_FIFO(1);
-        for (uint8_t i = 0; i < (bc + 3) / 4; i++) {
-          (void)*fifo1;
-        }
+static void ep_out_disable(uint8_t ep) {
+  if (USB_OUTEP[ep].DOEPCTL & USB_OTG_DOEPCTL_EPENA) {
+    USB_OUTEP[ep].DOEPCTL |= USB_OTG_DOEPCTL_SNAK | USB_OTG_DOEPCTL_EPDIS;
+  }
+}
+
+static void spk_stop(void) {
+  iso_in_missed &= ~(1 << 1);
+  iso_out_missed &= ~(1 << 1);
+  ep_in_disable(1);
+  ep_out_disable(1);
+}
+
+static void spk_start(uint8_t alt) {
+  ep1_format = usb_audio_format(alt);
+  // a new stream may come from a host that follows the feedback
+  playback_set_asrc(0);
+
+  if (ep1_format == NULL) {
+    alt_setting_0_cnt++;
+    return;
+  }
+
+  alt_setting_n_cnt++;
+  USB_INEP[1].DIEPCTL |= USB_OTG_DIEPCTL_USBAEP | EP_TYPE_ISO |
+                         (1 << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+                         (3 << USB_OTG_DIEPCTL_MPSIZ_Pos);
+  ep1_feedback_send();
+  ep1_out_mps = usb_audio_out_mps(ep1_format);
+  USB_OUTEP[1].DOEPCTL = (USB_OUTEP[1].DOEPCTL & ~USB_OTG_DOEPCTL_MPSIZ) |
+                         USB_OTG_DOEPCTL_USBAEP | EP_TYPE_ISO |
+                         (ep1_out_mps << USB_OTG_DOEPCTL_MPSIZ_Pos);
+  ep1_out_arm();
+}
+
+static void mic_stop(void) {
+  iso_in_missed &= ~(1 << 2);
+  ep_in_disable(2);
+}
+
+// the ring is emptied so the stream starts with the lowest latency
+static void mic_start(uint8_t alt) {
+  if (alt == 0) {
+    return;
+  }
+
+  mic_frac = 0;
+  mic_primed = 0;
+  audio_ring_flush(&mic_ring);
+  USB_INEP[2].DIEPCTL = (USB_INEP[2].DIEPCTL & ~USB_OTG_DIEPCTL_MPSIZ) |
+                        USB_OTG_DIEPCTL_USBAEP | EP_TYPE_ISO |
+                        (2 << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+                        (usb_audio_in_mps() << USB_OTG_DIEPCTL_MPSIZ_Pos);
+  ep2_stage();
+  ep2_mic_send();
+}
+
+// the report endpoint is active while configured, DATA0 first
+static void report_start(void) {
+  USB_INEP[USB_REPORT_EP].DIEPCTL =
+      USB_OTG_DIEPCTL_USBAEP | EP_TYPE_INTR | USB_OTG_DIEPCTL_SD0PID_SEVNFRM |
+      (USB_REPORT_EP << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+      (USB_REPORT_MPS << USB_OTG_DIEPCTL_MPSIZ_Pos);
+}
+
+static void report_stop(void) {
+  ep_in_disable(USB_REPORT_EP);
+  USB_INEP[USB_REPORT_EP].DIEPCTL &= ~USB_OTG_DIEPCTL_USBAEP;
+}
+
+// queue a report on the interrupt endpoint. returns 0, dropping it, while
+// not configured or if the host has not read the previous one yet. any
+// priority may call it.
+int usb_report_send(const void *data, uint16_t len) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint32_t ctl = USB_INEP[USB_REPORT_EP].DIEPCTL;
+  if (!(ctl & USB_OTG_DIEPCTL_USBAEP) || (ctl & USB_OTG_DIEPCTL_EPENA) ||
+      len > USB_REPORT_MPS || !usb_fifo_room(USB_REPORT_EP, len)) {
+    __set_PRIMASK(primask);
+    return 0;
+  }
+
+  USB_INEP[USB_REPORT_EP].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | len;
+  USB_INEP[USB_REPORT_EP].DIEPCTL |=
+      USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+  usb_fifo_write(USB_REPORT_EP, data, len);
+
+  __set_PRIMASK(primask);
+  return 1;
+}
+
+// the FIFOs are re-partitioned for every alternate setting. the interface
+// being switched restarts, and so does the other one if its TX FIFO has to
+// move. returns 0, leaving the current settings untouched, if the new
+// layout does not fit.
+static int as_set_alt(uint8_t iface, uint8_t alt) {
+  uint8_t alts[USB_NUM_INTERFACES];
+  usb_fifo_eps_t eps;
+  usb_fifo_plan_t plan;
+
+  if (iface >= USB_NUM_INTERFACES || alt >= num_alts[iface]) {
+    return 0;
+  }
+  for (uint8_t i = 0; i < USB_NUM_INTERFACES; i++) {
+    alts[i] = alt_setting[i];
+  }
+  alts[iface] = alt;
+  as_eps(alts, &eps);
+  if (!usb_fifo_plan(&eps, &plan)) {
+    return 0;
+  }
+
+  // TX FIFO 1 carries the speaker feedback, TX FIFO 2 the mic
+  uint32_t moved = usb_fifo_moved(&plan);
+  uint8_t spk = iface == USB_AS_INTERFACE || (moved & (1 << 1));
+  uint8_t mic = iface == USB_MIC_INTERFACE || (moved & (1 << 2));
+
+  if (spk) {
+    spk_stop();
+  }
+  if (mic) {
+    mic_stop();
+  }
+  // a report in flight is dropped, the endpoint stays active
+  if (moved & (1 << USB_REPORT_EP)) {
+    ep_in_disable(USB_REPORT_EP);
+  }
+  // a TX FIFO that did not flush may still hold packets of the old layout.
+  // the request fails and the streams stopped for it stay stopped.
+  if (!usb_fifo_apply(&plan)) {
+    return 0;
+  }
+  alt_setting[iface] = alt;
+  if (spk) {
+    spk_start(alts[USB_AS_INTERFACE]);
+  }
+  if (mic) {
+    mic_start(alts[USB_MIC_INTERFACE]);
+  }
+
+  return 1;
+}
+
+// re-arm the streaming endpoints for a new packet size. called from a
+// control request, the endpoints and FIFOs are only touched once its
+// status stage is done and the RX FIFO holds nothing for EP0.
+void usb_stream_restart(void) { stream_restart_pending = 1; }
+
+// EP0 OUT always stays armed so back-to-back SETUPs are never NAKed
+static void ep0_out_arm(void) {
+  USB_OUTEP[0].DOEPTSIZ = (3 << USB_OTG_DOEPTSIZ_STUPCNT_Pos) |
+                          (1 << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | EP0_MPS;
+  USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+}
+
+static void ep0_stall(void) {
+  stall_cnt++;
+  ep0_state = EP0_IDLE;
+  USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_STALL;
+  USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_STALL;
+}
+
+static void ep0_status_in(void) {
+  ep0_state = EP0_STATUS_IN;
+  USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos);
+  USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+}
+
+static void ep0_tx_next(void) {
+  uint16_t pkt_len =
+      (ep0_tx_remaining > EP0_MPS) ? EP0_MPS : ep0_tx_remaining;
+
+  if (!usb_fifo_room(0, pkt_len)) {
+    return;
+  }
+
+  USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | pkt_len;
+  USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+  usb_fifo_write(0, ep0_tx_ptr, pkt_len);
+
+  ep0_tx_ptr += pkt_len;
+  ep0_tx_remaining -= pkt_len;
+}
+
+// start the IN data stage of the current control transfer
+void usb_ctrl_send(const void *data, uint16_t len) {
+  if (len > setup.req.wLength) {
+    len = setup.req.wLength;
+  }
+
+  ep0_tx_ptr = data;
+  ep0_tx_remaining = len;
+  // a short transfer that ends on a packet boundary needs a ZLP
+  ep0_tx_zlp = len > 0 && len < setup.req.wLength && (len % EP0_MPS) == 0;
+  ep0_state = EP0_DATA_IN;
+
+  ep0_tx_next();
+}
+
+// start the OUT data stage, done() runs once all data has arrived and
+// decides between status ACK and STALL
+void usb_ctrl_recv(void *buf, uint16_t len, usb_ctrl_handler_t done) {
+  if (len > setup.req.wLength) {
+    len = setup.req.wLength;
+  }
+
+  ep0_rx_ptr = buf;
+  ep0_rx_remaining = len;
+  ep0_rx_done = done;
+  ep0_state = EP0_DATA_OUT;
+}
+
+static void fifo_drain(uint32_t bc) {
+  for (uint32_t i = 0; i < (bc + 3) / 4; i++) {
+    (void)USB_FIFO_READ(0);
+  }
+}
+
+// pop an isochronous packet straight into the audio ring, a window of
+// FIFO words at a time. the window is a whole number of frames of every
+// format, so no frame straddles two windows; the ring wraps on a frame
+// boundary, so a window may be split across the two parts of the span.
+static void ep1_rx_packet(uint32_t bc) {
+  const usb_audio_format_t *fmt = ep1_format;
+  audio_ring_span_t span;
+  uint32_t window[EP1_WINDOW_WORDS];
+
+  if (fmt == NULL) {
+    fifo_drain(bc);
+    return;
+  }
+
+  uint32_t frames = bc / fmt->frame_bytes;
+  uint32_t words = frames * AUDIO_RING_FRAME_WORDS;
+  if (!audio_ring_reserve(&audio_ring, words, &span)) {
+    fifo_drain(bc);
+    return;
+  }
+
+  uint32_t left = (bc + 3) / 4;
+  uint32_t per_window = sizeof(window) / fmt->frame_bytes;
+  uint32_t room = span.len[0] / AUDIO_RING_FRAME_WORDS;
+  uint32_t *dst = span.ptr[0];
+  while (frames > 0) {
+    uint32_t n = frames < per_window ? frames : per_window;
+    uint32_t w = (n * fmt->frame_bytes + 3) / 4;
+    for (uint32_t i = 0; i < w; i++) {
+      window[i] = USB_FIFO_READ(0);
+    }
+    left -= w;
+    frames -= n;
+
+    const uint8_t *src = (const uint8_t *)window;
+    if (n >= room) {
+      fmt->unpack(src, dst, room);
+      src += room * fmt->frame_bytes;
+      n -= room;
+      dst = span.ptr[1];
+      room = span.len[1] / AUDIO_RING_FRAME_WORDS;
+    }
+    fmt->unpack(src, dst, n);
+    dst += n * AUDIO_RING_FRAME_WORDS;
+    room -= n;
+  }
+
+  // a trailing partial frame
+  fifo_drain(left * 4);
+  audio_ring_commit(&audio_ring, words);
+}
+
+static void ep0_rx_packet(uint32_t bc) {
+  if (ep0_state != EP0_DATA_OUT) {
+    fifo_drain(bc);
+    if (ep0_state == EP0_STATUS_OUT) {
+      ep0_state = EP0_IDLE;
+    }
+    return;
+  }
+
+  uint32_t n = (bc > ep0_rx_remaining) ? ep0_rx_remaining : bc;
+  for (uint32_t i = 0; i < (bc + 3) / 4; i++) {
+    uint32_t val = USB_FIFO_READ(0);
+    for (uint8_t b = 0; b < 4; b++) {
+      if (4 * i + b < n) {
+        *ep0_rx_ptr++ = val >> (8 * b);
       }
-      for (uint8_t i = 0; i < (bc + 3) / 4; i++) {
-        (void)*fifo;
+    }
+  }
+  ep0_rx_remaining -= n;
+
+  if (ep0_rx_remaining == 0 || bc < EP0_MPS) {
+    if (ep0_rx_done && ep0_rx_done(&setup.req) != USB_CTRL_OK) {
+      ep0_stall();
+    } else {
+      ep0_status_in();
+    }
+  }
+}
+
+static usb_ctrl_result_t std_get_status(const usb_setup_t *req) {
+  uint8_t recipient = req->bmRequestType & USB_REQ_RECIPIENT_Msk;
+  uint8_t ep = req->wIndex & 0x0f;
+
+  ep0_reply[0] = 0;
+  ep0_reply[1] = 0;
+
+  switch (recipient) {
+  case USB_REQ_RECIPIENT_DEVICE:
+    // self powered
+    ep0_reply[0] = 0x01;
+    break;
+
+  case USB_REQ_RECIPIENT_INTERFACE:
+    if (configuration == 0 || req->wIndex >= USB_NUM_INTERFACES) {
+      return USB_CTRL_STALL;
+    }
+    break;
+
+  case USB_REQ_RECIPIENT_ENDPOINT:
+    if (ep >= USB_NUM_EPS) {
+      return USB_CTRL_STALL;
+    }
+    if (req->wIndex & 0x80) {
+      ep0_reply[0] = (USB_INEP[ep].DIEPCTL & USB_OTG_DIEPCTL_STALL_Msk) != 0;
+    } else {
+      ep0_reply[0] = (USB_OUTEP[ep].DOEPCTL & USB_OTG_DOEPCTL_STALL_Msk) != 0;
+    }
+    break;
+
+  default:
+    return USB_CTRL_STALL;
+  }
+
+  usb_ctrl_send(ep0_reply, 2);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t std_endpoint_halt(const usb_setup_t *req) {
+  uint8_t ep = req->wIndex & 0x0f;
+
+  if ((req->bmRequestType & USB_REQ_RECIPIENT_Msk) !=
+          USB_REQ_RECIPIENT_ENDPOINT ||
+      req->wValue != USB_FEATURE_ENDPOINT_HALT || ep == 0 ||
+      ep >= USB_NUM_EPS) {
+    return USB_CTRL_STALL;
+  }
+
+  if (req->bRequest == USB_REQ_SET_FEATURE) {
+    if (req->wIndex & 0x80) {
+      USB_INEP[ep].DIEPCTL |= USB_OTG_DIEPCTL_STALL;
+    } else {
+      USB_OUTEP[ep].DOEPCTL |= USB_OTG_DOEPCTL_STALL;
+    }
+  } else {
+    if (req->wIndex & 0x80) {
+      USB_INEP[ep].DIEPCTL &= ~USB_OTG_DIEPCTL_STALL;
+      // the data toggle restarts as well
+      if (ep == USB_REPORT_EP) {
+        USB_INEP[ep].DIEPCTL |= USB_OTG_DIEPCTL_SD0PID_SEVNFRM;
       }
-      USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+    } else {
+      USB_OUTEP[ep].DOEPCTL &= ~USB_OTG_DOEPCTL_STALL;
     }
   }
 
-  if (gintsts & USB_OTG_GINTSTS_ENUMDNE_Msk) {
-    USB->GINTSTS = USB_OTG_GINTSTS_ENUMDNE;
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t std_set_address(const usb_setup_t *req) {
+  uint8_t addr = req->wValue & 0x7f;
+
+  // the OTG core expects DAD to be updated before the status stage
+  USB_DEV->DCFG =
+      (USB_DEV->DCFG & ~USB_OTG_DCFG_DAD) | (addr << USB_OTG_DCFG_DAD_Pos);
+
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t std_get_descriptor(const usb_setup_t *req) {
+  uint16_t len;
+  const uint8_t *data =
+      usb_desc_get(req->wValue >> 8, req->wValue & 0xff, &len);
+
+  if (data == NULL) {
+    return USB_CTRL_STALL;
   }
 
-  if (gintsts & USB_OTG_GINTSTS_IEPINT_Msk) {
-    uint32_t diepint = USB_INEP[0].DIEPINT;
+  usb_ctrl_send(data, len);
+  return USB_CTRL_OK;
+}
 
-    if (diepint & USB_OTG_DIEPINT_XFRC_Msk) {
-      USB_INEP[0].DIEPINT = USB_OTG_DIEPINT_XFRC;
+static usb_ctrl_result_t std_get_configuration(const usb_setup_t *req) {
+  ep0_reply[0] = configuration;
+  usb_ctrl_send(ep0_reply, 1);
+  return USB_CTRL_OK;
+}
 
-      if (ep0_tx_remeining > 0) {
-        uint16_t pkt_len = (ep0_tx_remeining > 64) ? 64 : ep0_tx_remeining;
+static usb_ctrl_result_t std_set_configuration(const usb_setup_t *req) {
+  if (req->wValue > 1) {
+    return USB_CTRL_STALL;
+  }
 
-        USB_INEP[0].DIEPTSIZ = (1 << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | pkt_len;
-        USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+  configuration = req->wValue;
+  for (uint8_t i = 0; i < USB_NUM_INTERFACES; i++) {
+    alt_setting[i] = 0;
+  }
+  as_set_alt(USB_AS_INTERFACE, 0);
+  as_set_alt(USB_MIC_INTERFACE, 0);
+  report_stop();
+  if (configuration != 0) {
+    report_start();
+  }
 
-        for (uint8_t i = 0; i < (pkt_len + 3) / 4; i++) {
-          uint32_t val = 0;
-          for (uint8_t b = 0; b < 4; b++) {
-            if (4 * i + b < pkt_len) {
-              val |= ((uint32_t)ep0_tx_ptr[4 * i + b]) << (8 * b);
-            }
-          }
-          uint32_t *fifo = USB_FIFO(0);
-          *fifo = val;
-        }
+  return USB_CTRL_OK;
+}
 
-        ep0_tx_ptr += pkt_len;
-        ep0_tx_remeining -= pkt_len;
+static usb_ctrl_result_t std_get_interface(const usb_setup_t *req) {
+  if (configuration == 0 || req->wIndex >= USB_NUM_INTERFACES) {
+    return USB_CTRL_STALL;
+  }
+
+  ep0_reply[0] = alt_setting[req->wIndex];
+  usb_ctrl_send(ep0_reply, 1);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t std_set_interface(const usb_setup_t *req) {
+  set_interface_cnt++;
+  uint8_t interface_num = req->wIndex & 0xff;
+  uint8_t alt = req->wValue & 0xff;
+
+  if (configuration == 0) {
+    return USB_CTRL_STALL;
+  }
+
+  if ((interface_num == USB_AC_INTERFACE ||
+       interface_num == USB_VENDOR_INTERFACE) &&
+      alt == 0) {
+    return USB_CTRL_OK;
+  }
+
+  if (as_set_alt(interface_num, alt)) {
+    return USB_CTRL_OK;
+  }
+
+  return USB_CTRL_STALL;
+}
+
+static const usb_ctrl_handler_t std_handlers[] = {
+    [USB_REQ_GET_STATUS] = std_get_status,
+    [USB_REQ_CLEAR_FEATURE] = std_endpoint_halt,
+    [USB_REQ_SET_FEATURE] = std_endpoint_halt,
+    [USB_REQ_SET_ADDRESS] = std_set_address,
+    [USB_REQ_GET_DESCRIPTOR] = std_get_descriptor,
+    [USB_REQ_GET_CONFIGURATION] = std_get_configuration,
+    [USB_REQ_SET_CONFIGURATION] = std_set_configuration,
+    [USB_REQ_GET_INTERFACE] = std_get_interface,
+    [USB_REQ_SET_INTERFACE] = std_set_interface,
+};
+
+static usb_ctrl_result_t std_request(const usb_setup_t *req) {
+  if (req->bRequest >= sizeof(std_handlers) / sizeof(std_handlers[0]) ||
+      std_handlers[req->bRequest] == NULL) {
+    return USB_CTRL_STALL;
+  }
+
+  return std_handlers[req->bRequest](req);
+}
+
+// indexed by the type field of bmRequestType
+static const usb_ctrl_handler_t ctrl_handlers[4] = {
+    [USB_REQ_TYPE_STANDARD >> 5] = std_request,
+    [USB_REQ_TYPE_CLASS >> 5] = usb_audio_request,
+    [USB_REQ_TYPE_VENDOR >> 5] = usb_vendor_request,
+};
+
+static void ep0_setup(void) {
+  const usb_setup_t *req = &setup.req;
+  usb_ctrl_handler_t handler =
+      ctrl_handlers[(req->bmRequestType & USB_REQ_TYPE_Msk) >> 5];
+
+  setup_cnt++;
+  // a SETUP ends the transfer before it. IN data or a status ZLP of that
+  // one still queued would go out as the reply to this one.
+  ep_in_disable(0);
+  ep0_state = EP0_IDLE;
+  ep0_tx_remaining = 0;
+  ep0_tx_zlp = 0;
+  ep0_rx_done = NULL;
+
+  if (handler == NULL || handler(req) != USB_CTRL_OK) {
+    ep0_stall();
+    return;
+  }
+
+  if (ep0_state == EP0_IDLE) {
+    if (req->wLength == 0) {
+      ep0_status_in();
+    } else {
+      // handler accepted the request but provided no data stage
+      ep0_stall();
+    }
+  }
+}
+
+static void ep0_in_int(uint32_t diepint) {
+  if (!(diepint & USB_OTG_DIEPINT_XFRC_Msk)) {
+    return;
+  }
+
+  if (ep0_state == EP0_DATA_IN) {
+    if (ep0_tx_remaining > 0) {
+      ep0_tx_next();
+    } else if (ep0_tx_zlp) {
+      ep0_tx_zlp = 0;
+      ep0_tx_next();
+    } else {
+      // host finishes with a zero length OUT, EP0 OUT is already armed
+      ep0_state = EP0_STATUS_OUT;
+    }
+  } else if (ep0_state == EP0_STATUS_IN) {
+    ep0_state = EP0_IDLE;
+    if (stream_restart_pending) {
+      stream_restart_pending = 0;
+      for (uint8_t i = USB_AS_INTERFACE; i < USB_NUM_INTERFACES; i++) {
+        uint8_t alt = alt_setting[i];
+        if (alt != 0 && !as_set_alt(i, alt)) {
+          as_set_alt(i, 0);
+        }
       }
+    }
+  }
+}
+
+// a completed transfer on an endpoint that missed a frame means the
+// re-targeting worked
+static void iso_in_done(uint8_t ep) {
+  if (iso_in_missed & (1 << ep)) {
+    iso_in_missed &= ~(1 << ep);
+    usb_stats.iso_in[ep].recovered_cnt++;
+  }
+}
+
+static void iso_out_done(uint8_t ep) {
+  if (iso_out_missed & (1 << ep)) {
+    iso_out_missed &= ~(1 << ep);
+    usb_stats.iso_out[ep].recovered_cnt++;
+  }
+}
+
+static void ep1_in_int(uint32_t diepint) {
+  if (diepint & USB_OTG_DIEPINT_XFRC_Msk) {
+    ep1_in_xfrc_cnt++;
+    iso_in_done(1);
+    ep1_feedback_send();
+  }
+}
+
+// the next packet is already staged, it only has to be copied out before
+// the following one is prepared
+static void ep2_in_int(uint32_t diepint) {
+  if (diepint & USB_OTG_DIEPINT_XFRC_Msk) {
+    ep2_in_xfrc_cnt++;
+    iso_in_done(2);
+    ep2_mic_send();
+    ep2_stage();
+  }
+}
+
+static void ep1_out_int(uint32_t doepint) {
+  oepint_cnt++;
+
+  if (doepint & USB_OTG_DOEPINT_XFRC_Msk) {
+    ep1_xfrc_cnt++;
+    iso_out_done(1);
+    ep1_out_arm();
+  }
+}
+
+// the core raises the incomplete isochronous interrupts at the end of the
+// periodic frame, for endpoints still enabled for the frame that is ending.
+// flipping their even/odd bit before the next SOF lets the packet already
+// in the TX FIFO, or the next OUT packet, go through one frame later
+// instead of leaving the endpoint deaf until software notices.
+static void iso_in_incomplete(void) {
+  uint32_t odd = usb_frame() & 1;
+
+  for (uint8_t ep = 1; ep < USB_NUM_EPS; ep++) {
+    uint32_t ctl = USB_INEP[ep].DIEPCTL;
+    if ((ctl & (USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_EPTYP)) !=
+            (USB_OTG_DIEPCTL_EPENA | EP_TYPE_ISO) ||
+        ((ctl & EP_EONUM) != 0) != odd) {
+      continue;
+    }
+    usb_stats.iso_in[ep].dropped_cnt++;
+    iso_in_missed |= 1 << ep;
+    USB_INEP[ep].DIEPCTL |= iso_next_frame();
+  }
+}
 
-      // USB_OUTEP[0].DOEPTSIZ = (1 << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | 64;
-      // USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+static void iso_out_incomplete(void) {
+  uint32_t odd = usb_frame() & 1;
+
+  for (uint8_t ep = 1; ep < USB_NUM_EPS; ep++) {
+    uint32_t ctl = USB_OUTEP[ep].DOEPCTL;
+    if ((ctl & (USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_EPTYP)) !=
+            (USB_OTG_DOEPCTL_EPENA | EP_TYPE_ISO) ||
+        ((ctl & EP_EONUM) != 0) != odd) {
+      continue;
     }
+    usb_stats.iso_out[ep].dropped_cnt++;
+    iso_out_missed |= 1 << ep;
+    USB_OUTEP[ep].DOEPCTL |= iso_next_frame();
   }
+}
 
-  if (gintsts & USB_OTG_GINTSTS_OEPINT_Msk) {
-    oepint_cnt++;
-    daint_reg = USB_DEV->DAINT;
-    uint32_t doepint = USB_OUTEP[1].DOEPINT;
+// per-endpoint callbacks. OUT data is popped from the shared RX FIFO by the
+// rx handlers, transfer events arrive through DAINT at the int handlers.
+// EP0 OUT data is handled entirely from the RX FIFO.
+static const ep_rx_handler_t out_rx_handlers[USB_NUM_EPS] = {
+    ep0_rx_packet,
+    ep1_rx_packet,
+    NULL,
+    NULL,
+};
+static const ep_int_handler_t in_handlers[USB_NUM_EPS] = {
+    ep0_in_int,
+    ep1_in_int,
+    ep2_in_int,
+    NULL,
+};
+static const ep_int_handler_t out_handlers[USB_NUM_EPS] = {
+    NULL,
+    ep1_out_int,
+    NULL,
+    NULL,
+};
 
-    if (doepint & USB_OTG_DOEPINT_XFRC_Msk) {
-      ep1_xfrc_cnt++;
-      USB_OUTEP[1].DOEPINT = USB_OTG_DOEPINT_XFRC;
+static void rx_fifo_pop(void) {
+  uint32_t grxstsp = USB_RXSTS_POP();
+  uint8_t pktsts =
+      (grxstsp & USB_OTG_GRXSTSP_PKTSTS_Msk) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
+  uint8_t epnum =
+      (grxstsp & USB_OTG_GRXSTSP_EPNUM_Msk) >> USB_OTG_GRXSTSP_EPNUM_Pos;
+  uint32_t bc =
+      (grxstsp & USB_OTG_GRXSTSP_BCNT_Msk) >> USB_OTG_GRXSTSP_BCNT_Pos;
+
+  if (pktsts == 0x06) {
+    // SETUP packet, processed once the SETUP stage is complete
+    setup.raw[0] = USB_FIFO_READ(0);
+    setup.raw[1] = USB_FIFO_READ(0);
+
+  } else if (pktsts == 0x03) {
+    // OUT transfer complete
+    if (epnum == 0) {
+      ep0_out_arm();
+    }
 
-      USB_OUTEP[1].DOEPTSIZ = (1 << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | 192;
-      USB_OUTEP[1].DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+  } else if (pktsts == 0x02) {
+    // OUT data packet
+    if (epnum < USB_NUM_EPS && out_rx_handlers[epnum]) {
+      out_rx_handlers[epnum](bc);
+    } else {
+      fifo_drain(bc);
     }
 
-    USB->GINTSTS = USB_OTG_GINTSTS_OEPINT;
+  } else if (pktsts == 0x04) {
+    // SETUP transaction complete
+    ep0_out_arm();
+    ep0_setup();
+  }
+}
+
+void OTG_FS_IRQHandler(void) {
+  uint32_t start = USB_CYCCNT();
+  uint32_t gintsts = USB->GINTSTS & USB->GINTMSK;
+
+  usb_stats.irq_cnt++;
+
+  if (gintsts & USB_OTG_GINTSTS_USBRST_Msk) {
+    reset_cnt++;
+    USB_DEV->DCFG &= ~USB_OTG_DCFG_DAD;
+
+    // EP0 MPSIZ = 0 selects 64 bytes
+    USB_INEP[0].DIEPCTL |= USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_CNAK;
+    USB_OUTEP[0].DOEPCTL |= USB_OTG_DOEPCTL_USBAEP | USB_OTG_DOEPCTL_CNAK;
+
+    USB_DEV->DAINTMSK |= (1 << USB_OTG_DAINTMSK_IEPM_Pos) |
+                         (1 << (USB_OTG_DAINTMSK_IEPM_Pos + 1)) |
+                         (1 << (USB_OTG_DAINTMSK_IEPM_Pos + 2)) |
+                         (1 << USB_OTG_DAINTMSK_OEPM_Pos) |
+                         (1 << (USB_OTG_DAINTMSK_OEPM_Pos + 1));
+
+    ep0_state = EP0_IDLE;
+    stream_restart_pending = 0;
+    iso_in_missed = 0;
+    iso_out_missed = 0;
+    configuration = 0;
+    for (uint8_t i = 0; i < USB_NUM_INTERFACES; i++) {
+      alt_setting[i] = 0;
+    }
+    as_set_alt(USB_AS_INTERFACE, 0);
+    as_set_alt(USB_MIC_INTERFACE, 0);
+    report_stop();
+    ep0_out_arm();
+
+    USB_INT_CLEAR(USB->GINTSTS, USB_OTG_GINTSTS_USBRST);
+  }
+
+  if (gintsts & USB_OTG_GINTSTS_RXFLVL_Msk) {
+    // drain everything queued so one interrupt covers the whole frame
+    uint32_t pops = 0;
+    do {
+      rx_fifo_pop();
+      pops++;
+    } while (USB->GINTSTS & USB_OTG_GINTSTS_RXFLVL_Msk);
+
+    usb_stats.rx_pop_cnt += pops;
+    if (pops > usb_stats.rx_pop_max) {
+      usb_stats.rx_pop_max = pops;
+    }
+  }
+
+  if (gintsts & USB_OTG_GINTSTS_ENUMDNE_Msk) {
+    USB_INT_CLEAR(USB->GINTSTS, USB_OTG_GINTSTS_ENUMDNE);
+  }
+
+  if (gintsts & (USB_OTG_GINTSTS_IEPINT_Msk | USB_OTG_GINTSTS_OEPINT_Msk)) {
+    uint32_t daint = USB_DEV->DAINT & USB_DEV->DAINTMSK;
+    daint_reg = daint;
+
+    // highest endpoint first, one CLZ per pending endpoint
+    uint32_t in = daint & USB_OTG_DAINT_IEPINT_Msk;
+    while (in) {
+      uint8_t ep = 31 - __CLZ(in);
+      in &= ~(1u << ep);
+
+      uint32_t diepint = USB_INEP[ep].DIEPINT;
+      USB_INT_CLEAR(USB_INEP[ep].DIEPINT, diepint);
+      if (ep < USB_NUM_EPS && in_handlers[ep]) {
+        in_handlers[ep](diepint & USB_DEV->DIEPMSK);
+      }
+    }
+
+    uint32_t out =
+        (daint & USB_OTG_DAINT_OEPINT_Msk) >> USB_OTG_DAINT_OEPINT_Pos;
+    while (out) {
+      uint8_t ep = 31 - __CLZ(out);
+      out &= ~(1u << ep);
+
+      uint32_t doepint = USB_OUTEP[ep].DOEPINT;
+      USB_INT_CLEAR(USB_OUTEP[ep].DOEPINT, doepint);
+      if (ep < USB_NUM_EPS && out_handlers[ep]) {
+        out_handlers[ep](doepint & USB_DEV->DOEPMSK);
+      }
+    }
+  }
+
+  // after the transfer interrupts, so an endpoint that did complete late
+  // in the frame has already been re-armed
+  if (gintsts & USB_OTG_GINTSTS_IISOIXFR_Msk) {
+    iso_in_incomplete();
+    USB_INT_CLEAR(USB->GINTSTS, USB_OTG_GINTSTS_IISOIXFR);
+  }
+
+  if (gintsts & USB_OTG_GINTSTS_PXFR_INCOMPISOOUT_Msk) {
+    iso_out_incomplete();
+    USB_INT_CLEAR(USB->GINTSTS, USB_OTG_GINTSTS_PXFR_INCOMPISOOUT);
+  }
+
+  uint32_t cycles = USB_CYCCNT() - start;
+  usb_stats.cycles_last = cycles;
+  usb_stats.cycles_total += cycles;
+  if (cycles > usb_stats.cycles_max) {
+    usb_stats.cycles_max = cycles;
   }
+  PROF_RECORD(PROF_USB, cycles);
 }
@@ -0,0 +1,224 @@
+#include "usb_audio.h"
+#include "playback.h"
+#include "usb_desc.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// UAC2 class-specific request codes
+#define UAC2_CUR 0x01
+#define UAC2_RANGE 0x02
+
+// clock source control selectors
+#define UAC2_CS_SAM_FREQ_CONTROL 0x01
+#define UAC2_CS_CLOCK_VALID_CONTROL 0x02
+
+// feature unit control selectors
+#define UAC2_FU_MUTE_CONTROL 0x01
+#define UAC2_FU_VOLUME_CONTROL 0x02
+
+// master channel plus left and right
+#define FU_CHANNELS 3
+
+// one subrange per discrete rate
+#define UAC2_MAX_SUBRANGES 4
+
+// large enough for a 32-bit RANGE block with every subrange
+static uint8_t reply[2 + 12 * UAC2_MAX_SUBRANGES];
+
+// feature unit state by channel number, master first. the master and
+// channel settings add up, as they would in two cascaded stages.
+static uint8_t fu_mute[FU_CHANNELS];
+static int16_t fu_volume[FU_CHANNELS];
+
+static void put_le16(uint8_t *dst, uint16_t val) {
+  dst[0] = val;
+  dst[1] = val >> 8;
+}
+
+static void put_le32(uint8_t *dst, uint32_t val) {
+  dst[0] = val;
+  dst[1] = val >> 8;
+  dst[2] = val >> 16;
+  dst[3] = val >> 24;
+}
+
+// indexed by AS alternate setting, must match the descriptors
+static const usb_audio_format_t formats[USB_AS_NUM_ALTS] = {
+    [1] = {4, audio_unpack_16},
+    [2] = {6, audio_unpack_24_3},
+    [3] = {8, audio_unpack_24_4},
+    [4] = {8, audio_unpack_32},
+};
+
+// NULL for the zero bandwidth setting
+const usb_audio_format_t *usb_audio_format(uint8_t alt) {
+  if (alt >= USB_AS_NUM_ALTS || formats[alt].unpack == NULL) {
+    return NULL;
+  }
+  return &formats[alt];
+}
+
+// largest packet the host may send at the current rate. the nominal
+// frame count is rounded up for 44.1 kHz style rates, whose packets
+// alternate between two sizes, plus one frame for rate matching.
+uint16_t usb_audio_out_mps(const usb_audio_format_t *fmt) {
+  return ((playback_rate() + 999) / 1000 + 1) * fmt->frame_bytes;
+}
+
+// same bound for the mic packets, which run at the rate of the capture
+// clock rather than the host's
+uint16_t usb_audio_in_mps(void) {
+  return ((playback_rate() + 999) / 1000 + 1) * USB_AUDIO_MIC_FRAME_BYTES;
+}
+
+// data stage of SET CUR SAM_FREQ. the request completes at once, the
+// output, mic and feedback follow at the next playback refill.
+static usb_ctrl_result_t clock_set_freq(const usb_setup_t *req) {
+  uint32_t rate = reply[0] | (reply[1] << 8) | (reply[2] << 16) |
+                  ((uint32_t)reply[3] << 24);
+
+  if (rate == playback_rate()) {
+    return USB_CTRL_OK;
+  }
+  if (!playback_set_rate(rate)) {
+    return USB_CTRL_STALL;
+  }
+  usb_stream_restart();
+
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t clock_request(const usb_setup_t *req) {
+  uint8_t cs = req->wValue >> 8;
+
+  // the sampling frequency is the only writable clock control
+  if (!(req->bmRequestType & USB_REQ_DIR_IN)) {
+    if (cs == UAC2_CS_SAM_FREQ_CONTROL && req->bRequest == UAC2_CUR &&
+        req->wLength == 4) {
+      usb_ctrl_recv(reply, 4, clock_set_freq);
+      return USB_CTRL_OK;
+    }
+    return USB_CTRL_STALL;
+  }
+
+  if (cs == UAC2_CS_SAM_FREQ_CONTROL && req->bRequest == UAC2_CUR) {
+    put_le32(reply, playback_rate());
+    usb_ctrl_send(reply, 4);
+    return USB_CTRL_OK;
+  }
+
+  if (cs == UAC2_CS_SAM_FREQ_CONTROL && req->bRequest == UAC2_RANGE) {
+    uint8_t n = 0;
+    uint32_t rate;
+    while (n < UAC2_MAX_SUBRANGES && (rate = playback_rate_at(n)) != 0) {
+      put_le32(&reply[2 + 12 * n], rate); // dMIN
+      put_le32(&reply[6 + 12 * n], rate); // dMAX
+      put_le32(&reply[10 + 12 * n], 0);   // dRES
+      n++;
+    }
+    reply[0] = n; // wNumSubRanges
+    reply[1] = 0;
+    usb_ctrl_send(reply, 2 + 12 * n);
+    return USB_CTRL_OK;
+  }
+
+  if (cs == UAC2_CS_CLOCK_VALID_CONTROL && req->bRequest == UAC2_CUR) {
+    reply[0] = 1;
+    usb_ctrl_send(reply, 1);
+    return USB_CTRL_OK;
+  }
+
+  return USB_CTRL_STALL;
+}
+
+static int16_t clamp_volume(int32_t vol) {
+  if (vol < PLAYBACK_VOLUME_MIN) {
+    return PLAYBACK_VOLUME_MIN;
+  }
+  if (vol > PLAYBACK_VOLUME_MAX) {
+    return PLAYBACK_VOLUME_MAX;
+  }
+  return vol;
+}
+
+// data stage of SET CUR MUTE
+static usb_ctrl_result_t feature_set_mute(const usb_setup_t *req) {
+  fu_mute[req->wValue & 0xff] = reply[0] != 0;
+  playback_set_mute(fu_mute[0] | fu_mute[1], fu_mute[0] | fu_mute[2]);
+  return USB_CTRL_OK;
+}
+
+// data stage of SET CUR VOLUME, out of range values are clamped
+static usb_ctrl_result_t feature_set_volume(const usb_setup_t *req) {
+  int16_t vol = reply[0] | (reply[1] << 8);
+
+  fu_volume[req->wValue & 0xff] = clamp_volume(vol);
+  playback_set_volume(clamp_volume(fu_volume[0] + fu_volume[1]),
+                      clamp_volume(fu_volume[0] + fu_volume[2]));
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t feature_request(const usb_setup_t *req) {
+  uint8_t cs = req->wValue >> 8;
+  uint8_t cn = req->wValue & 0xff;
+
+  if (cn >= FU_CHANNELS) {
+    return USB_CTRL_STALL;
+  }
+
+  if (!(req->bmRequestType & USB_REQ_DIR_IN)) {
+    if (req->bRequest != UAC2_CUR) {
+      return USB_CTRL_STALL;
+    }
+    if (cs == UAC2_FU_MUTE_CONTROL && req->wLength == 1) {
+      usb_ctrl_recv(reply, 1, feature_set_mute);
+      return USB_CTRL_OK;
+    }
+    if (cs == UAC2_FU_VOLUME_CONTROL && req->wLength == 2) {
+      usb_ctrl_recv(reply, 2, feature_set_volume);
+      return USB_CTRL_OK;
+    }
+    return USB_CTRL_STALL;
+  }
+
+  if (cs == UAC2_FU_MUTE_CONTROL && req->bRequest == UAC2_CUR) {
+    reply[0] = fu_mute[cn];
+    usb_ctrl_send(reply, 1);
+    return USB_CTRL_OK;
+  }
+
+  if (cs == UAC2_FU_VOLUME_CONTROL && req->bRequest == UAC2_CUR) {
+    put_le16(reply, fu_volume[cn]);
+    usb_ctrl_send(reply, 2);
+    return USB_CTRL_OK;
+  }
+
+  if (cs == UAC2_FU_VOLUME_CONTROL && req->bRequest == UAC2_RANGE) {
+    put_le16(&reply[0], 1); // wNumSubRanges
+    put_le16(&reply[2], PLAYBACK_VOLUME_MIN);
+    put_le16(&reply[4], PLAYBACK_VOLUME_MAX);
+    put_le16(&reply[6], PLAYBACK_VOLUME_RES);
+    usb_ctrl_send(reply, 8);
+    return USB_CTRL_OK;
+  }
+
+  return USB_CTRL_STALL;
+}
+
+// class requests addressed to an entity of the audio control interface
+usb_ctrl_result_t usb_audio_request(const usb_setup_t *req) {
+  if ((req->bmRequestType & USB_REQ_RECIPIENT_Msk) !=
+          USB_REQ_RECIPIENT_INTERFACE ||
+      (req->wIndex & 0xff) != USB_AC_INTERFACE) {
+    return USB_CTRL_STALL;
+  }
+
+  switch (req->wIndex >> 8) {
+  case USB_AUDIO_CLOCK_ID:
+    return clock_request(req);
+  case USB_AUDIO_FU_ID:
+    return feature_request(req);
+  }
+
+  return USB_CTRL_STALL;
+}
@@ -0,0 +1,493 @@
+#include "usb_desc.h"
+#include <stddef.h>
+
+static const uint8_t device_descriptor[] = {
+    0x12, // bLength
+    0x01, // bDescriptorType
+    0x00,
+    0x02,       // bcdUSB
+    0xef,       // bDeviceClass
+    0x02,       // bDeviceSubClass
+    0x01,       // bDeviceProtocol
+    0x40,       // bMaxPacketSize0
+    0x00, 0x00, // idVendor
+    0x00, 0x00, // idProduct
+    0x00, 0x00, // bcdDevice
+    0x01,       // iManufacture
+    0x02,       // iProduct
+    0x00,       // iSerialNumber
+    0x01        // bNumConfigurations
+};
+
+static const uint8_t config_descriptor[] = {
+    // standard configuration descriptor
+    0x09,       // bLength
+    0x02,       // bDescriptorType
+    0x9b, 0x01, // wTotalLength
+    0x04,       // bNumInterfaces
+    0x01,       // bConfigurationValue
+    0x00,       // iConfiguration
+    0xc0,       // bmAttributes
+    50,         // bMaxPower
+                //
+
+    // IAD
+    0x08, // bLength
+    0x0b, // bDescriptorType
+    0x00, // bFirstInterface
+    0x03, // bInterfaceCount
+    0x01, // bFunctionClass
+    0x00, // bFunctionSubClass
+    0x20, // bFunctionProtocol
+    0x00, // iFunction
+
+    // standard AC interface descriptor (interface 0)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x00, // bInterfaceNubmer
+    0x00, // bAlternateSetting
+    0x00, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x01, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // class specific AC interface descriptor
+    0x09,       // bLength
+    0x24,       // bDescriptorType
+    0x01,       // bDescriptorSubType
+    0x00, 0x02, // bcdADC
+    0x01,       // bCategory
+    0x5d, 0x00, // wTotalLength
+    0x00,       // bmControls
+
+    // clock source descriptor
+    0x08, // bLength
+    0x24, // bDescripterType
+    0x0a, // bDescriptorSubtype
+    0x10, // bClockID
+    0x03, // bmAttributes (internal programmable clock)
+    0x07, // bmControls (frequency programmable, validity read-only)
+    0x00, // bAssocTerminal
+    0x00, // iCockSource
+
+    // input terminal descriptor
+    0x11,                   // bLength
+    0x24,                   // bDescriptorType
+    0x02,                   // bDescriptorSubType
+    0x01,                   // bTerminalID
+    0x01, 0x01,             // wTerminalType
+    0x00,                   // bAssocTerminal
+    0x10,                   // bCSourceID
+    0x02,                   // bNrChannels
+    0x03, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+    0x00, 0x00,             // bmControls
+    0x00,                   // iTerminal
+
+    // feature unit descriptor, mute and volume programmable on the master
+    // channel and on each of the two channels
+    0x12,                   // bLength
+    0x24,                   // bDescriptorType
+    0x06,                   // bDescriptorSubType
+    0x03,                   // bUnitID
+    0x01,                   // bSourceID
+    0x0f, 0x00, 0x00, 0x00, // bmaControls(0)
+    0x0f, 0x00, 0x00, 0x00, // bmaControls(1)
+    0x0f, 0x00, 0x00, 0x00, // bmaControls(2)
+    0x00,                   // iFeature
+
+    // output terminal descriptor
+    0x0c,       // bLength
+    0x24,       // bDescriptorType
+    0x03,       // bDescriptorSubType
+    0x02,       // bTerminalID
+    0x01, 0x03, // wTerminalType
+    0x00,       // bAssocTerminal
+    0x03,       // bSourceID
+    0x10,       // bCSourceID
+    0x00, 0x00, // bmControls
+    0x00,       // iTerminal
+
+    // input terminal descriptor (microphone)
+    0x11,                   // bLength
+    0x24,                   // bDescriptorType
+    0x02,                   // bDescriptorSubType
+    0x04,                   // bTerminalID
+    0x01, 0x02,             // wTerminalType
+    0x00,                   // bAssocTerminal
+    0x10,                   // bCSourceID
+    0x01,                   // bNrChannels
+    0x00, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+    0x00, 0x00,             // bmControls
+    0x00,                   // iTerminal
+
+    // output terminal descriptor (USB streaming)
+    0x0c,       // bLength
+    0x24,       // bDescriptorType
+    0x03,       // bDescriptorSubType
+    0x05,       // bTerminalID
+    0x01, 0x01, // wTerminalType
+    0x00,       // bAssocTerminal
+    0x04,       // bSourceID
+    0x10,       // bCSourceID
+    0x00, 0x00, // bmControls
+    0x00,       // iTerminal
+
+    // standard AS interface descriptor (interface 1, alt 0)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x01, // bInterfaceNumber
+    0x00, // bAlternateSetting
+    0x00, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // standard AS interface descriptor (interface 1, alt 1, 16-bit)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x01, // bInterfaceNumber
+    0x01, // bAlternateSetting
+    0x02, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // class-specific AS interface descriptor
+    0x10,                   // bLength
+    0x24,                   // bDescriptorType
+    0x01,                   // bDescriptorSubType
+    0x01,                   // bTerminalLink
+    0x00,                   // bmControls
+    0x01,                   // bFormatType
+    0x01, 0x00, 0x00, 0x00, // bmFormats
+    0x02,                   // bNrChannels
+    0x03, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+
+    // type I format type descriptor, rates come from the clock source
+    0x06, // bLength
+    0x24, // bDescriptorType
+    0x02, // bDescriptorSubType
+    0x01, // bFormatType
+    0x02, // bSubslotSize
+    0x10, // bBitResolution
+
+    // standard isochronous endpoint descriptor
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x01,       // bEndpointAddress
+    0x05,       // bmAttributes
+    0x84, 0x01, // wMaxPacketSize (97 frames at 96 kHz)
+    0x01,       // bInterval
+
+    // class-specific endpoint descriptor
+    0x08,      // bLength
+    0x25,      // bDescriptorType
+    0x01,      // bDescriptorSubType
+    0x00,      // bmAttributes
+    0x00,      // bmControls
+    0x00,      // bLockDelayUnits
+    0x00, 0x00, // wLockDelay
+
+    // feedback endpoint descriptor (10.14 samples per frame)
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x81,       // bEndpointAddress
+    0x11,       // bmAttributes
+    0x03, 0x00, // wMaxPacketSize
+    0x01,       // bInterval
+    // standard AS interface descriptor (interface 1, alt 2, 24-in-3)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x01, // bInterfaceNumber
+    0x02, // bAlternateSetting
+    0x02, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // class-specific AS interface descriptor
+    0x10,                   // bLength
+    0x24,                   // bDescriptorType
+    0x01,                   // bDescriptorSubType
+    0x01,                   // bTerminalLink
+    0x00,                   // bmControls
+    0x01,                   // bFormatType
+    0x01, 0x00, 0x00, 0x00, // bmFormats
+    0x02,                   // bNrChannels
+    0x03, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+
+    // type I format type descriptor
+    0x06, // bLength
+    0x24, // bDescriptorType
+    0x02, // bDescriptorSubType
+    0x01, // bFormatType
+    0x03, // bSubslotSize
+    0x18, // bBitResolution
+
+    // standard isochronous endpoint descriptor
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x01,       // bEndpointAddress
+    0x05,       // bmAttributes
+    0x46, 0x02, // wMaxPacketSize (97 frames at 96 kHz)
+    0x01,       // bInterval
+
+    // class-specific endpoint descriptor
+    0x08,      // bLength
+    0x25,      // bDescriptorType
+    0x01,      // bDescriptorSubType
+    0x00,      // bmAttributes
+    0x00,      // bmControls
+    0x00,      // bLockDelayUnits
+    0x00, 0x00, // wLockDelay
+
+    // feedback endpoint descriptor (10.14 samples per frame)
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x81,       // bEndpointAddress
+    0x11,       // bmAttributes
+    0x03, 0x00, // wMaxPacketSize
+    0x01,       // bInterval
+    // standard AS interface descriptor (interface 1, alt 3, 24-in-4)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x01, // bInterfaceNumber
+    0x03, // bAlternateSetting
+    0x02, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // class-specific AS interface descriptor
+    0x10,                   // bLength
+    0x24,                   // bDescriptorType
+    0x01,                   // bDescriptorSubType
+    0x01,                   // bTerminalLink
+    0x00,                   // bmControls
+    0x01,                   // bFormatType
+    0x01, 0x00, 0x00, 0x00, // bmFormats
+    0x02,                   // bNrChannels
+    0x03, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+
+    // type I format type descriptor
+    0x06, // bLength
+    0x24, // bDescriptorType
+    0x02, // bDescriptorSubType
+    0x01, // bFormatType
+    0x04, // bSubslotSize
+    0x18, // bBitResolution
+
+    // standard isochronous endpoint descriptor
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x01,       // bEndpointAddress
+    0x05,       // bmAttributes
+    0x08, 0x03, // wMaxPacketSize (97 frames at 96 kHz)
+    0x01,       // bInterval
+
+    // class-specific endpoint descriptor
+    0x08,      // bLength
+    0x25,      // bDescriptorType
+    0x01,      // bDescriptorSubType
+    0x00,      // bmAttributes
+    0x00,      // bmControls
+    0x00,      // bLockDelayUnits
+    0x00, 0x00, // wLockDelay
+
+    // feedback endpoint descriptor (10.14 samples per frame)
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x81,       // bEndpointAddress
+    0x11,       // bmAttributes
+    0x03, 0x00, // wMaxPacketSize
+    0x01,       // bInterval
+    // standard AS interface descriptor (interface 1, alt 4, 32-bit)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x01, // bInterfaceNumber
+    0x04, // bAlternateSetting
+    0x02, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // class-specific AS interface descriptor
+    0x10,                   // bLength
+    0x24,                   // bDescriptorType
+    0x01,                   // bDescriptorSubType
+    0x01,                   // bTerminalLink
+    0x00,                   // bmControls
+    0x01,                   // bFormatType
+    0x01, 0x00, 0x00, 0x00, // bmFormats
+    0x02,                   // bNrChannels
+    0x03, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+
+    // type I format type descriptor
+    0x06, // bLength
+    0x24, // bDescriptorType
+    0x02, // bDescriptorSubType
+    0x01, // bFormatType
+    0x04, // bSubslotSize
+    0x20, // bBitResolution
+
+    // standard isochronous endpoint descriptor
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x01,       // bEndpointAddress
+    0x05,       // bmAttributes
+    0x08, 0x03, // wMaxPacketSize (97 frames at 96 kHz)
+    0x01,       // bInterval
+
+    // class-specific endpoint descriptor
+    0x08,      // bLength
+    0x25,      // bDescriptorType
+    0x01,      // bDescriptorSubType
+    0x00,      // bmAttributes
+    0x00,      // bmControls
+    0x00,      // bLockDelayUnits
+    0x00, 0x00, // wLockDelay
+
+    // feedback endpoint descriptor (10.14 samples per frame)
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x81,       // bEndpointAddress
+    0x11,       // bmAttributes
+    0x03, 0x00, // wMaxPacketSize
+    0x01,       // bInterval
+
+    // standard AS interface descriptor (interface 2, alt 0)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x02, // bInterfaceNumber
+    0x00, // bAlternateSetting
+    0x00, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // standard AS interface descriptor (interface 2, alt 1, 16-bit mono)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x02, // bInterfaceNumber
+    0x01, // bAlternateSetting
+    0x01, // bNumEndpoints
+    0x01, // bInterfaceClass
+    0x02, // bInterfaceSubClass
+    0x20, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // class-specific AS interface descriptor
+    0x10,                   // bLength
+    0x24,                   // bDescriptorType
+    0x01,                   // bDescriptorSubType
+    0x05,                   // bTerminalLink
+    0x00,                   // bmControls
+    0x01,                   // bFormatType
+    0x01, 0x00, 0x00, 0x00, // bmFormats
+    0x01,                   // bNrChannels
+    0x00, 0x00, 0x00, 0x00, // bmChannelConfig
+    0x00,                   // iChannelNames
+
+    // type I format type descriptor
+    0x06, // bLength
+    0x24, // bDescriptorType
+    0x02, // bDescriptorSubType
+    0x01, // bFormatType
+    0x02, // bSubslotSize
+    0x10, // bBitResolution
+
+    // standard isochronous endpoint descriptor, asynchronous
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x82,       // bEndpointAddress
+    0x05,       // bmAttributes
+    0xc2, 0x00, // wMaxPacketSize (97 frames at 96 kHz)
+    0x01,       // bInterval
+
+    // class-specific endpoint descriptor
+    0x08,       // bLength
+    0x25,       // bDescriptorType
+    0x01,       // bDescriptorSubType
+    0x00,       // bmAttributes
+    0x00,       // bmControls
+    0x00,       // bLockDelayUnits
+    0x00, 0x00, // wLockDelay
+
+    // standard interface descriptor (interface 3, vendor specific)
+    0x09, // bLength
+    0x04, // bDescriptorType
+    0x03, // bInterfaceNumber
+    0x00, // bAlternateSetting
+    0x01, // bNumEndpoints
+    0xff, // bInterfaceClass
+    0x00, // bInterfaceSubClass
+    0x00, // bInterfaceProtocol
+    0x00, // iInterface
+
+    // interrupt endpoint descriptor, reports to the host
+    0x07,       // bLength
+    0x05,       // bDescriptorType
+    0x83,       // bEndpointAddress
+    0x03,       // bmAttributes
+    0x40, 0x00, // wMaxPacketSize
+    0x01,       // bInterval
+};
+
+// String Descriptors も追加
+static const uint8_t string_descriptor_0[] = {
+    0x04, 0x03, 0x09, 0x04 // Language ID: English (US)
+};
+
+static const uint8_t string_descriptor_1[] = {
+    0x1A, 0x03, // bLength, bDescriptorType
+    'S',  0,    'T', 0, 'M', 0, 'i', 0, 'c', 0, 'r', 0,
+    'o',  0,    'e', 0, 'l', 0, 'e', 0, 'c', 0, 't', 0};
+
+static const uint8_t string_descriptor_2[] = {
+    0x22, 0x03, // bLength (34 bytes), bDescriptorType (STRING)
+    'U',  0,    'S', 0, 'B', 0, ' ', 0, 'A', 0, 'u', 0, 'd', 0, 'i', 0,
+    'o',  0,    ' ', 0, 'D', 0, 'e', 0, 'v', 0, 'i', 0, 'c', 0, 'e', 0};
+
+const uint8_t *usb_desc_get(uint8_t type, uint8_t index, uint16_t *len) {
+  switch (type) {
+  case USB_DESC_DEVICE:
+    *len = sizeof(device_descriptor);
+    return device_descriptor;
+
+  case USB_DESC_CONFIGURATION:
+    *len = sizeof(config_descriptor);
+    return config_descriptor;
+
+  case USB_DESC_STRING:
+    switch (index) {
+    case 0:
+      *len = sizeof(string_descriptor_0);
+      return string_descriptor_0;
+
+    case 1:
+      *len = sizeof(string_descriptor_1);
+      return string_descriptor_1;
+
+    case 2:
+      *len = sizeof(string_descriptor_2);
+      return string_descriptor_2;
+    }
+    break;
+  }
+
+  *len = 0;
+  return NULL;
+}
@@ -0,0 +1,187 @@
+#include "usb_fifo.h"
+#include "usb_regs.h"
+
+#define WORDS(bytes) (((uint32_t)(bytes) + 3) / 4)
+
+// AHB idle and flush done polls, bounded so a core that never
+// acknowledges can not hang the interrupt
+#define FLUSH_WAIT_LOOPS 10000
+
+// for debug
+static volatile uint32_t plan_fail_cnt = 0;
+static volatile uint32_t tx_flush_cnt = 0;
+static volatile uint32_t flush_timeout_cnt = 0;
+static volatile uint32_t tx_fifo_full_cnt = 0;
+
+// split the FIFO RAM between the endpoints in use. every endpoint first
+// gets room for one packet, the RX FIFO sized after RM0383: 13 words for
+// SETUP packets, one status word per packet, two per OUT endpoint for
+// transfer complete and one for global NAK. what is left goes to a second
+// isochronous packet, RX first as OUT data can not be NAKed, then the IN
+// endpoints in order. the TX FIFOs are stacked down from the top of the
+// RAM, EP0 highest, so resizing the RX FIFO never moves them.
+// returns 0 if even the single packet layout does not fit.
+int usb_fifo_plan(const usb_fifo_eps_t *eps, usb_fifo_plan_t *plan) {
+  uint32_t rx_pkt = WORDS(eps->out_mps) + 1;
+  uint32_t rx = 13 + rx_pkt + 2 * USB_NUM_EPS + 1;
+  uint32_t used = rx;
+
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    uint32_t words = 0;
+    if (ep == 0 || eps->in_mps[ep] != 0) {
+      words = WORDS(eps->in_mps[ep]);
+      if (words < USB_FIFO_TX_MIN) {
+        words = USB_FIFO_TX_MIN;
+      }
+    }
+    plan->tx_words[ep] = words;
+    used += words;
+  }
+
+  if (used > USB_FIFO_WORDS) {
+    plan_fail_cnt++;
+    return 0;
+  }
+
+  if (used + rx_pkt <= USB_FIFO_WORDS) {
+    rx += rx_pkt;
+    used += rx_pkt;
+  }
+  for (uint8_t ep = 1; ep < USB_NUM_EPS; ep++) {
+    uint32_t pkt = WORDS(eps->in_mps[ep]);
+    if (pkt != 0 && plan->tx_words[ep] < 2 * pkt &&
+        used + pkt <= USB_FIFO_WORDS) {
+      plan->tx_words[ep] += pkt;
+      used += pkt;
+    }
+  }
+
+  plan->rx_words = rx;
+  uint32_t offset = USB_FIFO_WORDS;
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    offset -= plan->tx_words[ep];
+    plan->tx_offset[ep] = offset;
+  }
+
+  return 1;
+}
+
+static uint32_t txf_value(const usb_fifo_plan_t *plan, uint8_t ep) {
+  return (plan->tx_words[ep] << USB_OTG_DIEPTXF_INEPTXFD_Pos) |
+         plan->tx_offset[ep];
+}
+
+static volatile uint32_t *txf_reg(uint8_t ep) {
+  return (ep == 0) ? &USB->DIEPTXF0_HNPTXFSIZ : &USB->DIEPTXF[ep - 1];
+}
+
+// IN endpoints, one bit each, whose TX FIFO the plan would move or resize
+uint32_t usb_fifo_moved(const usb_fifo_plan_t *plan) {
+  uint32_t moved = 0;
+
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    if (plan->tx_words[ep] != 0 && *txf_reg(ep) != txf_value(plan, ep)) {
+      moved |= 1 << ep;
+    }
+  }
+  return moved;
+}
+
+static int grstctl_wait(uint32_t mask, uint32_t value) {
+  for (uint32_t i = 0; i < FLUSH_WAIT_LOOPS; i++) {
+    if ((USB->GRSTCTL & mask) == value) {
+      return 1;
+    }
+  }
+  flush_timeout_cnt++;
+  return 0;
+}
+
+// drop whatever a disabled IN endpoint left in its TX FIFO. returns 0 if
+// the core did not get there, the FIFO may then still hold old data.
+int usb_fifo_flush(uint8_t num) {
+  tx_flush_cnt++;
+  if (!grstctl_wait(USB_OTG_GRSTCTL_AHBIDL_Msk, USB_OTG_GRSTCTL_AHBIDL_Msk)) {
+    return 0;
+  }
+  USB->GRSTCTL = USB_OTG_GRSTCTL_TXFFLSH | (num << USB_OTG_GRSTCTL_TXFNUM_Pos);
+  return grstctl_wait(USB_OTG_GRSTCTL_TXFFLSH_Msk, 0);
+}
+
+// program the partitions. TX FIFOs that move are flushed, their endpoints
+// must not be transmitting. the RX FIFO is only resized between packets,
+// which holds while a SETUP is being handled. returns 0 if a flush did not
+// complete.
+int usb_fifo_apply(const usb_fifo_plan_t *plan) {
+  int ok = 1;
+
+  USB->GRXFSIZ = plan->rx_words;
+
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    if (plan->tx_words[ep] == 0) {
+      continue;
+    }
+
+    uint32_t txf = txf_value(plan, ep);
+    volatile uint32_t *reg = txf_reg(ep);
+    if (*reg != txf) {
+      *reg = txf;
+      if (!usb_fifo_flush(ep)) {
+        ok = 0;
+      }
+    }
+  }
+  return ok;
+}
+
+// check that the TX FIFO of an IN endpoint can take a whole packet before
+// the endpoint is armed for it
+int usb_fifo_room(uint8_t ep, uint16_t len) {
+  uint32_t avail = USB_INEP[ep].DTXFSTS & USB_OTG_DTXFSTS_INEPTFSAV_Msk;
+
+  if (avail < (len + 3u) / 4) {
+    tx_fifo_full_cnt++;
+    return 0;
+  }
+  return 1;
+}
+
+// shared TX FIFO write for every IN endpoint. aligned sources are pushed
+// with unrolled word loads, unaligned ones with LDR which the M4 allows on
+// normal memory. only the last partial word is assembled bytewise.
+void usb_fifo_write(uint8_t ep, const uint8_t *src, uint16_t len) {
+  uint32_t words = len / 4;
+
+  if (((uint32_t)src & 3) == 0) {
+    const uint32_t *p = (const uint32_t *)src;
+
+    for (; words >= 4; words -= 4) {
+      USB_FIFO_WRITE(ep, p[0]);
+      USB_FIFO_WRITE(ep, p[1]);
+      USB_FIFO_WRITE(ep, p[2]);
+      USB_FIFO_WRITE(ep, p[3]);
+      p += 4;
+    }
+    for (; words > 0; words--) {
+      USB_FIFO_WRITE(ep, *p++);
+    }
+    src = (const uint8_t *)p;
+  } else {
+    for (; words > 0; words--) {
+      USB_FIFO_WRITE(ep, __UNALIGNED_UINT32_READ(src));
+      src += 4;
+    }
+  }
+
+  switch (len & 3) {
+  case 3:
+    USB_FIFO_WRITE(ep, src[0] | (src[1] << 8) | (src[2] << 16));
+    break;
+  case 2:
+    USB_FIFO_WRITE(ep, src[0] | (src[1] << 8));
+    break;
+  case 1:
+    USB_FIFO_WRITE(ep, src[0]);
+    break;
+  }
+}
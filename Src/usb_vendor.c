@@ -0,0 +1,248 @@
+#include "usb_vendor.h"
+#include "conv.h"
+#include "deadline.h"
+#include "dyn.h"
+#include "graph.h"
+#include "load.h"
+#include "peq.h"
+#include "playback.h"
+#include "prof.h"
+#include "spectrum.h"
+#include <stddef.h>
+
+// data stage of the largest request
+#define VENDOR_BUF_LEN (USB_VENDOR_CONV_CHUNK * sizeof(float))
+
+static uint8_t vendor_buf[VENDOR_BUF_LEN] __attribute__((aligned(4)));
+
+static usb_ctrl_result_t vendor_asrc(const usb_setup_t *req) {
+  if (req->bmRequestType & USB_REQ_DIR_IN) {
+    if (req->wLength != 1) {
+      return USB_CTRL_STALL;
+    }
+    vendor_buf[0] = playback_asrc();
+    usb_ctrl_send(vendor_buf, 1);
+    return USB_CTRL_OK;
+  }
+
+  if (req->wLength != 0 || req->wValue > 1) {
+    return USB_CTRL_STALL;
+  }
+  playback_set_asrc(req->wValue);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_peq_done(const usb_setup_t *req) {
+  return peq_set_bands(req->wIndex, req->wLength / sizeof(peq_band_t),
+                       (const peq_band_t *)vendor_buf)
+             ? USB_CTRL_OK
+             : USB_CTRL_STALL;
+}
+
+static usb_ctrl_result_t vendor_peq(const usb_setup_t *req) {
+  uint16_t count = req->wLength / sizeof(peq_band_t);
+
+  if (count == 0 || req->wLength % sizeof(peq_band_t) != 0 ||
+      req->wIndex >= PEQ_MAX_BANDS || count > PEQ_MAX_BANDS - req->wIndex) {
+    return USB_CTRL_STALL;
+  }
+
+  if (req->bmRequestType & USB_REQ_DIR_IN) {
+    peq_get_bands(req->wIndex, count, (peq_band_t *)vendor_buf);
+    usb_ctrl_send(vendor_buf, req->wLength);
+  } else {
+    usb_ctrl_recv(vendor_buf, req->wLength, vendor_peq_done);
+  }
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_conv_setup(const usb_setup_t *req) {
+  if (req->wLength != 0 || !conv_setup(req->wValue, req->wIndex)) {
+    return USB_CTRL_STALL;
+  }
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_conv_ir_done(const usb_setup_t *req) {
+  return conv_load(req->wValue, req->wIndex, req->wLength / sizeof(float),
+                   (const float *)vendor_buf)
+             ? USB_CTRL_OK
+             : USB_CTRL_STALL;
+}
+
+static usb_ctrl_result_t vendor_conv_ir(const usb_setup_t *req) {
+  if ((req->bmRequestType & USB_REQ_DIR_IN) || req->wLength == 0 ||
+      req->wLength > VENDOR_BUF_LEN || req->wLength % sizeof(float) != 0) {
+    return USB_CTRL_STALL;
+  }
+
+  usb_ctrl_recv(vendor_buf, req->wLength, vendor_conv_ir_done);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_conv_enable(const usb_setup_t *req) {
+  if (req->wLength != 0 || !conv_enable(req->wValue != 0)) {
+    return USB_CTRL_STALL;
+  }
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_dyn_done(const usb_setup_t *req) {
+  return dyn_set_params((const dyn_params_t *)vendor_buf) ? USB_CTRL_OK
+                                                          : USB_CTRL_STALL;
+}
+
+static usb_ctrl_result_t vendor_dyn(const usb_setup_t *req) {
+  if (req->wLength != sizeof(dyn_params_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  if (req->bmRequestType & USB_REQ_DIR_IN) {
+    dyn_get_params((dyn_params_t *)vendor_buf);
+    usb_ctrl_send(vendor_buf, req->wLength);
+  } else {
+    usb_ctrl_recv(vendor_buf, req->wLength, vendor_dyn_done);
+  }
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_dyn_meter(const usb_setup_t *req) {
+  if (!(req->bmRequestType & USB_REQ_DIR_IN) ||
+      req->wLength != sizeof(dyn_meter_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  dyn_read_meter((dyn_meter_t *)vendor_buf);
+  usb_ctrl_send(vendor_buf, req->wLength);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_spectrum_done(const usb_setup_t *req) {
+  return spectrum_set_config((const spectrum_config_t *)vendor_buf)
+             ? USB_CTRL_OK
+             : USB_CTRL_STALL;
+}
+
+static usb_ctrl_result_t vendor_spectrum(const usb_setup_t *req) {
+  if (req->wLength != sizeof(spectrum_config_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  if (req->bmRequestType & USB_REQ_DIR_IN) {
+    spectrum_get_config((spectrum_config_t *)vendor_buf);
+    usb_ctrl_send(vendor_buf, req->wLength);
+  } else {
+    usb_ctrl_recv(vendor_buf, req->wLength, vendor_spectrum_done);
+  }
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_spectrum_stats(const usb_setup_t *req) {
+  if (!(req->bmRequestType & USB_REQ_DIR_IN) ||
+      req->wLength != sizeof(spectrum_stats_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  spectrum_stats_t *stats = (spectrum_stats_t *)vendor_buf;
+  *stats = spectrum_stats;
+  usb_ctrl_send(vendor_buf, req->wLength);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_graph_done(const usb_setup_t *req) {
+  return graph_set_nodes(req->wLength / sizeof(graph_node_t),
+                         (const graph_node_t *)vendor_buf)
+             ? USB_CTRL_OK
+             : USB_CTRL_STALL;
+}
+
+static usb_ctrl_result_t vendor_graph(const usb_setup_t *req) {
+  if (req->bmRequestType & USB_REQ_DIR_IN) {
+    uint8_t count = graph_get_nodes((graph_node_t *)vendor_buf);
+    usb_ctrl_send(vendor_buf, count * sizeof(graph_node_t));
+    return USB_CTRL_OK;
+  }
+
+  if (req->wLength % sizeof(graph_node_t) != 0 ||
+      req->wLength > GRAPH_MAX_NODES * sizeof(graph_node_t)) {
+    return USB_CTRL_STALL;
+  }
+  if (req->wLength == 0) {
+    return graph_set_nodes(0, NULL) ? USB_CTRL_OK : USB_CTRL_STALL;
+  }
+  usb_ctrl_recv(vendor_buf, req->wLength, vendor_graph_done);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_graph_meter(const usb_setup_t *req) {
+  if (!(req->bmRequestType & USB_REQ_DIR_IN) ||
+      req->wLength != GRAPH_MAX_NODES * sizeof(int16_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  graph_read_meters((int16_t *)vendor_buf);
+  usb_ctrl_send(vendor_buf, req->wLength);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_prof(const usb_setup_t *req) {
+  if (!(req->bmRequestType & USB_REQ_DIR_IN) ||
+      req->wLength != sizeof(prof_stats_t) || req->wIndex > UINT8_MAX ||
+      !prof_read(req->wIndex, (prof_stats_t *)vendor_buf, req->wValue == 1)) {
+    return USB_CTRL_STALL;
+  }
+
+  usb_ctrl_send(vendor_buf, req->wLength);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_load(const usb_setup_t *req) {
+  if (!(req->bmRequestType & USB_REQ_DIR_IN) ||
+      req->wLength != sizeof(load_stats_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  load_stats_t *stats = (load_stats_t *)vendor_buf;
+  *stats = load_stats;
+  usb_ctrl_send(vendor_buf, req->wLength);
+  return USB_CTRL_OK;
+}
+
+static usb_ctrl_result_t vendor_deadline(const usb_setup_t *req) {
+  if (!(req->bmRequestType & USB_REQ_DIR_IN) ||
+      req->wLength != sizeof(deadline_stats_t)) {
+    return USB_CTRL_STALL;
+  }
+
+  deadline_read((deadline_stats_t *)vendor_buf);
+  usb_ctrl_send(vendor_buf, req->wLength);
+  return USB_CTRL_OK;
+}
+
+static const usb_ctrl_handler_t vendor_handlers[] = {
+    [USB_VENDOR_ASRC] = vendor_asrc,
+    [USB_VENDOR_PEQ] = vendor_peq,
+    [USB_VENDOR_CONV_SETUP] = vendor_conv_setup,
+    [USB_VENDOR_CONV_IR] = vendor_conv_ir,
+    [USB_VENDOR_CONV_ENABLE] = vendor_conv_enable,
+    [USB_VENDOR_DYN] = vendor_dyn,
+    [USB_VENDOR_DYN_METER] = vendor_dyn_meter,
+    [USB_VENDOR_SPECTRUM] = vendor_spectrum,
+    [USB_VENDOR_SPECTRUM_STATS] = vendor_spectrum_stats,
+    [USB_VENDOR_GRAPH] = vendor_graph,
+    [USB_VENDOR_GRAPH_METER] = vendor_graph_meter,
+    [USB_VENDOR_PROF] = vendor_prof,
+    [USB_VENDOR_LOAD] = vendor_load,
+    [USB_VENDOR_DEADLINE] = vendor_deadline,
+};
+
+usb_ctrl_result_t usb_vendor_request(const usb_setup_t *req) {
+  if ((req->bmRequestType & USB_REQ_RECIPIENT_Msk) !=
+          USB_REQ_RECIPIENT_DEVICE ||
+      req->bRequest >= sizeof(vendor_handlers) / sizeof(vendor_handlers[0]) ||
+      vendor_handlers[req->bRequest] == NULL) {
+    return USB_CTRL_STALL;
+  }
+
+  return vendor_handlers[req->bRequest](req);
+}
@@ -0,0 +1,81 @@
+#include "board.h"
+#include "clock.h"
+#include "codec.h"
+#include "feedback.h"
+#include "gpio.h"
+#include "i2c.h"
+#include "load.h"
+#include "mic.h"
+#include "playback.h"
+#include "prof.h"
+#include "tim.h"
+#include "usb.h"
+
+void DMA1_Stream3_IRQHandler(void);
+void DMA1_Stream5_IRQHandler(void);
+
+board_dma_t board_playback_dma = {
+    .stream = DMA1_Stream5,
+    .isr = &DMA1->HISR,
+    .ifcr = &DMA1->HIFCR,
+    .ht = DMA_HISR_HTIF5,
+    .tc = DMA_HISR_TCIF5,
+    .restart = DMA_HIFCR_CFEIF5,
+    .irq = DMA1_Stream5_IRQHandler,
+};
+
+board_dma_t board_mic_dma = {
+    .stream = DMA1_Stream3,
+    .isr = &DMA1->LISR,
+    .ifcr = &DMA1->LIFCR,
+    .ht = DMA_LISR_HTIF3,
+    .tc = DMA_LISR_TCIF3,
+    .restart = DMA_LIFCR_CFEIF3,
+    .irq = DMA1_Stream3_IRQHandler,
+};
+
+void board_init(void) {
+  clock_init();
+  prof_init();
+  gpio_init();
+  tim1_init();
+  playback_init();
+  mic_init();
+  i2c_init();
+  codec_init();
+  feedback_init();
+  usb_init();
+  load_init();
+}
+
+static uint32_t xfer_bytes(const board_dma_t *dma) {
+  return 1 << ((dma->stream->CR & DMA_SxCR_MSIZE) >> DMA_SxCR_MSIZE_Pos);
+}
+
+static uint8_t *half_addr(const board_dma_t *dma, uint8_t half) {
+  return (uint8_t *)(uintptr_t)dma->stream->M0AR +
+         half * dma->total / 2 * xfer_bytes(dma);
+}
+
+void board_dma_half(board_dma_t *dma,
+                    void (*fill)(void *half, uint32_t bytes)) {
+  // set up again since the last call, it starts from the top
+  if (*dma->ifcr & dma->restart) {
+    dma->total = dma->stream->NDTR;
+    dma->half = 0;
+  }
+  *dma->ifcr = 0;
+
+  if (fill) {
+    fill(half_addr(dma, dma->half), dma->total / 2 * xfer_bytes(dma));
+  }
+  dma->stream->NDTR = dma->half ? dma->total : dma->total / 2;
+  *dma->isr |= dma->half ? dma->tc : dma->ht;
+  dma->half ^= 1;
+  dma->irq();
+  *dma->isr &= ~(dma->ht | dma->tc);
+}
+
+void *board_dma_last(const board_dma_t *dma) {
+  return half_addr(dma, dma->half ^ 1);
+}
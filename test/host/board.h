@@ -0,0 +1,36 @@
+#ifndef _BOARD_H_
+#define _BOARD_H_
+
+#include <stm32f411xe.h>
+#include <stdint.h>
+
+// the firmware brought up as main() does it, and its DMA streams moved on
+// by hand. a stream advances one half-buffer per call: the data is put in
+// place, NDTR moves on, the half or full flag is raised and the interrupt
+// runs. the flag clear registers are plain memory here, so the flags are
+// dropped again afterwards.
+
+typedef struct {
+  DMA_Stream_TypeDef *stream;
+  volatile uint32_t *isr;   // LISR or HISR
+  volatile uint32_t *ifcr;  // LIFCR or HIFCR
+  uint32_t ht;              // flags of the stream
+  uint32_t tc;
+  uint32_t restart;         // only cleared when the stream is set up
+  void (*irq)(void);
+  uint32_t total;
+  uint8_t half;
+} board_dma_t;
+
+extern board_dma_t board_playback_dma;
+extern board_dma_t board_mic_dma;
+
+void board_init(void);
+// fill, if given, gets the half the DMA is about to complete: the samples
+// the firmware will read, or wrote for the playback stream
+void board_dma_half(board_dma_t *dma,
+                    void (*fill)(void *half, uint32_t bytes));
+// the half last completed
+void *board_dma_last(const board_dma_t *dma);
+
+#endif
\ No newline at end of file
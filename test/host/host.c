@@ -0,0 +1,103 @@
+#include <stm32f411xe.h>
+#include <time.h>
+
+#define HOST_NUM_IRQS 96
+
+static RCC_TypeDef rcc;
+static DWT_Type dwt;
+
+FLASH_TypeDef host_flash;
+GPIO_TypeDef host_gpio[5];
+DMA_TypeDef host_dma1;
+DMA_Stream_TypeDef host_dma1_stream[8];
+SPI_TypeDef host_spi[6];
+I2C_TypeDef host_i2c1;
+TIM_TypeDef host_tim1;
+TIM_TypeDef host_tim2;
+TIM_TypeDef host_tim11;
+CoreDebug_Type host_coredebug;
+DBGMCU_TypeDef host_dbgmcu;
+
+volatile uint32_t host_primask;
+uint8_t host_cycles_manual;
+void (*host_wfi_hook)(void);
+void (*host_barrier_hook)(void);
+void (*host_pll_lock_hook)(void);
+
+static uint8_t nvic_prio[HOST_NUM_IRQS];
+static uint8_t nvic_enabled[HOST_NUM_IRQS];
+static uint8_t nvic_pending[HOST_NUM_IRQS];
+
+// the oscillators and PLLs lock as soon as they are switched on, and the
+// clock switch takes effect at once
+RCC_TypeDef *host_rcc(void) {
+  if ((rcc.CR & RCC_CR_PLLI2SON) && !(rcc.CR & RCC_CR_PLLI2SRDY) &&
+      host_pll_lock_hook) {
+    host_pll_lock_hook();
+  }
+
+  uint32_t cr = rcc.CR & ~(RCC_CR_HSERDY | RCC_CR_PLLRDY | RCC_CR_PLLI2SRDY);
+
+  if (cr & RCC_CR_HSEON) {
+    cr |= RCC_CR_HSERDY;
+  }
+  if (cr & RCC_CR_PLLON) {
+    cr |= RCC_CR_PLLRDY;
+  }
+  if (cr & RCC_CR_PLLI2SON) {
+    cr |= RCC_CR_PLLI2SRDY;
+  }
+  rcc.CR = cr;
+  rcc.CFGR = (rcc.CFGR & ~RCC_CFGR_SWS) |
+             ((rcc.CFGR & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos);
+  return &rcc;
+}
+
+uint32_t host_cycles(void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint32_t)(((uint64_t)t.tv_sec * 1000000000u + t.tv_nsec) *
+                    HOST_CORE_MHZ / 1000);
+}
+
+DWT_Type *host_dwt(void) {
+  if (!host_cycles_manual) {
+    dwt.CYCCNT = host_cycles();
+  }
+  return &dwt;
+}
+
+void host_wfi(void) {
+  if (host_wfi_hook) {
+    host_wfi_hook();
+  }
+}
+
+void host_barrier(void) {
+  __sync_synchronize();
+  if (host_barrier_hook) {
+    host_barrier_hook();
+  }
+}
+
+void host_nvic_set_priority(IRQn_Type irq, uint32_t prio) {
+  nvic_prio[irq] = prio;
+}
+
+void host_nvic_enable(IRQn_Type irq) { nvic_enabled[irq] = 1; }
+
+void host_nvic_disable(IRQn_Type irq) { nvic_enabled[irq] = 0; }
+
+void host_nvic_set_pending(IRQn_Type irq) { nvic_pending[irq] = 1; }
+
+uint32_t host_nvic_priority(IRQn_Type irq) { return nvic_prio[irq]; }
+
+int host_nvic_enabled(IRQn_Type irq) { return nvic_enabled[irq]; }
+
+int host_nvic_take(IRQn_Type irq) {
+  int pending = nvic_pending[irq];
+
+  nvic_pending[irq] = 0;
+  return pending;
+}
\ No newline at end of file
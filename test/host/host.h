@@ -0,0 +1,50 @@
+#ifndef _HOST_H_
+#define _HOST_H_
+
+#include <stdint.h>
+
+// in-memory peripherals of the host build, included through the device
+// header once its types are defined
+
+// DWT->CYCCNT follows the host clock scaled to the 96 MHz core unless a
+// test drives it by hand
+#define HOST_CORE_MHZ 96
+
+extern FLASH_TypeDef host_flash;
+extern GPIO_TypeDef host_gpio[5];
+extern DMA_TypeDef host_dma1;
+extern DMA_Stream_TypeDef host_dma1_stream[8];
+extern SPI_TypeDef host_spi[6];
+extern I2C_TypeDef host_i2c1;
+extern TIM_TypeDef host_tim1;
+extern TIM_TypeDef host_tim2;
+extern TIM_TypeDef host_tim11;
+extern CoreDebug_Type host_coredebug;
+extern DBGMCU_TypeDef host_dbgmcu;
+
+extern volatile uint32_t host_primask;
+// set for tests that advance DWT->CYCCNT themselves
+extern uint8_t host_cycles_manual;
+// runs in place of WFI, if set
+extern void (*host_wfi_hook)(void);
+// runs at every memory barrier, where a test may let an interrupt preempt
+extern void (*host_barrier_hook)(void);
+// runs while PLLI2S locks, where a test may let an interrupt preempt
+extern void (*host_pll_lock_hook)(void);
+
+RCC_TypeDef *host_rcc(void);
+DWT_Type *host_dwt(void);
+uint32_t host_cycles(void);
+void host_wfi(void);
+void host_barrier(void);
+
+void host_nvic_set_priority(IRQn_Type irq, uint32_t prio);
+void host_nvic_enable(IRQn_Type irq);
+void host_nvic_disable(IRQn_Type irq);
+void host_nvic_set_pending(IRQn_Type irq);
+uint32_t host_nvic_priority(IRQn_Type irq);
+int host_nvic_enabled(IRQn_Type irq);
+// returns whether the interrupt was pending and clears it
+int host_nvic_take(IRQn_Type irq);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "i2c_target.h"
+#include "i2c.h"
+#include <stddef.h>
+#include <stm32f411xe.h>
+
+#define BIT_US 10
+#define BYTE_US (9 * BIT_US)
+#define START_US 5
+#define STOP_US 5
+
+// DR as left by the model, a firmware write replaces it
+#define DR_EMPTY 0x100
+
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+void TIM1_TRG_COM_TIM11_IRQHandler(void);
+
+uint8_t i2c_target_addr = 0x94;
+uint8_t i2c_target_regs[128];
+i2c_target_seg_t i2c_target_log[I2C_TARGET_LOG_LEN];
+uint32_t i2c_target_log_len;
+i2c_target_stats_t i2c_target_stats;
+
+typedef enum {
+  BUS_FREE,
+  BUS_START,  // START being generated
+  BUS_HELD,   // master owns the bus, SCL stretched
+  BUS_SHIFT,  // a byte on the wire
+  BUS_STOP,
+} bus_t;
+
+static uint32_t now;
+static bus_t bus = BUS_FREE;
+static uint32_t done_at;
+static i2c_target_seg_t *seg;
+static uint8_t shift_byte;
+static uint8_t shift_addr; // the byte on the wire is the address
+static uint8_t reading;
+static uint16_t dr_next = DR_EMPTY; // written while a byte shifts out
+static uint8_t reg_ptr;
+static uint8_t got_reg;
+static uint32_t tim11_cycles;
+
+uint32_t i2c_target_now(void) { return now; }
+
+int i2c_target_idle(void) {
+  return bus == BUS_FREE && !(I2C1->CR1 & (I2C_CR1_START | I2C_CR1_STOP)) &&
+         !(TIM11->CR1 & TIM_CR1_CEN);
+}
+
+static void seg_end(void) {
+  if (seg != NULL) {
+    seg->end_us = now;
+    seg = NULL;
+  }
+}
+
+static void shift(uint8_t byte, uint8_t addr) {
+  shift_byte = byte;
+  shift_addr = addr;
+  bus = BUS_SHIFT;
+  done_at = now + BYTE_US;
+}
+
+// a byte is through: the target takes it or answers with one
+static void shifted(void) {
+  if (shift_addr) {
+    seg->addr = shift_byte;
+    if ((shift_byte & 0xfe) != i2c_target_addr) {
+      seg->nack = 1;
+      I2C1->SR1 |= I2C_SR1_AF;
+      bus = BUS_HELD;
+      return;
+    }
+    reading = shift_byte & 1;
+    got_reg = 0;
+    I2C1->SR1 |= I2C_SR1_ADDR;
+    bus = BUS_HELD;
+    return;
+  }
+
+  if (seg->len < I2C_TARGET_SEG_MAX) {
+    seg->data[seg->len++] = shift_byte;
+  }
+  if (reading) {
+    I2C1->DR = shift_byte;
+    I2C1->SR1 |= I2C_SR1_RXNE;
+    if (reg_ptr & 0x80) {
+      reg_ptr = 0x80 | ((reg_ptr + 1) & 0x7f);
+    }
+    bus = BUS_HELD;
+    return;
+  }
+  if (!got_reg) {
+    got_reg = 1;
+    reg_ptr = shift_byte;
+  } else {
+    i2c_target_regs[reg_ptr & 0x7f] = shift_byte;
+    if (reg_ptr & 0x80) {
+      reg_ptr = 0x80 | ((reg_ptr + 1) & 0x7f);
+    }
+  }
+
+  if (dr_next != DR_EMPTY) {
+    shift(dr_next, 0);
+    dr_next = DR_EMPTY;
+    I2C1->SR1 |= I2C_SR1_TXE;
+  } else {
+    I2C1->SR1 |= I2C_SR1_TXE | I2C_SR1_BTF;
+    bus = BUS_HELD;
+  }
+}
+
+static int ev_pending(void) {
+  uint32_t sr1 = I2C1->SR1;
+  uint32_t cr2 = I2C1->CR2;
+
+  if (!(cr2 & I2C_CR2_ITEVTEN)) {
+    return 0;
+  }
+  return (sr1 & (I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF)) ||
+         ((cr2 & I2C_CR2_ITBUFEN) && (sr1 & (I2C_SR1_TXE | I2C_SR1_RXNE)));
+}
+
+// what the firmware did in an interrupt shows in DR, CR1 and the flags
+static void ev_irq(void) {
+  uint32_t sr1 = I2C1->SR1;
+
+  if (!(sr1 & I2C_SR1_RXNE)) {
+    I2C1->DR = DR_EMPTY;
+  }
+  i2c_target_stats.ev_cnt++;
+  I2C1_EV_IRQHandler();
+  uint32_t dr = I2C1->DR;
+
+  // reading SR2 after SR1 clears ADDR, reading DR clears RXNE. the driver
+  // does both in the interrupt that sees the flag.
+  I2C1->SR1 &= ~(I2C_SR1_ADDR | I2C_SR1_RXNE);
+  if ((sr1 & I2C_SR1_ADDR) && reading) {
+    shift(i2c_target_regs[reg_ptr & 0x7f], 0);
+  } else if ((sr1 & I2C_SR1_ADDR) && !reading) {
+    I2C1->SR1 |= I2C_SR1_TXE;
+  }
+
+  if (dr == DR_EMPTY || (sr1 & I2C_SR1_RXNE)) {
+    return;
+  }
+  // a DR write clears SB and BTF
+  if (sr1 & I2C_SR1_SB) {
+    I2C1->SR1 &= ~I2C_SR1_SB;
+    shift(dr, 1);
+  } else if (bus == BUS_SHIFT) {
+    dr_next = dr;
+    I2C1->SR1 &= ~I2C_SR1_TXE;
+  } else {
+    // straight into the shift register, DR is free again
+    I2C1->SR1 &= ~I2C_SR1_BTF;
+    shift(dr, 0);
+  }
+}
+
+static void er_irq(void) {
+  uint32_t sr1 = I2C1->SR1;
+
+  i2c_target_stats.er_cnt++;
+  I2C1_ER_IRQHandler();
+  // the error flags clear on a write of zero
+  I2C1->SR1 = sr1 & I2C1->SR1;
+}
+
+// TIM11 at the core clock over its prescaler, with the update interrupt
+// run as it fires
+static void tim11_tick(void) {
+  if (!(TIM11->CR1 & TIM_CR1_CEN)) {
+    tim11_cycles = 0;
+    return;
+  }
+  tim11_cycles += HOST_CORE_MHZ;
+  if (tim11_cycles < (TIM11->PSC + 1) * (TIM11->ARR + 1)) {
+    return;
+  }
+
+  tim11_cycles = 0;
+  TIM11->SR |= TIM_SR_UIF;
+  if (TIM11->CR1 & TIM_CR1_OPM) {
+    TIM11->CR1 &= ~TIM_CR1_CEN;
+  }
+  if (TIM11->DIER & TIM_DIER_UIE) {
+    i2c_target_stats.retry_cnt++;
+    TIM1_TRG_COM_TIM11_IRQHandler();
+  }
+}
+
+static void tick(void) {
+  uint32_t cr1 = I2C1->CR1;
+
+  tim11_tick();
+
+  // START and STOP wait for the byte on the wire
+  if (bus == BUS_FREE || bus == BUS_HELD) {
+    if (cr1 & I2C_CR1_STOP) {
+      seg_end();
+      bus = BUS_STOP;
+      done_at = now + STOP_US;
+      I2C1->SR1 &= ~(I2C_SR1_BTF | I2C_SR1_TXE);
+    } else if (cr1 & I2C_CR1_START) {
+      seg_end();
+      bus = BUS_START;
+      done_at = now + START_US;
+      I2C1->SR1 &= ~(I2C_SR1_BTF | I2C_SR1_TXE);
+    }
+  }
+
+  if ((bus == BUS_START || bus == BUS_SHIFT || bus == BUS_STOP) &&
+      now >= done_at) {
+    if (bus == BUS_START) {
+      I2C1->CR1 &= ~I2C_CR1_START;
+      if (i2c_target_log_len < I2C_TARGET_LOG_LEN) {
+        seg = &i2c_target_log[i2c_target_log_len++];
+        *seg = (i2c_target_seg_t){.start_us = now};
+      }
+      I2C1->SR1 |= I2C_SR1_SB;
+      bus = BUS_HELD;
+    } else if (bus == BUS_SHIFT) {
+      shifted();
+    } else {
+      I2C1->CR1 &= ~I2C_CR1_STOP;
+      bus = BUS_FREE;
+    }
+  }
+
+  int pended = host_nvic_take(I2C1_EV_IRQn);
+  if ((I2C1->SR1 & I2C_SR1_AF) && (I2C1->CR2 & I2C_CR2_ITERREN)) {
+    er_irq();
+  } else if (ev_pending() || pended) {
+    ev_irq();
+  }
+}
+
+void i2c_target_run(uint32_t us) {
+  for (uint32_t i = 0; i < us; i++) {
+    tick();
+    now++;
+  }
+}
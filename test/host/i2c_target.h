@@ -0,0 +1,44 @@
+#ifndef _I2C_TARGET_H_
+#define _I2C_TARGET_H_
+
+#include <stdint.h>
+
+// scripted target on the bus side of I2C1 at 100 kHz. it keeps its own
+// clock in microseconds, sets the status flags the way the peripheral
+// does as the bytes go out and runs the I2C interrupts while their
+// conditions hold, once per microsecond like a level interrupt would.
+// writes land in a register file with the CS43L22 auto-increment bit,
+// reads return from it. every START to STOP or repeated START is logged.
+
+#define I2C_TARGET_LOG_LEN 256
+#define I2C_TARGET_SEG_MAX 8
+
+typedef struct {
+  uint8_t addr; // address byte, read bit included
+  uint8_t nack;
+  uint8_t len;  // bytes after the address
+  uint8_t data[I2C_TARGET_SEG_MAX];
+  uint32_t start_us;
+  uint32_t end_us;
+} i2c_target_seg_t;
+
+typedef struct {
+  uint32_t ev_cnt; // event interrupt entries
+  uint32_t er_cnt;
+  uint32_t retry_cnt; // TIM11 interrupts
+} i2c_target_stats_t;
+
+// 8-bit write address answered, anything else is NACKed
+extern uint8_t i2c_target_addr;
+extern uint8_t i2c_target_regs[128];
+extern i2c_target_seg_t i2c_target_log[I2C_TARGET_LOG_LEN];
+extern uint32_t i2c_target_log_len;
+extern i2c_target_stats_t i2c_target_stats;
+
+uint32_t i2c_target_now(void);
+// run the bus, and TIM11 along with it
+void i2c_target_run(uint32_t us);
+// no transfer on the bus and none waiting to start
+int i2c_target_idle(void);
+
+#endif
\ No newline at end of file
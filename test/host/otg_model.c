@@ -0,0 +1,405 @@
+#include "otg_model.h"
+#include <stm32f411xe.h>
+#include <string.h>
+
+// endpoints of the OTG_FS core and its FIFO RAM in words
+#define OTG_EPS 4
+#define OTG_FIFO_WORDS 320
+#define OTG_EP0_MPS 64
+
+#define WORDS(bytes) (((uint32_t)(bytes) + 3) / 4)
+
+#define PKTSTS_OUT_DATA 0x2
+#define PKTSTS_OUT_DONE 0x3
+#define PKTSTS_SETUP_DONE 0x4
+#define PKTSTS_SETUP_DATA 0x6
+
+#define EPTYP_ISO (1 << USB_OTG_DIEPCTL_EPTYP_Pos)
+#define EP_EONUM USB_OTG_DIEPCTL_EONUM_DPID
+// written by software, read back as zero
+#define EP_CTL_ACTIONS                                                         \
+  (USB_OTG_DIEPCTL_SNAK | USB_OTG_DIEPCTL_CNAK |                               \
+   USB_OTG_DIEPCTL_SD0PID_SEVNFRM | USB_OTG_DIEPCTL_SODDFRM |                  \
+   USB_OTG_DIEPCTL_EPDIS)
+
+static uint32_t regs[0x1000 / 4];
+
+#define G ((USB_OTG_GlobalTypeDef *)regs)
+#define D ((USB_OTG_DeviceTypeDef *)((uint8_t *)regs + USB_OTG_DEVICE_BASE))
+#define IN(ep)                                                                 \
+  ((USB_OTG_INEndpointTypeDef *)((uint8_t *)regs + USB_OTG_IN_ENDPOINT_BASE +  \
+                                 (ep) * USB_OTG_EP_REG_SIZE))
+#define OUT(ep)                                                                \
+  ((USB_OTG_OUTEndpointTypeDef *)((uint8_t *)regs +                            \
+                                  USB_OTG_OUT_ENDPOINT_BASE +                  \
+                                  (ep) * USB_OTG_EP_REG_SIZE))
+
+otg_stats_t otg_stats;
+uint8_t otg_flush_stuck;
+
+// the RX FIFO holds status entries and data words in arrival order
+static uint32_t rx[OTG_FIFO_WORDS];
+static uint32_t rx_head, rx_count;
+// data words of the popped entry not read yet
+static uint32_t rx_left;
+
+static uint32_t tx[OTG_EPS][OTG_FIFO_WORDS];
+static uint32_t tx_head[OTG_EPS], tx_count[OTG_EPS];
+
+static uint32_t frame;
+
+static void rx_push(uint32_t val) {
+  rx[(rx_head + rx_count) % OTG_FIFO_WORDS] = val;
+  rx_count++;
+}
+
+static uint32_t rx_pop(void) {
+  uint32_t val = rx[rx_head];
+
+  rx_head = (rx_head + 1) % OTG_FIFO_WORDS;
+  rx_count--;
+  return val;
+}
+
+static uint32_t rx_depth(void) { return G->GRXFSIZ & USB_OTG_GRXFSIZ_RXFD; }
+
+static uint32_t tx_depth(uint8_t ep) {
+  uint32_t txf = ep == 0 ? G->DIEPTXF0_HNPTXFSIZ : G->DIEPTXF[ep - 1];
+
+  return txf >> USB_OTG_DIEPTXF_INEPTXFD_Pos;
+}
+
+static void tx_flush(uint8_t ep) {
+  tx_head[ep] = 0;
+  tx_count[ep] = 0;
+}
+
+static uint32_t rx_status(uint8_t ep, uint16_t bc, uint8_t pktsts) {
+  return (ep << USB_OTG_GRXSTSP_EPNUM_Pos) | (bc << USB_OTG_GRXSTSP_BCNT_Pos) |
+         (pktsts << USB_OTG_GRXSTSP_PKTSTS_Pos) | ((frame & 0xf) << 21);
+}
+
+static void core_reset(void) {
+  memset(regs, 0, sizeof(regs));
+  rx_head = 0;
+  rx_count = 0;
+  rx_left = 0;
+  for (uint8_t ep = 0; ep < OTG_EPS; ep++) {
+    tx_flush(ep);
+  }
+  frame = 0;
+}
+
+static uint32_t ep_ctl(uint32_t ctl, volatile uint32_t *epint, uint8_t in) {
+  if (ctl & USB_OTG_DIEPCTL_SNAK) {
+    ctl |= USB_OTG_DIEPCTL_NAKSTS;
+    if (in) {
+      *epint |= USB_OTG_DIEPINT_INEPNE;
+    }
+  }
+  if (ctl & USB_OTG_DIEPCTL_CNAK) {
+    ctl &= ~USB_OTG_DIEPCTL_NAKSTS;
+  }
+  if (ctl & USB_OTG_DIEPCTL_SD0PID_SEVNFRM) {
+    ctl &= ~EP_EONUM;
+  }
+  if (ctl & USB_OTG_DIEPCTL_SODDFRM) {
+    ctl |= EP_EONUM;
+  }
+  if (ctl & USB_OTG_DIEPCTL_EPDIS) {
+    if (ctl & USB_OTG_DIEPCTL_EPENA) {
+      *epint |= USB_OTG_DIEPINT_EPDISD;
+    }
+    ctl &= ~USB_OTG_DIEPCTL_EPENA;
+  }
+  return ctl & ~EP_CTL_ACTIONS;
+}
+
+// everything the core does on its own between two accesses
+static void otg_update(void) {
+  uint32_t rst = G->GRSTCTL;
+
+  if (rst & USB_OTG_GRSTCTL_CSRST) {
+    core_reset();
+    rst = 0;
+  }
+  if ((rst & USB_OTG_GRSTCTL_TXFFLSH) && !otg_flush_stuck) {
+    uint32_t num = (rst & USB_OTG_GRSTCTL_TXFNUM) >> USB_OTG_GRSTCTL_TXFNUM_Pos;
+    for (uint8_t ep = 0; ep < OTG_EPS; ep++) {
+      if (num == 0x10 || num == ep) {
+        tx_flush(ep);
+      }
+    }
+  }
+  if (rst & USB_OTG_GRSTCTL_RXFFLSH) {
+    rx_count = 0;
+    rx_left = 0;
+  }
+  uint32_t done = USB_OTG_GRSTCTL_CSRST | USB_OTG_GRSTCTL_RXFFLSH;
+  if (!otg_flush_stuck) {
+    done |= USB_OTG_GRSTCTL_TXFFLSH;
+  }
+  G->GRSTCTL = (rst & ~done) | USB_OTG_GRSTCTL_AHBIDL;
+
+  uint32_t daint = 0;
+  for (uint8_t ep = 0; ep < OTG_EPS; ep++) {
+    IN(ep)->DIEPCTL = ep_ctl(IN(ep)->DIEPCTL, &IN(ep)->DIEPINT, 1);
+    OUT(ep)->DOEPCTL = ep_ctl(OUT(ep)->DOEPCTL, &OUT(ep)->DOEPINT, 0);
+    IN(ep)->DTXFSTS = tx_depth(ep) > tx_count[ep] ? tx_depth(ep) - tx_count[ep]
+                                                  : 0;
+    if (IN(ep)->DIEPINT & D->DIEPMSK) {
+      daint |= 1 << ep;
+    }
+    if (OUT(ep)->DOEPINT & D->DOEPMSK) {
+      daint |= 1 << (ep + USB_OTG_DAINT_OEPINT_Pos);
+    }
+  }
+  D->DAINT = daint;
+  daint &= D->DAINTMSK;
+
+  uint32_t gintsts = G->GINTSTS & ~(USB_OTG_GINTSTS_RXFLVL |
+                                    USB_OTG_GINTSTS_IEPINT |
+                                    USB_OTG_GINTSTS_OEPINT);
+  if (rx_count != 0) {
+    gintsts |= USB_OTG_GINTSTS_RXFLVL;
+  }
+  if (daint & USB_OTG_DAINT_IEPINT) {
+    gintsts |= USB_OTG_GINTSTS_IEPINT;
+  }
+  if (daint & USB_OTG_DAINT_OEPINT) {
+    gintsts |= USB_OTG_GINTSTS_OEPINT;
+  }
+  G->GINTSTS = gintsts;
+  D->DSTS = (frame << USB_OTG_DSTS_FNSOF_Pos) | (3 << USB_OTG_DSTS_ENUMSPD_Pos);
+}
+
+void *otg_access(void) {
+  otg_stats.accesses++;
+  otg_update();
+  return regs;
+}
+
+uint32_t otg_rxsts_pop(void) {
+  otg_stats.accesses++;
+  otg_update();
+
+  if (rx_count == 0) {
+    otg_stats.rx_misread_cnt++;
+    return 0;
+  }
+  // data of the previous entry left behind is lost
+  if (rx_left != 0) {
+    otg_stats.rx_misread_cnt++;
+    while (rx_left > 0) {
+      rx_pop();
+      rx_left--;
+    }
+  }
+
+  uint32_t sts = rx_pop();
+  uint8_t ep = (sts & USB_OTG_GRXSTSP_EPNUM) >> USB_OTG_GRXSTSP_EPNUM_Pos;
+  uint8_t pktsts =
+      (sts & USB_OTG_GRXSTSP_PKTSTS) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
+
+  rx_left = WORDS((sts & USB_OTG_GRXSTSP_BCNT) >> USB_OTG_GRXSTSP_BCNT_Pos);
+  if (pktsts == PKTSTS_OUT_DONE) {
+    OUT(ep)->DOEPINT |= USB_OTG_DOEPINT_XFRC;
+  } else if (pktsts == PKTSTS_SETUP_DONE) {
+    OUT(0)->DOEPINT |= USB_OTG_DOEPINT_STUP;
+  }
+  otg_update();
+  return sts;
+}
+
+uint32_t otg_fifo_read(uint8_t ep) {
+  otg_stats.accesses++;
+
+  if (rx_left == 0) {
+    otg_stats.rx_misread_cnt++;
+    return 0;
+  }
+  rx_left--;
+  otg_stats.rx_words++;
+  return rx_pop();
+}
+
+void otg_fifo_write(uint8_t ep, uint32_t val) {
+  otg_stats.accesses++;
+
+  if (ep >= OTG_EPS || tx_count[ep] >= tx_depth(ep)) {
+    otg_stats.tx_overflow_cnt++;
+    return;
+  }
+  tx[ep][(tx_head[ep] + tx_count[ep]) % OTG_FIFO_WORDS] = val;
+  tx_count[ep]++;
+  otg_stats.tx_words++;
+}
+
+uint32_t otg_tx_take(uint8_t ep, uint32_t *dst, uint32_t max) {
+  uint32_t n = 0;
+
+  for (; n < max && tx_count[ep] > 0; n++) {
+    dst[n] = tx[ep][tx_head[ep]];
+    tx_head[ep] = (tx_head[ep] + 1) % OTG_FIFO_WORDS;
+    tx_count[ep]--;
+  }
+  return n;
+}
+
+void otg_int_clear(volatile uint32_t *reg, uint32_t bits) {
+  *reg &= ~bits;
+  otg_update();
+}
+
+void otg_bus_reset(void) {
+  G->GINTSTS |= USB_OTG_GINTSTS_USBRST | USB_OTG_GINTSTS_ENUMDNE;
+  frame = 0;
+  otg_update();
+}
+
+// a SETUP is always taken, the core keeps room for three of them
+void otg_setup(const uint8_t *req) {
+  uint32_t words[2];
+
+  memcpy(words, req, 8);
+  rx_push(rx_status(0, 8, PKTSTS_SETUP_DATA));
+  rx_push(words[0]);
+  rx_push(words[1]);
+  rx_push(rx_status(0, 0, PKTSTS_SETUP_DONE));
+  IN(0)->DIEPCTL &= ~USB_OTG_DIEPCTL_STALL;
+  OUT(0)->DOEPCTL &= ~USB_OTG_DOEPCTL_STALL;
+  otg_update();
+}
+
+static int iso_due(uint32_t ctl) {
+  return ((ctl & EP_EONUM) != 0) == (frame & 1);
+}
+
+otg_result_t otg_out(uint8_t ep, const uint8_t *data, uint16_t len) {
+  USB_OTG_OUTEndpointTypeDef *o = OUT(ep);
+  uint32_t ctl = o->DOEPCTL;
+  uint8_t iso = (ctl & USB_OTG_DOEPCTL_EPTYP) == EPTYP_ISO;
+  otg_result_t busy = iso ? OTG_MISS : OTG_NAK;
+
+  if (ctl & USB_OTG_DOEPCTL_STALL) {
+    return OTG_STALL;
+  }
+  if (!(ctl & USB_OTG_DOEPCTL_USBAEP) || !(ctl & USB_OTG_DOEPCTL_EPENA) ||
+      (ctl & USB_OTG_DOEPCTL_NAKSTS) || (iso && !iso_due(ctl))) {
+    return busy;
+  }
+  if (rx_count + WORDS(len) + 2 > rx_depth()) {
+    otg_stats.rx_full_cnt++;
+    return busy;
+  }
+
+  rx_push(rx_status(ep, len, PKTSTS_OUT_DATA));
+  for (uint32_t i = 0; i < WORDS(len); i++) {
+    uint32_t word = 0;
+    memcpy(&word, data + 4 * i, len - 4 * i < 4 ? len - 4 * i : 4);
+    rx_push(word);
+  }
+  rx_push(rx_status(ep, 0, PKTSTS_OUT_DONE));
+
+  // one packet per arming, the endpoint NAKs once it is done
+  uint32_t tsiz = o->DOEPTSIZ;
+  uint32_t pktcnt =
+      (tsiz & USB_OTG_DOEPTSIZ_PKTCNT) >> USB_OTG_DOEPTSIZ_PKTCNT_Pos;
+  if (pktcnt > 0) {
+    pktcnt--;
+  }
+  o->DOEPTSIZ = (tsiz & ~USB_OTG_DOEPTSIZ_PKTCNT) |
+                (pktcnt << USB_OTG_DOEPTSIZ_PKTCNT_Pos);
+  if (pktcnt == 0 || ep == 0) {
+    ctl &= ~USB_OTG_DOEPCTL_EPENA;
+    if (!iso) {
+      ctl |= USB_OTG_DOEPCTL_NAKSTS;
+    }
+  }
+  o->DOEPCTL = ctl;
+  otg_update();
+  return OTG_ACK;
+}
+
+otg_result_t otg_in(uint8_t ep, uint8_t *data, uint16_t *len) {
+  USB_OTG_INEndpointTypeDef *i = IN(ep);
+  uint32_t ctl = i->DIEPCTL;
+  uint8_t iso = (ctl & USB_OTG_DIEPCTL_EPTYP) == EPTYP_ISO;
+
+  *len = 0;
+  if (ctl & USB_OTG_DIEPCTL_STALL) {
+    return OTG_STALL;
+  }
+  if (!(ctl & USB_OTG_DIEPCTL_USBAEP) || !(ctl & USB_OTG_DIEPCTL_EPENA) ||
+      (ctl & USB_OTG_DIEPCTL_NAKSTS) || (iso && !iso_due(ctl))) {
+    return iso ? OTG_MISS : OTG_NAK;
+  }
+
+  uint32_t mps = ep == 0 ? OTG_EP0_MPS : ctl & USB_OTG_DIEPCTL_MPSIZ;
+  uint32_t tsiz = i->DIEPTSIZ;
+  uint32_t size = tsiz & USB_OTG_DIEPTSIZ_XFRSIZ;
+  uint32_t pktcnt =
+      (tsiz & USB_OTG_DIEPTSIZ_PKTCNT) >> USB_OTG_DIEPTSIZ_PKTCNT_Pos;
+  uint32_t n = size < mps ? size : mps;
+
+  if (tx_count[ep] < WORDS(n)) {
+    otg_stats.tx_underrun_cnt++;
+    return iso ? OTG_MISS : OTG_NAK;
+  }
+  for (uint32_t w = 0; w < WORDS(n); w++) {
+    uint32_t word = tx[ep][tx_head[ep]];
+    tx_head[ep] = (tx_head[ep] + 1) % OTG_FIFO_WORDS;
+    tx_count[ep]--;
+    memcpy(data + 4 * w, &word, n - 4 * w < 4 ? n - 4 * w : 4);
+  }
+  *len = n;
+
+  if (pktcnt > 0) {
+    pktcnt--;
+  }
+  i->DIEPTSIZ = (tsiz & ~(USB_OTG_DIEPTSIZ_XFRSIZ | USB_OTG_DIEPTSIZ_PKTCNT)) |
+                (size - n) | (pktcnt << USB_OTG_DIEPTSIZ_PKTCNT_Pos);
+  if (pktcnt == 0) {
+    i->DIEPCTL = ctl & ~USB_OTG_DIEPCTL_EPENA;
+    i->DIEPINT |= USB_OTG_DIEPINT_XFRC;
+  }
+  otg_update();
+  return OTG_ACK;
+}
+
+// end of the periodic frame: isochronous endpoints still enabled for it
+// missed their packet
+void otg_frame_end(void) {
+  for (uint8_t ep = 1; ep < OTG_EPS; ep++) {
+    uint32_t ctl = IN(ep)->DIEPCTL;
+    if ((ctl & (USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_EPTYP)) ==
+            (USB_OTG_DIEPCTL_EPENA | EPTYP_ISO) &&
+        iso_due(ctl)) {
+      G->GINTSTS |= USB_OTG_GINTSTS_IISOIXFR;
+    }
+    ctl = OUT(ep)->DOEPCTL;
+    if ((ctl & (USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_EPTYP)) ==
+            (USB_OTG_DOEPCTL_EPENA | EPTYP_ISO) &&
+        iso_due(ctl)) {
+      G->GINTSTS |= USB_OTG_GINTSTS_PXFR_INCOMPISOOUT;
+    }
+  }
+  otg_update();
+}
+
+void otg_sof(void) {
+  frame = (frame + 1) & (USB_OTG_DSTS_FNSOF >> USB_OTG_DSTS_FNSOF_Pos);
+  G->GINTSTS |= USB_OTG_GINTSTS_SOF;
+  otg_update();
+}
+
+uint32_t otg_frame(void) { return frame; }
+
+uint8_t otg_address(void) {
+  return (D->DCFG & USB_OTG_DCFG_DAD) >> USB_OTG_DCFG_DAD_Pos;
+}
+
+int otg_irq_pending(void) {
+  otg_update();
+  return (G->GAHBCFG & USB_OTG_GAHBCFG_GINT) && (G->GINTSTS & G->GINTMSK);
+}
\ No newline at end of file
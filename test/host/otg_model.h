@@ -0,0 +1,84 @@
+#ifndef _OTG_MODEL_H_
+#define _OTG_MODEL_H_
+
+#include <stdint.h>
+
+// in-memory OTG_FS device core for the host build, plugged in through
+// USB_REGS_OVERRIDE. the registers live at their usual offsets in one
+// block. every access from the firmware first lets the model act on what
+// was written since the last one, the way the core does between two bus
+// cycles: self-clearing bits clear, SNAK/CNAK and the frame parity bits
+// land in the status fields, disabled endpoints report EPDISD. the bus
+// side is driven by the functions further down.
+
+#define USB ((USB_OTG_GlobalTypeDef *)otg_access())
+#define USB_DEV                                                                \
+  ((USB_OTG_DeviceTypeDef *)((uint8_t *)otg_access() + USB_OTG_DEVICE_BASE))
+#define USB_INEP                                                               \
+  ((USB_OTG_INEndpointTypeDef *)((uint8_t *)otg_access() +                     \
+                                 USB_OTG_IN_ENDPOINT_BASE))
+#define USB_OUTEP                                                              \
+  ((USB_OTG_OUTEndpointTypeDef *)((uint8_t *)otg_access() +                    \
+                                  USB_OTG_OUT_ENDPOINT_BASE))
+
+#define USB_FIFO_READ(ep) otg_fifo_read(ep)
+#define USB_FIFO_WRITE(ep, val) otg_fifo_write((ep), (val))
+#define USB_RXSTS_POP() otg_rxsts_pop()
+#define USB_INT_CLEAR(reg, val) otg_int_clear(&(reg), (val))
+
+#define USB_CYCCNT() (DWT->CYCCNT)
+#define USB_CYCCNT_INIT() ((void)0)
+#define USB_CLK_ENABLE() ((void)0)
+#define USB_IRQ_ENABLE()                                                       \
+  do {                                                                         \
+    NVIC_SetPriority(OTG_FS_IRQn, 0);                                          \
+    NVIC_EnableIRQ(OTG_FS_IRQn);                                               \
+  } while (0)
+
+// handshake seen by the host for a transaction
+typedef enum {
+  OTG_ACK,
+  OTG_NAK,
+  OTG_STALL,
+  // isochronous packet not taken, or not sent, in this frame
+  OTG_MISS,
+} otg_result_t;
+
+typedef struct {
+  uint32_t accesses; // register, FIFO and status accesses by the firmware
+  uint32_t rx_words; // words popped from the RX FIFO
+  uint32_t tx_words; // words pushed into the TX FIFOs
+  uint32_t rx_full_cnt;   // packets refused for lack of RX FIFO space
+  uint32_t tx_overflow_cnt; // words pushed past the end of a TX FIFO
+  uint32_t tx_underrun_cnt; // IN packets with fewer words queued than sent
+  uint32_t rx_misread_cnt;  // RX FIFO reads without a popped status entry
+} otg_stats_t;
+
+extern otg_stats_t otg_stats;
+
+// fault injection: a TX FIFO flush that never completes
+extern uint8_t otg_flush_stuck;
+
+// firmware side
+void *otg_access(void);
+uint32_t otg_fifo_read(uint8_t ep);
+void otg_fifo_write(uint8_t ep, uint32_t val);
+uint32_t otg_rxsts_pop(void);
+void otg_int_clear(volatile uint32_t *reg, uint32_t bits);
+
+// bus side
+void otg_bus_reset(void);
+void otg_setup(const uint8_t *req);
+otg_result_t otg_out(uint8_t ep, const uint8_t *data, uint16_t len);
+otg_result_t otg_in(uint8_t ep, uint8_t *data, uint16_t *len);
+void otg_frame_end(void);
+void otg_sof(void);
+uint32_t otg_frame(void);
+uint8_t otg_address(void);
+// takes up to max words queued in a TX FIFO out without a transaction,
+// returns how many there were
+uint32_t otg_tx_take(uint8_t ep, uint32_t *dst, uint32_t max);
+// an unmasked interrupt is pending and the core interrupt is enabled
+int otg_irq_pending(void);
+
+#endif
\ No newline at end of file
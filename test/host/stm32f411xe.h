@@ -0,0 +1,87 @@
+#ifndef _HOST_STM32F411XE_H_
+#define _HOST_STM32F411XE_H_
+
+// host build of the device header. the register layouts and bit names come
+// from the real one, the peripherals the firmware touches are redirected to
+// memory in host.c and the core intrinsics to plain C.
+#include_next <stm32f411xe.h>
+
+#include "host.h"
+
+#undef RCC
+#undef FLASH
+#undef GPIOA
+#undef GPIOB
+#undef GPIOC
+#undef GPIOD
+#undef DMA1
+#undef DMA1_Stream3
+#undef DMA1_Stream5
+#undef SPI2
+#undef SPI3
+#undef I2C1
+#undef TIM1
+#undef TIM2
+#undef TIM11
+#undef DWT
+#undef CoreDebug
+#undef DBGMCU
+
+#define RCC host_rcc()
+#define FLASH (&host_flash)
+#define GPIOA (&host_gpio[0])
+#define GPIOB (&host_gpio[1])
+#define GPIOC (&host_gpio[2])
+#define GPIOD (&host_gpio[3])
+#define DMA1 (&host_dma1)
+#define DMA1_Stream3 (&host_dma1_stream[3])
+#define DMA1_Stream5 (&host_dma1_stream[5])
+#define SPI2 (&host_spi[2])
+#define SPI3 (&host_spi[3])
+#define I2C1 (&host_i2c1)
+#define TIM1 (&host_tim1)
+#define TIM2 (&host_tim2)
+#define TIM11 (&host_tim11)
+#define DWT host_dwt()
+#define CoreDebug (&host_coredebug)
+#define DBGMCU (&host_dbgmcu)
+
+#undef NVIC_SetPriority
+#undef NVIC_EnableIRQ
+#undef NVIC_DisableIRQ
+#undef NVIC_SetPendingIRQ
+#undef NVIC_ClearPendingIRQ
+
+#define NVIC_SetPriority(irq, prio) host_nvic_set_priority((irq), (prio))
+#define NVIC_EnableIRQ(irq) host_nvic_enable((irq))
+#define NVIC_DisableIRQ(irq) host_nvic_disable((irq))
+#define NVIC_SetPendingIRQ(irq) host_nvic_set_pending((irq))
+#define NVIC_ClearPendingIRQ(irq) host_nvic_take((irq))
+
+#undef __WFI
+#define __disable_irq() (host_primask = 1)
+#define __enable_irq() (host_primask = 0)
+#define __get_PRIMASK() (host_primask)
+#define __set_PRIMASK(x) (host_primask = (x))
+#define __DSB() __sync_synchronize()
+#define __DMB() host_barrier()
+#define __WFI() host_wfi()
+
+// DSP extension instructions the firmware uses, cmsis_gcc.h only has them
+// for cores that implement them. the pack macros are the ones CMSIS-DSP
+// defines for such cores, token for token, so both may be included.
+static inline uint32_t host_sadd16(uint32_t a, uint32_t b) {
+  uint32_t lo = (uint16_t)((int16_t)a + (int16_t)b);
+  uint32_t hi = (uint16_t)((int16_t)(a >> 16) + (int16_t)(b >> 16));
+  return lo | (hi << 16);
+}
+
+#define __SADD16(a, b) host_sadd16((a), (b))
+#define __PKHBT(ARG1, ARG2, ARG3)                                              \
+  ( (((int32_t)(ARG1) << 0) & (int32_t)0x0000FFFF) |                           \
+    (((int32_t)(ARG2) << ARG3) & (int32_t)0xFFFF0000) )
+#define __PKHTB(ARG1, ARG2, ARG3)                                              \
+  ( (((int32_t)(ARG1) << 0) & (int32_t)0xFFFF0000) |                           \
+    (((int32_t)(ARG2) >> ARG3) & (int32_t)0x0000FFFF) )
+
+#endif
\ No newline at end of file
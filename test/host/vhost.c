@@ -0,0 +1,313 @@
+#include "vhost.h"
+#include <stm32f411xe.h>
+#include <string.h>
+
+#define FRAME_NS 1000000u
+// one byte at 12 Mbit/s
+#define BYTE_NS 667u
+// sync, PIDs, address, CRC and handshake of one transaction
+#define TRANSACTION_BYTES 13u
+#define EP0_MPS 64
+
+// USB 2.0 7.1.7.5 and 9.2.6.3
+#define RESET_MS 10
+#define RESET_RECOVERY_MS 10
+#define SET_ADDRESS_MS 2
+// NAKed control stages give up after the usual host timeout
+#define NAK_LIMIT 5000
+
+#define REQ_SET_ADDRESS 0x05
+#define REQ_GET_DESCRIPTOR 0x06
+#define REQ_SET_CONFIGURATION 0x09
+#define REQ_SET_INTERFACE 0x0b
+
+#define UAC2_CUR 0x01
+#define UAC2_RANGE 0x02
+
+void OTG_FS_IRQHandler(void);
+
+vhost_stats_t vhost_stats;
+void (*vhost_frame_hook)(void);
+
+static uint64_t now_ns;
+static uint64_t frame_ns;
+static uint8_t addr;
+
+uint64_t vhost_now(void) { return now_ns / 1000; }
+
+void vhost_irq(void) {
+  for (int i = 0; i < 100 && otg_irq_pending(); i++) {
+    vhost_stats.irq_cnt++;
+    OTG_FS_IRQHandler();
+  }
+}
+
+void vhost_frame(void) {
+  otg_frame_end();
+  vhost_irq();
+  frame_ns += FRAME_NS;
+  now_ns = frame_ns;
+  otg_sof();
+  vhost_irq();
+  if (vhost_frame_hook) {
+    vhost_frame_hook();
+  }
+}
+
+void vhost_wait_ms(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    vhost_frame();
+  }
+}
+
+// a transaction that does not fit in what is left of the frame waits for
+// the next one
+static void bus_time(uint16_t bytes) {
+  uint64_t t = (uint64_t)(bytes + TRANSACTION_BYTES) * BYTE_NS;
+
+  if (now_ns + t > frame_ns + FRAME_NS) {
+    vhost_frame();
+  }
+  now_ns += t;
+  vhost_stats.transactions++;
+}
+
+// no SOFs while the bus is held in reset
+void vhost_reset(void) {
+  frame_ns += RESET_MS * FRAME_NS;
+  now_ns = frame_ns;
+  addr = 0;
+  otg_bus_reset();
+  vhost_irq();
+  vhost_wait_ms(RESET_RECOVERY_MS);
+}
+
+static otg_result_t ctrl_in(uint8_t *data, uint16_t *len) {
+  for (uint32_t i = 0; i < NAK_LIMIT; i++) {
+    otg_result_t r = otg_in(0, data, len);
+    bus_time(*len);
+    vhost_irq();
+    if (r != OTG_NAK) {
+      return r;
+    }
+    vhost_stats.nak_cnt++;
+    vhost_frame();
+  }
+  return OTG_NAK;
+}
+
+static otg_result_t ctrl_out(const uint8_t *data, uint16_t len) {
+  for (uint32_t i = 0; i < NAK_LIMIT; i++) {
+    otg_result_t r = otg_out(0, data, len);
+    bus_time(len);
+    vhost_irq();
+    if (r != OTG_NAK) {
+      return r;
+    }
+    vhost_stats.nak_cnt++;
+    vhost_frame();
+  }
+  return OTG_NAK;
+}
+
+static int ctrl_fail(otg_result_t r) {
+  if (r == OTG_STALL) {
+    vhost_stats.stall_cnt++;
+    return VHOST_STALL;
+  }
+  return VHOST_TIMEOUT;
+}
+
+// returns the length of the data stage, or VHOST_STALL/VHOST_TIMEOUT
+int vhost_control(uint8_t type, uint8_t request, uint16_t value,
+                  uint16_t index, uint16_t length, void *data) {
+  uint8_t req[8] = {type,  request,    value,  value >> 8,
+                    index, index >> 8, length, length >> 8};
+  uint8_t *buf = data;
+  uint16_t done = 0;
+  otg_result_t r;
+
+  // the device only listens to its own address
+  if (otg_address() != addr) {
+    return VHOST_TIMEOUT;
+  }
+
+  bus_time(8);
+  otg_setup(req);
+  vhost_irq();
+
+  if (length != 0 && (type & 0x80)) {
+    while (done < length) {
+      uint8_t pkt[EP0_MPS];
+      uint16_t n;
+      r = ctrl_in(pkt, &n);
+      if (r != OTG_ACK) {
+        return ctrl_fail(r);
+      }
+      if (n > length - done) {
+        n = length - done;
+      }
+      memcpy(buf + done, pkt, n);
+      done += n;
+      if (n < EP0_MPS) {
+        break;
+      }
+    }
+    r = ctrl_out(NULL, 0);
+  } else {
+    while (done < length) {
+      uint16_t n = length - done > EP0_MPS ? EP0_MPS : length - done;
+      r = ctrl_out(buf + done, n);
+      if (r != OTG_ACK) {
+        return ctrl_fail(r);
+      }
+      done += n;
+    }
+    uint8_t zlp[EP0_MPS];
+    uint16_t n;
+    r = ctrl_in(zlp, &n);
+  }
+
+  if (r != OTG_ACK) {
+    return ctrl_fail(r);
+  }
+  if (type == 0x00 && request == REQ_SET_ADDRESS) {
+    addr = value;
+    vhost_wait_ms(SET_ADDRESS_MS);
+  }
+  return done;
+}
+
+static uint16_t le16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+// interfaces, alternate settings, endpoints and the audio entities the
+// requests below need
+static void parse_config(vhost_device_t *dev) {
+  vhost_alt_t *alt = NULL;
+  uint8_t subclass = 0;
+
+  dev->num_alts = 0;
+  for (uint16_t i = 0; i + 2 <= dev->config_len && dev->config[i] != 0;
+       i += dev->config[i]) {
+    const uint8_t *d = &dev->config[i];
+
+    if (d[1] == 0x04 && dev->num_alts < VHOST_MAX_ALTS) {
+      alt = &dev->alts[dev->num_alts++];
+      memset(alt, 0, sizeof(*alt));
+      alt->iface = d[2];
+      alt->alt = d[3];
+      subclass = d[6];
+    } else if (d[1] == 0x05 && alt != NULL && alt->num_eps < 2) {
+      vhost_ep_t *ep = &alt->eps[alt->num_eps++];
+      ep->addr = d[2];
+      ep->attr = d[3];
+      ep->mps = le16(&d[4]);
+    } else if (d[1] == 0x24 && subclass == 0x01 && d[2] == 0x0a) {
+      dev->clock_id = d[3];
+    } else if (d[1] == 0x24 && subclass == 0x01 && d[2] == 0x06) {
+      dev->fu_id = d[3];
+      dev->fu_channels = (d[0] - 6) / 4;
+    } else if (d[1] == 0x24 && subclass == 0x02 && d[2] == 0x02 &&
+               alt != NULL) {
+      alt->subframe = d[4];
+      alt->bits = d[5];
+    }
+  }
+}
+
+const vhost_alt_t *vhost_find_alt(const vhost_device_t *dev, uint8_t iface,
+                                  uint8_t alt) {
+  for (uint8_t i = 0; i < dev->num_alts; i++) {
+    if (dev->alts[i].iface == iface && dev->alts[i].alt == alt) {
+      return &dev->alts[i];
+    }
+  }
+  return NULL;
+}
+
+static int get_descriptor(uint8_t type, uint8_t index, uint16_t lang,
+                          uint16_t len, void *buf) {
+  return vhost_control(0x80, REQ_GET_DESCRIPTOR, (type << 8) | index, lang,
+                       len, buf);
+}
+
+// the sequence Linux goes through for a UAC2 device, returns 0 once
+// configured
+int vhost_enumerate(vhost_device_t *dev) {
+  uint8_t buf[256];
+
+  vhost_reset();
+  if (get_descriptor(0x01, 0, 0, 64, buf) < 8 || buf[7] != EP0_MPS) {
+    return -1;
+  }
+  vhost_reset();
+  if (vhost_control(0x00, REQ_SET_ADDRESS, 1, 0, 0, NULL) < 0) {
+    return -1;
+  }
+  if (get_descriptor(0x01, 0, 0, 18, dev->device) != 18) {
+    return -1;
+  }
+  if (get_descriptor(0x02, 0, 0, 9, buf) != 9) {
+    return -1;
+  }
+  uint16_t total = le16(&buf[2]);
+  if (total > VHOST_CONFIG_MAX ||
+      get_descriptor(0x02, 0, 0, total, dev->config) != total) {
+    return -1;
+  }
+  dev->config_len = total;
+  parse_config(dev);
+
+  if (get_descriptor(0x03, 0, 0, 255, buf) < 4) {
+    return -1;
+  }
+  uint16_t lang = le16(&buf[2]);
+  for (uint8_t i = 14; i <= 16; i++) {
+    if (dev->device[i] != 0 &&
+        get_descriptor(0x03, dev->device[i], lang, 255, buf) < 2) {
+      return -1;
+    }
+  }
+
+  if (vhost_control(0x00, REQ_SET_CONFIGURATION, 1, 0, 0, NULL) < 0) {
+    return -1;
+  }
+
+  // what the audio driver reads before the first stream is opened
+  uint16_t clock = dev->clock_id << 8;
+  if (vhost_control(0xa1, UAC2_RANGE, 0x0100, clock, 2, buf) != 2 ||
+      vhost_control(0xa1, UAC2_RANGE, 0x0100, clock, 2 + 12 * buf[0], buf) <
+          0 ||
+      vhost_control(0xa1, UAC2_CUR, 0x0100, clock, 4, buf) != 4) {
+    return -1;
+  }
+  uint16_t fu = dev->fu_id << 8;
+  for (uint8_t ch = 0; ch < dev->fu_channels; ch++) {
+    if (vhost_control(0xa1, UAC2_CUR, 0x0100 | ch, fu, 1, buf) != 1 ||
+        vhost_control(0xa1, UAC2_RANGE, 0x0200 | ch, fu, 8, buf) != 8 ||
+        vhost_control(0xa1, UAC2_CUR, 0x0200 | ch, fu, 2, buf) != 2) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int vhost_set_interface(uint8_t iface, uint8_t alt) {
+  return vhost_control(0x01, REQ_SET_INTERFACE, alt, iface, 0, NULL);
+}
+
+otg_result_t vhost_iso_out(uint8_t ep, const void *data, uint16_t len) {
+  otg_result_t r = otg_out(ep, data, len);
+
+  bus_time(len);
+  vhost_irq();
+  return r;
+}
+
+otg_result_t vhost_iso_in(uint8_t ep, void *data, uint16_t *len) {
+  otg_result_t r = otg_in(ep, data, len);
+
+  bus_time(*len);
+  vhost_irq();
+  return r;
+}
\ No newline at end of file
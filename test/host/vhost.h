@@ -0,0 +1,74 @@
+#ifndef _VHOST_H_
+#define _VHOST_H_
+
+#include "otg_model.h"
+#include <stdint.h>
+
+// scripted full speed host on the bus side of the OTG model. it keeps a
+// simulated bus clock in microseconds: transactions take their time on the
+// wire at 12 Mbit/s, a NAK retries in the next frame and the delays of the
+// USB 2.0 spec between reset, SET_ADDRESS and the first requests are
+// waited out. the device interrupt runs after every bus event and takes no
+// simulated time.
+
+#define VHOST_MAX_ALTS 16
+#define VHOST_CONFIG_MAX 512
+
+// control transfer failures
+#define VHOST_STALL (-1)
+#define VHOST_TIMEOUT (-2)
+
+typedef struct {
+  uint8_t addr; // bEndpointAddress
+  uint8_t attr;
+  uint16_t mps;
+} vhost_ep_t;
+
+typedef struct {
+  uint8_t iface;
+  uint8_t alt;
+  uint8_t num_eps;
+  uint8_t subframe; // bSubslotSize of the format type descriptor
+  uint8_t bits;
+  vhost_ep_t eps[2];
+} vhost_alt_t;
+
+// what enumeration learned from the descriptors
+typedef struct {
+  uint8_t device[18];
+  uint8_t config[VHOST_CONFIG_MAX];
+  uint16_t config_len;
+  vhost_alt_t alts[VHOST_MAX_ALTS];
+  uint8_t num_alts;
+  uint8_t clock_id;
+  uint8_t fu_id;
+  uint8_t fu_channels; // master included
+} vhost_device_t;
+
+typedef struct {
+  uint32_t transactions;
+  uint32_t nak_cnt;
+  uint32_t stall_cnt;
+  uint32_t irq_cnt; // device interrupt entries
+} vhost_stats_t;
+
+extern vhost_stats_t vhost_stats;
+
+// runs once per frame right after the SOF, e.g. to move simulated audio
+extern void (*vhost_frame_hook)(void);
+
+uint64_t vhost_now(void);
+void vhost_irq(void);
+void vhost_frame(void);
+void vhost_wait_ms(uint32_t ms);
+void vhost_reset(void);
+int vhost_control(uint8_t type, uint8_t request, uint16_t value,
+                  uint16_t index, uint16_t length, void *data);
+int vhost_enumerate(vhost_device_t *dev);
+const vhost_alt_t *vhost_find_alt(const vhost_device_t *dev, uint8_t iface,
+                                  uint8_t alt);
+int vhost_set_interface(uint8_t iface, uint8_t alt);
+otg_result_t vhost_iso_out(uint8_t ep, const void *data, uint16_t len);
+otg_result_t vhost_iso_in(uint8_t ep, void *data, uint16_t *len);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <stdio.h>
+
+// a test program reports what it measured on stdout and exits non-zero
+// if a check failed
+static int test_failures;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);          \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+#define TEST_RESULT() (test_failures != 0)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "asrc.h"
+#include "audio_ring.h"
+#include "board.h"
+#include "conceal.h"
+#include "playback.h"
+#include "test.h"
+#include "usb_vendor.h"
+#include "vhost.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define RATE 48000
+#define HALF_FRAMES (RATE / 1000 * PLAYBACK_BUFFER_MS)
+// halfword transfers per frame and per buffer
+#define FRAME_XFERS 4
+#define DMA_XFERS (2 * HALF_FRAMES * FRAME_XFERS)
+// SOFs per feedback window, as TIM2 is set up
+#define WINDOW_FRAMES 64
+// 24 bits in 3 bytes, stereo
+#define FRAME_BYTES 6
+#define LEVEL 0.5
+// the servo has taken over the clock offset by then
+#define SETTLE_MS 20000
+// the halves of one feedback window, the resampler ratio only changes
+// in between
+#define MEASURE_FRAMES (30 * HALF_FRAMES)
+// the clock offset drifts from one end to the other over this long
+#define LONG_RUN_MS 300000
+#define RUNS 2000
+#define UAC2_CUR 0x01
+#define SAM_FREQ (0x01 << 8)
+
+void TIM2_IRQHandler(void);
+
+static uint8_t out_ep;
+static const vhost_alt_t *out_alt;
+
+static double tone_hz;
+static double phase;
+// device clock offset from the host in ppm, the frames it has played
+// and the fraction of one it is into the next
+static double ppm;
+static uint32_t played;
+static double frac;
+static uint32_t ms;
+
+static int32_t pcm[MEASURE_FRAMES];
+static int32_t err_min, err_max;
+
+// the resampler or the feedback, as the host selects it
+static int select_asrc(uint16_t on) {
+  return vhost_control(0x40, USB_VENDOR_ASRC, on, 0, 0, NULL);
+}
+
+static uint8_t asrc_selected(void) {
+  uint8_t on = 0xff;
+
+  CHECK(vhost_control(0xc0, USB_VENDOR_ASRC, 0, 0, 1, &on) == 1);
+  return on;
+}
+
+// fill error in frames as the servo sees it: the ring and the DMA buffer
+// against the ring's half and the DMA buffer's average
+static int32_t fill_error(void) {
+  return (int32_t)(audio_ring_fill(&audio_ring) / AUDIO_RING_FRAME_WORDS +
+                   playback_queued()) -
+         (AUDIO_RING_WORDS / 2 / AUDIO_RING_FRAME_WORDS + 3 * HALF_FRAMES / 2);
+}
+
+// a host frame: a packet of the tone at the nominal rate, whatever the
+// feedback says, and the output moved on by the device clock. TIM2 ends a
+// feedback window every 64 SOFs. returns the number of halves completed.
+static uint32_t frame(void) {
+  static uint8_t pkt[RATE / 1000 * FRAME_BYTES];
+  uint32_t halves = 0;
+
+  vhost_frame();
+  for (uint32_t i = 0; i < RATE / 1000; i++) {
+    int32_t v = (int32_t)(LEVEL * 0x7fffff * sin(phase));
+    for (uint8_t b = 0; b < 3; b++) {
+      pkt[FRAME_BYTES * i + b] = v >> (8 * b);
+      pkt[FRAME_BYTES * i + 3 + b] = -v >> (8 * b);
+    }
+    phase += 2 * M_PI * tone_hz / RATE;
+  }
+  CHECK(vhost_iso_out(out_ep, pkt, sizeof(pkt)) == OTG_ACK);
+
+  ms++;
+  uint32_t now = played + (uint32_t)(RATE * (1 + ppm / 1e6) / 1000 + frac);
+  frac = RATE * (1 + ppm / 1e6) / 1000 + frac - (now - played);
+  while (played / HALF_FRAMES < now / HALF_FRAMES) {
+    board_dma_half(&board_playback_dma, NULL);
+    played += HALF_FRAMES - played % HALF_FRAMES;
+    halves++;
+  }
+  played = now;
+  DMA1_Stream5->NDTR = DMA_XFERS - played % (2 * HALF_FRAMES) * FRAME_XFERS;
+
+  if (ms % WINDOW_FRAMES == 0) {
+    TIM2->SR |= TIM_SR_UIF;
+    TIM2_IRQHandler();
+  }
+
+  int32_t err = fill_error();
+  err_min = err < err_min ? err : err_min;
+  err_max = err > err_max ? err : err_max;
+  return halves;
+}
+
+// least squares fit of the tone, the rest is noise and distortion
+static double thdn_db(const int32_t *y, uint32_t n, double w) {
+  double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    double s = sin(w * i), c = cos(w * i);
+    ss += s * s;
+    sc += s * c;
+    cc += c * c;
+    ys += y[i] * s;
+    yc += y[i] * c;
+  }
+  double det = ss * cc - sc * sc;
+  double a = (ys * cc - yc * sc) / det;
+  double b = (yc * ss - ys * sc) / det;
+  double sig = 0, err = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    double fit = a * sin(w * i) + b * cos(w * i);
+    sig += fit * fit;
+    err += (y[i] - fit) * (y[i] - fit);
+  }
+  return 10 * log10(err / sig);
+}
+
+// the same at the tone frequency that fits best, searched within 100 ppm
+// of w
+static double thdn_best_db(const int32_t *y, uint32_t n, double w) {
+  const double g = (sqrt(5) - 1) / 2;
+  double lo = w * (1 - 1e-4), hi = w * (1 + 1e-4);
+
+  for (uint32_t i = 0; i < 60; i++) {
+    double a = hi - g * (hi - lo), b = lo + g * (hi - lo);
+    if (thdn_db(y, n, a) < thdn_db(y, n, b)) {
+      hi = b;
+    } else {
+      lo = a;
+    }
+  }
+  return thdn_db(y, n, (lo + hi) / 2);
+}
+
+// the tone through the resampler with the host ignoring the feedback:
+// once the servo has settled the output is the tone at the device rate
+// with the resampler's noise and distortion, taken in between two servo
+// updates. the ratio steps it makes are shown as well.
+static void run(double hz, double offset) {
+  uint32_t n = 0;
+  uint32_t end = ms + SETTLE_MS;
+  int32_t ratio_min = INT32_MAX, ratio_max = INT32_MIN;
+
+  tone_hz = hz;
+  ppm = offset;
+  while (ms < end || ms % WINDOW_FRAMES != 0) {
+    frame();
+    if (end - ms < SETTLE_MS / 2) {
+      int32_t ratio = asrc_ratio_ppm();
+      ratio_min = ratio < ratio_min ? ratio : ratio_min;
+      ratio_max = ratio > ratio_max ? ratio : ratio_max;
+    }
+  }
+  err_min = err_max = fill_error();
+  while (n < MEASURE_FRAMES) {
+    if (frame()) {
+      const uint32_t *half = board_dma_last(&board_playback_dma);
+      for (uint32_t i = 0; i < HALF_FRAMES && n < MEASURE_FRAMES; i++) {
+        uint32_t w = half[2 * i];
+        pcm[n++] = (int32_t)((w >> 16) | (w << 16));
+      }
+    }
+  }
+
+  double thdn =
+      thdn_best_db(pcm, n, 2 * M_PI * hz / (RATE * (1 + offset / 1e6)));
+  printf("%5.0f Hz, device %+5.0f ppm: ratio %+5d to %+5d ppm, THD+N %.1f "
+         "dB, fill %+d to %+d\n",
+         hz, offset, (int)ratio_min, (int)ratio_max, thdn, (int)err_min,
+         (int)err_max);
+  CHECK(abs(ratio_min + (int32_t)offset) < 50);
+  CHECK(abs(ratio_max + (int32_t)offset) < 50);
+  CHECK(thdn < (hz > 5000 ? -80 : -85));
+}
+
+// cycles per output frame of a block taken straight from the ring, host
+// time scaled to 96 MHz
+static double bench(void) {
+  static uint32_t out[HALF_FRAMES * AUDIO_RING_FRAME_WORDS];
+  audio_ring_span_t span;
+  uint64_t total = 0;
+
+  asrc_reset();
+  for (uint32_t r = 0; r < RUNS; r++) {
+    audio_ring_flush(&audio_ring);
+    CHECK(audio_ring_reserve(&audio_ring, AUDIO_RING_WORDS / 2, &span));
+    audio_ring_commit(&audio_ring, AUDIO_RING_WORDS / 2);
+    uint32_t start = DWT->CYCCNT;
+    CHECK(asrc_process(out, HALF_FRAMES) == HALF_FRAMES);
+    total += DWT->CYCCNT - start;
+  }
+  audio_ring_flush(&audio_ring);
+  return (double)total / RUNS / HALF_FRAMES;
+}
+
+// THD+N of a 1 and a 10 kHz tone through the resampler with the device
+// clock 1000 ppm either side of the host, cycles per output frame, and a
+// long run in which the host never follows the feedback and the device
+// clock drifts across the whole range: the resampler takes over, the fill
+// stays within a packet of its center and the output never runs dry. the
+// host selects either one, until the stream restarts or the rate changes.
+int main(void) {
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 3) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      out_ep = alt->eps[0].addr;
+      out_alt = alt;
+    }
+  }
+  CHECK(out_ep != 0);
+  CHECK(asrc_selected() == 0);
+  CHECK(select_asrc(2) == VHOST_STALL);
+
+  printf("%.1f cycles/frame\n", bench());
+
+  // the output runs from the first half on, with the resampler
+  CHECK(select_asrc(1) == 0);
+  CHECK(asrc_selected() == 1);
+  board_dma_half(&board_playback_dma, NULL);
+  played = HALF_FRAMES;
+  uint32_t underruns = conceal_stats.underrun_cnt;
+  uint32_t overruns = audio_ring.overrun_cnt;
+  run(1000, 1000);
+  run(1000, -1000);
+  run(10000, 1000);
+  run(10000, -1000);
+  CHECK(conceal_stats.underrun_cnt == underruns);
+  CHECK(audio_ring.overrun_cnt == overruns);
+
+  // the feedback finds the host ignoring it and hands over
+  CHECK(select_asrc(0) == 0);
+  CHECK(asrc_selected() == 0);
+  uint32_t begin = ms;
+  uint32_t handover = 0;
+  while (ms - begin < LONG_RUN_MS) {
+    ppm = -1000 + 2000.0 * (ms - begin) / LONG_RUN_MS;
+    frame();
+    if (!handover && playback_asrc()) {
+      handover = ms - begin;
+    }
+    if (ms - begin == handover + SETTLE_MS) {
+      err_min = err_max = fill_error();
+    }
+  }
+  printf("%u s from -1000 to +1000 ppm: resampler from %u ms, ratio %+d "
+         "ppm, fill %+d to %+d\n",
+         LONG_RUN_MS / 1000, (unsigned)handover, (int)asrc_ratio_ppm(),
+         (int)err_min, (int)err_max);
+  CHECK(handover != 0);
+  CHECK(err_min > -RATE / 1000 && err_max < RATE / 1000);
+  CHECK(conceal_stats.underrun_cnt == underruns);
+  CHECK(audio_ring.overrun_cnt == overruns);
+
+  // a new stream, or the same one at a new rate, starts on the feedback
+  CHECK(vhost_set_interface(out_alt->iface, out_alt->alt) == 0);
+  CHECK(asrc_selected() == 0);
+  CHECK(select_asrc(1) == 0);
+  uint8_t rate[4] = {0x44, 0xac, 0x00, 0x00};
+  CHECK(vhost_control(0x21, UAC2_CUR, SAM_FREQ, dev.clock_id << 8, 4,
+                      rate) == 4);
+  CHECK(asrc_selected() == 0);
+  CHECK(select_asrc(1) == 0);
+  board_dma_half(&board_playback_dma, NULL);
+  CHECK(playback_rate() == 44100);
+  CHECK(asrc_selected() == 0);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,121 @@
+#include "audio_gain.h"
+#include "test.h"
+#include <math.h>
+#include <stdlib.h>
+#include <stm32f411xe.h>
+
+#define FRAMES 48
+#define RUNS 20000
+// full scale halved, so a gain error shows in the low bits
+#define LEVEL 0x40000000
+
+static uint32_t buf[2 * FRAMES];
+
+static uint32_t pack(uint16_t left, uint16_t right) {
+  return left | (uint32_t)right << 16;
+}
+
+static void fill(void) {
+  for (uint32_t i = 0; i < 2 * FRAMES; i++) {
+    buf[i] = LEVEL;
+  }
+}
+
+// frames of channel ch that go the wrong way, past either end of a ramp
+// from gain a to gain b or further than an even step, with a constant
+// input
+static uint32_t ramp_errors(uint8_t ch, uint16_t a, uint16_t b) {
+  int64_t from = ((int64_t)LEVEL * a) >> 15;
+  int64_t to = ((int64_t)LEVEL * b) >> 15;
+  int64_t lo = from < to ? from : to;
+  int64_t hi = from < to ? to : from;
+  // with both channels there the samples are passed through
+  if (a == 0x7fff || b == 0x7fff) {
+    hi = LEVEL;
+  }
+  int64_t step = ((int64_t)LEVEL * abs(b - a) / FRAMES) >> 15;
+  uint32_t bad = 0;
+
+  for (uint32_t i = 0; i < FRAMES; i++) {
+    int64_t y = (int32_t)buf[2 * i + ch];
+    int64_t prev = i ? (int32_t)buf[2 * i - 2 + ch] : y;
+    // the product loses a bit to the 32 x 16 multiply
+    bad += y < lo - 2 || y > hi + 2;
+    bad += to > from ? y < prev : y > prev;
+    bad += llabs(y - prev) > step + 2;
+  }
+  return bad;
+}
+
+// cycles of one block, host time scaled to 96 MHz
+static double bench(uint32_t from, uint32_t to) {
+  audio_gain_t g;
+  uint64_t total = 0;
+
+  srand(1);
+  for (uint32_t i = 0; i < 2 * FRAMES; i++) {
+    buf[i] = rand();
+  }
+  for (uint32_t r = 0; r < RUNS; r++) {
+    g.gain = from;
+    g.target = to;
+    uint32_t start = DWT->CYCCNT;
+    audio_gain_apply(&g, buf, FRAMES);
+    total += DWT->CYCCNT - start;
+  }
+  return (double)total / RUNS;
+}
+
+// the table is 0.5 dB steps of the Q15 gain, volumes round to the nearest
+// step. a changed gain ramps over one block to the new one without a step
+// the wrong way or beyond it, the two channels each their own way, and
+// the next block is at the target. cycles are per 48-frame block.
+int main(void) {
+  static const int32_t volumes[] = {0, -128, -256, -3 * 256, -20 * 256,
+                                    -40 * 256, AUDIO_GAIN_MIN};
+
+  uint32_t table_bad = 0;
+  for (int32_t vol = AUDIO_GAIN_MIN; vol <= AUDIO_GAIN_MAX; vol++) {
+    int32_t step = (vol - AUDIO_GAIN_RES / 2) / AUDIO_GAIN_RES;
+    double want = 0x7fff * pow(10, step * 0.5 / 20);
+    table_bad += fabs(audio_gain_q15(vol) - want) > 0.5;
+  }
+  CHECK(table_bad == 0);
+  CHECK(audio_gain_q15(AUDIO_GAIN_MAX + 256) == 0x7fff);
+  CHECK(audio_gain_q15(AUDIO_GAIN_MIN - 256) ==
+        audio_gain_q15(AUDIO_GAIN_MIN));
+
+  uint32_t ramp_bad = 0, target_bad = 0;
+  uint16_t gains[sizeof(volumes) / sizeof(volumes[0]) + 1];
+  uint32_t n = 0;
+  for (; n < sizeof(volumes) / sizeof(volumes[0]); n++) {
+    gains[n] = audio_gain_q15(volumes[n]);
+  }
+  // muted
+  gains[n++] = 0;
+  for (uint32_t a = 0; a < n; a++) {
+    for (uint32_t b = 0; b < n; b++) {
+      // left from a to b, right the other way
+      audio_gain_t g = {pack(gains[a], gains[b]), pack(gains[b], gains[a])};
+      fill();
+      audio_gain_apply(&g, buf, FRAMES);
+      ramp_bad += ramp_errors(0, gains[a], gains[b]);
+      ramp_bad += ramp_errors(1, gains[b], gains[a]);
+
+      fill();
+      audio_gain_apply(&g, buf, FRAMES);
+      target_bad += ramp_errors(0, gains[b], gains[b]);
+      target_bad += ramp_errors(1, gains[a], gains[a]);
+    }
+  }
+  CHECK(ramp_bad == 0);
+  CHECK(target_bad == 0);
+
+  double unity = bench(AUDIO_GAIN_UNITY, AUDIO_GAIN_UNITY);
+  double steady = bench(pack(gains[3], gains[3]), pack(gains[3], gains[3]));
+  double ramp = bench(AUDIO_GAIN_UNITY, pack(gains[4], gains[5]));
+  printf("%u frames: unity %.1f, steady %.1f, ramp %.1f cycles/block\n",
+         FRAMES, unity, steady, ramp);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,131 @@
+#include "audio_ring.h"
+#include "board.h"
+#include "conceal.h"
+#include "playback.h"
+#include "test.h"
+#include "vhost.h"
+#include <math.h>
+
+#define RATE 48000
+#define HALF_FRAMES (RATE / 1000 * PLAYBACK_BUFFER_MS)
+#define PACKET_FRAMES (RATE / 1000)
+// not a divisor of the rate, so every gap ends at another phase
+#define TONE_HZ 997.0
+#define LEVEL 0.5
+// largest step between two output samples, as a fraction of full scale:
+// the tone's own steepest and a fade step on top, with some margin. a hard
+// cut or splice of the tone can be up to twice LEVEL.
+#define MAX_STEP (LEVEL * (2 * M_PI * TONE_HZ / RATE + 0.02))
+
+static uint8_t out_ep;
+static double phase;
+static int32_t last;
+static double step_max;
+static uint32_t frames_out;
+
+// the output since the last call, the largest step between samples of
+// either channel kept
+static void check_output(void) {
+  const uint32_t *half = board_dma_last(&board_playback_dma);
+
+  for (uint32_t i = 0; i < HALF_FRAMES; i++) {
+    uint32_t w = half[2 * i];
+    int32_t y = (int32_t)((w >> 16) | (w << 16));
+    double d = fabs((double)y - last) / 2147483648.0;
+
+    step_max = d > step_max ? d : step_max;
+    last = y;
+  }
+  frames_out += HALF_FRAMES;
+}
+
+// ms milliseconds of the host sending the tone unless gap is set, and of
+// the output taking a half every two unless stalled
+static void play(uint32_t ms, uint8_t gap, uint8_t stall) {
+  static int16_t pkt[2 * PACKET_FRAMES];
+
+  for (uint32_t t = 0; t < ms; t++) {
+    vhost_frame();
+    if (!gap) {
+      for (uint32_t i = 0; i < PACKET_FRAMES; i++) {
+        pkt[2 * i] = (int16_t)(LEVEL * 32767 * sin(phase));
+        pkt[2 * i + 1] = -pkt[2 * i];
+        phase += 2 * M_PI * TONE_HZ / RATE;
+      }
+      CHECK(vhost_iso_out(out_ep, pkt, sizeof(pkt)) == OTG_ACK);
+    }
+    if (!stall && otg_frame() % PLAYBACK_BUFFER_MS == 0) {
+      board_dma_half(&board_playback_dma, NULL);
+      check_output();
+    }
+  }
+}
+
+// the host leaves gaps from shorter than the queue to many times longer,
+// and the output stalls long enough for the ring to overflow. the output
+// never steps by more than the tone and a fade step do: every underrun and
+// overflow fades out and back in, with the event counted where it
+// happened, and nothing runs out in the middle of a fade.
+int main(void) {
+  static const uint32_t gaps[] = {1, 5, 12, 20, 50, 200};
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      out_ep = alt->eps[0].addr;
+    }
+  }
+  CHECK(out_ep != 0);
+
+  play(100, 0, 0);
+  CHECK(playback_playing());
+  CHECK(conceal_stats.resume_cnt == 1);
+
+  uint32_t underruns = 0;
+  for (uint32_t i = 0; i < sizeof(gaps) / sizeof(gaps[0]); i++) {
+    uint32_t before = conceal_stats.underrun_cnt;
+    uint32_t pos = frames_out;
+
+    play(gaps[i], 1, 0);
+    play(100, 0, 0);
+    uint8_t ran_dry = conceal_stats.underrun_cnt != before;
+    printf("%3u ms gap: %s\n", (unsigned)gaps[i],
+           ran_dry ? "faded out and in" : "queue rode it out");
+    if (ran_dry) {
+      underruns++;
+      CHECK(conceal_stats.underrun_pos >= pos);
+      CHECK(conceal_stats.resume_pos > conceal_stats.underrun_pos);
+    }
+    CHECK(playback_playing());
+  }
+  // the queue holds about 10 ms
+  CHECK(underruns == 4);
+  CHECK(conceal_stats.underrun_cnt == underruns);
+
+  uint32_t overruns = audio_ring.overrun_cnt;
+  uint32_t pos = frames_out;
+  play(20, 0, 1);
+  play(100, 0, 0);
+  printf("20 ms stall: %u packets refused\n",
+         (unsigned)(audio_ring.overrun_cnt - overruns));
+  CHECK(audio_ring.overrun_cnt != overruns);
+  CHECK(conceal_stats.overrun_cnt == 1);
+  CHECK(conceal_stats.overrun_pos >= pos);
+  CHECK(conceal_stats.resume_pos > conceal_stats.overrun_pos);
+  CHECK(playback_playing());
+
+  printf("largest step %.4f of full scale, %.4f allowed, %u resumes, %u "
+         "cut short\n",
+         step_max, MAX_STEP, (unsigned)conceal_stats.resume_cnt,
+         (unsigned)conceal_stats.cut_cnt);
+  CHECK(step_max < MAX_STEP);
+  CHECK(conceal_stats.resume_cnt == 1 + underruns + 1);
+  CHECK(conceal_stats.cut_cnt == 0);
+
+  return TEST_RESULT();
+}
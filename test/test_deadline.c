@@ -0,0 +1,155 @@
+#include "board.h"
+#include "conceal.h"
+#include "deadline.h"
+#include "peq.h"
+#include "playback.h"
+#include "test.h"
+#include "usb_vendor.h"
+#include "vhost.h"
+
+#define RATE 48000
+#define HALF_FRAMES (RATE / 1000 * PLAYBACK_BUFFER_MS)
+#define PACKET_FRAMES (RATE / 1000)
+// halfword transfers per frame and per buffer
+#define FRAME_XFERS 4
+#define DMA_XFERS (2 * HALF_FRAMES * FRAME_XFERS)
+// the stages slow down to this many times their cost and back
+#define SLOW_MAX 4.0
+#define RAMP 5000
+#define HOLD 2500
+
+// what each tier runs, as deadline.c sheds it
+static const struct {
+  uint8_t peq_bands;
+  uint8_t conv_shorten;
+  uint8_t spectrum;
+} tiers[DEADLINE_TIERS] = {
+    {PEQ_MAX_BANDS, 0, 1},
+    {PEQ_MAX_BANDS, 0, 0},
+    {PEQ_MAX_BANDS, 1, 0},
+    {PEQ_MAX_BANDS / 2, 2, 0},
+    {2, 3, 0},
+};
+
+// cost of a refill as a fraction of the half it has to fill: the ring and
+// the limiter at their own speed, the stages that can be shed slowed down
+static double slow;
+
+static double cost(uint8_t tier) {
+  double stages = 0.02 * tiers[tier].peq_bands +
+                  0.3 / (1 << tiers[tier].conv_shorten) +
+                  0.05 * tiers[tier].spectrum;
+  return 0.1 + slow * stages;
+}
+
+static uint8_t out_ep;
+static uint8_t armed;
+
+// the DMA moves on while the refill processes, by the cost of the tier
+// it runs at. the first barrier of the refill is when it reads the ring.
+static void refill_cost(void) {
+  if (!armed) {
+    return;
+  }
+  armed = 0;
+
+  uint32_t ndtr = DMA1_Stream5->NDTR;
+  uint32_t xfers = (uint32_t)(cost(deadline_stats.tier) * HALF_FRAMES) *
+                   FRAME_XFERS;
+  DMA1_Stream5->NDTR = ndtr > xfers ? ndtr - xfers : ndtr + DMA_XFERS - xfers;
+}
+
+// n refills with the slowdown going linearly from a to b. returns the
+// refills that would have missed at full processing.
+static uint32_t run(uint32_t n, double a, double b) {
+  static const int16_t pkt[2 * PACKET_FRAMES];
+  uint32_t full_misses = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    slow = a + (b - a) * i / n;
+    full_misses += cost(0) > 1.0;
+    for (uint32_t t = 0; t < PLAYBACK_BUFFER_MS; t++) {
+      vhost_frame();
+      CHECK(vhost_iso_out(out_ep, pkt, sizeof(pkt)) == OTG_ACK);
+    }
+    armed = 1;
+    board_dma_half(&board_playback_dma, NULL);
+  }
+  return full_misses;
+}
+
+// the shed stages slow down to four times their cost and recover, slowly
+// enough for the monitor to follow: the refills come close to the deadline
+// but never miss it, the output never runs dry, every tier change is
+// logged, and full processing comes back once the headroom does
+int main(void) {
+  vhost_device_t dev;
+  deadline_stats_t s;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      out_ep = alt->eps[0].addr;
+    }
+  }
+  CHECK(out_ep != 0);
+  host_barrier_hook = refill_cost;
+
+  run(1000, 1.0, 1.0);
+  CHECK(playback_playing());
+  CHECK(vhost_control(0xc0, USB_VENDOR_DEADLINE, 0, 0, sizeof(s), &s) ==
+        sizeof(s));
+  CHECK(s.tier == 0 && s.down_cnt == 0);
+  CHECK(s.margin_min < DEADLINE_HIGH && s.margin_min >= DEADLINE_LOW);
+  uint32_t underruns = conceal_stats.underrun_cnt;
+
+  uint32_t full_misses = run(RAMP, 1.0, SLOW_MAX);
+  full_misses += run(HOLD, SLOW_MAX, SLOW_MAX);
+  uint8_t worst = deadline_stats.tier;
+  CHECK(vhost_control(0xc0, USB_VENDOR_DEADLINE, 0, 0, sizeof(s), &s) ==
+        sizeof(s));
+  printf("slowed %.0fx: tier %u, %u near misses, %u missed, margin down to "
+         "%.1f %%, %u refills would have missed at full processing\n",
+         SLOW_MAX, (unsigned)worst, (unsigned)s.near_cnt,
+         (unsigned)s.miss_cnt, s.margin_min / 100.0, (unsigned)full_misses);
+  CHECK(full_misses > 0);
+  CHECK(worst == DEADLINE_TIERS - 1);
+  CHECK(s.miss_cnt == 0);
+  CHECK(s.margin_min > 0);
+
+  run(RAMP, SLOW_MAX, 1.0);
+  run(HOLD, 1.0, 1.0);
+  s = deadline_stats;
+  printf("recovered: tier %u, %u steps down, %u up, %u near misses, %u "
+         "missed\n",
+         (unsigned)s.tier, (unsigned)s.down_cnt, (unsigned)s.up_cnt,
+         (unsigned)s.near_cnt, (unsigned)s.miss_cnt);
+  CHECK(s.tier == 0);
+  CHECK(s.miss_cnt == 0);
+  CHECK(s.down_cnt == s.up_cnt);
+  // every step down was a near miss
+  CHECK(s.near_cnt == s.down_cnt);
+  CHECK(conceal_stats.underrun_cnt == underruns);
+
+  // the log holds the last changes, one tier at a time, ending at the
+  // current one
+  uint32_t bad = 0;
+  uint8_t to = s.tier;
+  for (uint32_t i = 1; i <= DEADLINE_LOG; i++) {
+    const deadline_event_t *e =
+        &s.log[(s.log_pos + DEADLINE_LOG - i) % DEADLINE_LOG];
+    bad += e->to != to;
+    bad += e->from != e->to + 1 && e->to != e->from + 1;
+    bad += e->to > e->from ? e->margin >= DEADLINE_LOW
+                           : e->margin < DEADLINE_HIGH;
+    to = e->from;
+  }
+  CHECK(bad == 0);
+
+  host_barrier_hook = NULL;
+  return TEST_RESULT();
+}
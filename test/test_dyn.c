@@ -0,0 +1,159 @@
+#include "dyn.h"
+#include "test.h"
+#include <math.h>
+#include <stdlib.h>
+#include <stm32f411xe.h>
+
+#define RATE 48000
+#define FRAMES (RATE / 1000)
+#define LEN (10 * RATE)
+// the limiter delays by one look-ahead less a frame
+#define DELAY (RATE / 1000 * DYN_LOOKAHEAD_MS - 1)
+#define RUNS 5000
+
+static float32_t x[2 * LEN];
+static float32_t y[2 * LEN];
+
+static float32_t uniform(float32_t a) {
+  return a * (2.0f * rand() / RAND_MAX - 1.0f);
+}
+
+static dyn_params_t settings(uint8_t compressor, int16_t ceiling) {
+  dyn_params_t p = {
+      .limiter = 1,
+      .compressor = compressor,
+      .ceiling = ceiling,
+      .release = 50,
+      .xover = {200, 2000},
+      .threshold = {-20 * 256, -20 * 256, -20 * 256},
+      .ratio = {4 * 256, 4 * 256, 4 * 256},
+      .attack = 5,
+      .comp_release = 100,
+  };
+  return p;
+}
+
+// noise at a level changing every few ms from far below the ceiling to
+// 12 dB over full scale, with single-sample spikes on top. returns the
+// loudest sample.
+static float32_t program(void) {
+  float32_t level = 0.0f, peak = 0.0f;
+
+  for (uint32_t i = 0; i < LEN; i++) {
+    if (rand() % 200 == 0) {
+      level = powf(10.0f, uniform(1.0f) * 0.8f - 0.2f);
+    }
+    for (uint8_t ch = 0; ch < 2; ch++) {
+      float32_t v = uniform(level);
+      if (rand() % 5000 == 0) {
+        v = uniform(4.0f);
+      }
+      x[2 * i + ch] = v;
+      peak = fabsf(v) > peak ? fabsf(v) : peak;
+    }
+  }
+  return peak;
+}
+
+// the whole program through the stage in blocks of random size, from a
+// rate change so the state is clean. returns the loudest output sample.
+static float32_t run(const dyn_params_t *p) {
+  float32_t peak = 0.0f;
+
+  CHECK(dyn_set_params(p));
+  dyn_set_rate(RATE + 1);
+  dyn_sync();
+  dyn_set_rate(RATE);
+  dyn_sync();
+  for (uint32_t i = 0; i < 2 * LEN; i++) {
+    y[i] = x[i];
+  }
+  for (uint32_t i = 0; i < LEN;) {
+    uint32_t n = 1 + rand() % (2 * FRAMES);
+    n = n < LEN - i ? n : LEN - i;
+    dyn_process(&y[2 * i], n);
+    i += n;
+  }
+  for (uint32_t i = 0; i < 2 * LEN; i++) {
+    peak = fabsf(y[i]) > peak ? fabsf(y[i]) : peak;
+  }
+  return peak;
+}
+
+// cycles of one block, host time scaled to 96 MHz
+static double bench(uint8_t compressor) {
+  dyn_params_t p = settings(compressor, -256);
+  uint64_t total = 0;
+
+  CHECK(dyn_set_params(&p));
+  dyn_sync();
+  for (uint32_t r = 0; r < RUNS; r++) {
+    uint32_t start = DWT->CYCCNT;
+    dyn_process(&y[2 * FRAMES * (r % 100)], FRAMES);
+    total += DWT->CYCCNT - start;
+  }
+  return (double)total / RUNS;
+}
+
+// random program up to 12 dB over full scale never comes out above the
+// ceiling, with or without the compressor ahead of the limiter, and the
+// meter shows the reduction the loudest peak needed. below the ceiling
+// the limiter is a plain delay. cycles are per 1 ms block.
+int main(void) {
+  static const int16_t ceilings[] = {0, -64, -6 * 256, -24 * 256};
+  dyn_meter_t meter;
+
+  srand(1);
+  dyn_init();
+  dyn_sync();
+
+  dyn_params_t bad = settings(0, 256);
+  CHECK(!dyn_set_params(&bad));
+  bad = settings(0, 0);
+  bad.xover[0] = bad.xover[1];
+  CHECK(!dyn_set_params(&bad));
+  bad = settings(0, 0);
+  bad.ratio[1] = 255;
+  CHECK(!dyn_set_params(&bad));
+
+  float32_t in_peak = program();
+  for (uint8_t c = 0; c < 2; c++) {
+    for (uint32_t i = 0; i < sizeof(ceilings) / sizeof(ceilings[0]); i++) {
+      dyn_params_t p = settings(c, ceilings[i]);
+      float32_t ceiling = powf(10.0f, ceilings[i] / (256.0f * 20.0f));
+      dyn_read_meter(&meter);
+      float32_t out_peak = run(&p);
+      dyn_read_meter(&meter);
+      double need = 20 * log10(in_peak / ceiling);
+      printf("%s ceiling %+6.2f dB: input peak %+.2f dB, output %+.4f dB, "
+             "limiter meter %.2f dB, %.2f dB needed\n",
+             c ? "compressor and limiter," : "limiter,",
+             ceilings[i] / 256.0, 20 * log10(in_peak),
+             20 * log10(out_peak), meter.limiter / 256.0, need);
+      CHECK(out_peak <= ceiling);
+      CHECK(out_peak > ceiling * 0.9f);
+      if (!c) {
+        CHECK(fabs(meter.limiter / 256.0 - need) < 0.1);
+      }
+    }
+  }
+
+  // quiet program, a frame short of a block behind
+  dyn_params_t p = settings(0, 0);
+  for (uint32_t i = 0; i < 2 * LEN; i++) {
+    x[i] = uniform(0.5f);
+  }
+  run(&p);
+  uint32_t moved = 0;
+  for (uint32_t i = 0; i < 2 * LEN; i++) {
+    moved += y[i] != (i < 2 * DELAY ? 0.0f : x[i - 2 * DELAY]);
+  }
+  dyn_read_meter(&meter);
+  CHECK(moved == 0);
+  CHECK(meter.limiter == 0);
+
+  printf("limiter %.0f, compressor and limiter %.0f cycles/block\n",
+         bench(0), bench(1));
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,156 @@
+#include "audio_ring.h"
+#include "board.h"
+#include "conceal.h"
+#include "feedback.h"
+#include "playback.h"
+#include "test.h"
+#include "vhost.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RATE 48000
+#define HALF_FRAMES (RATE / 1000 * PLAYBACK_BUFFER_MS)
+// halfword transfers per frame and per buffer
+#define FRAME_XFERS 4
+#define DMA_XFERS (2 * HALF_FRAMES * FRAME_XFERS)
+// SOFs per feedback window, as TIM2 is set up
+#define WINDOW_FRAMES 64
+#define RUN_MS 30000
+// the last part of a run, where the fill has to have settled
+#define SETTLED_MS 10000
+// the host sends the nominal rate until then, moving the fill off center
+#define IGNORE_MS 4000
+// settled within this many frames
+#define SETTLED_FRAMES 4
+
+void TIM2_IRQHandler(void);
+
+static uint8_t out_ep, fb_ep;
+
+// fill error in frames, positive when more than the ring's half and the
+// DMA buffer's average is queued ahead of the I2S
+static int32_t fill_error(void) {
+  return (int32_t)(audio_ring_fill(&audio_ring) / AUDIO_RING_FRAME_WORDS +
+                   playback_queued()) -
+         (AUDIO_RING_WORDS / 2 / AUDIO_RING_FRAME_WORDS + 3 * HALF_FRAMES / 2);
+}
+
+typedef struct {
+  int32_t err_max;    // largest fill error once settled
+  int32_t err_start;  // fill error when the host starts following
+  uint32_t settle_ms; // time to settle once the host follows
+  uint32_t fb_mean;   // mean feedback once settled, 10.14
+  uint32_t missed;
+} run_t;
+
+// the host sends what the feedback endpoint asks for, carrying the
+// fraction from frame to frame, while the I2S consumes at the nominal rate
+// off by ppm. TIM2 ends a window every 64 SOFs. for the first seconds the
+// host sends the nominal rate, so the device clock drags the fill off
+// center for the loop to pull back.
+static void run(int32_t ppm, run_t *r) {
+  static uint8_t pkt[1024];
+  uint64_t fb_total = 0;
+  uint32_t fb_acc = 0;
+  uint32_t played = 0;
+
+  memset(r, 0, sizeof(*r));
+  memset(pkt, 0x11, sizeof(pkt));
+
+  // restart the output, the feedback starts over from nominal
+  CHECK(playback_set_rate(RATE));
+  board_dma_half(&board_playback_dma, NULL);
+
+  for (uint32_t ms = 1; ms <= RUN_MS; ms++) {
+    uint8_t fb[4] = {0};
+    uint16_t len;
+
+    vhost_frame();
+    r->missed += vhost_iso_in(fb_ep, fb, &len) != OTG_ACK;
+    uint32_t value = fb[0] | (fb[1] << 8) | (fb[2] << 16);
+    if (ms <= IGNORE_MS) {
+      value = (RATE << 14) / 1000;
+    }
+    fb_acc += value;
+    uint32_t frames = fb_acc >> 14;
+    fb_acc -= frames << 14;
+    r->missed += vhost_iso_out(out_ep, pkt, frames * 4) != OTG_ACK;
+
+    // the DMA moves on by the frames played in this millisecond
+    uint32_t now = (uint32_t)((int64_t)ms * RATE * (1000000 + ppm) /
+                              1000000000);
+    while (played / HALF_FRAMES < now / HALF_FRAMES) {
+      board_dma_half(&board_playback_dma, NULL);
+      played += HALF_FRAMES - played % HALF_FRAMES;
+    }
+    played = now;
+    DMA1_Stream5->NDTR =
+        DMA_XFERS - played % (2 * HALF_FRAMES) * FRAME_XFERS;
+
+    if (ms % WINDOW_FRAMES == 0) {
+      TIM2->SR |= TIM_SR_UIF;
+      TIM2_IRQHandler();
+    }
+
+    int32_t err = abs(fill_error());
+    if (ms == IGNORE_MS) {
+      r->err_start = fill_error();
+    }
+    if (err > SETTLED_FRAMES) {
+      r->settle_ms = ms - IGNORE_MS;
+    }
+    if (ms > RUN_MS - SETTLED_MS) {
+      fb_total += value;
+      if (err > r->err_max) {
+        r->err_max = err;
+      }
+    }
+  }
+  r->fb_mean = fb_total / SETTLED_MS;
+}
+
+// with the device clock off by up to 500 ppm either way, the host
+// following the feedback keeps the ring fill at its center: it settles
+// within a few seconds and stays close, the reported rate matches the
+// device clock, and nothing is lost or resampled
+int main(void) {
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      out_ep = alt->eps[0].addr;
+      fb_ep = alt->eps[1].addr & 0x7f;
+    }
+  }
+  CHECK(out_ep != 0);
+
+  static const int32_t skews[] = {-500, -250, 0, 250, 500};
+  for (uint32_t i = 0; i < sizeof(skews) / sizeof(skews[0]); i++) {
+    uint32_t underruns = conceal_stats.underrun_cnt;
+    uint32_t overruns = audio_ring.overrun_cnt;
+    run_t r;
+
+    run(skews[i], &r);
+    double expect = RATE / 1000.0 * (1 + skews[i] * 1e-6);
+    double got = r.fb_mean / 16384.0;
+    printf("%+4d ppm: fill %+3d frames off, settled after %4u ms, within "
+           "%d frames, feedback %.4f (device %.4f)\n",
+           (int)skews[i], (int)r.err_start, (unsigned)r.settle_ms,
+           (int)r.err_max, got, expect);
+    CHECK(r.missed == 0);
+    CHECK(r.settle_ms < RUN_MS - IGNORE_MS - SETTLED_MS);
+    CHECK(r.err_max <= SETTLED_FRAMES);
+    CHECK(got - expect < 0.002 && expect - got < 0.002);
+    CHECK(playback_playing());
+    CHECK(!playback_asrc());
+    CHECK(conceal_stats.underrun_cnt == underruns);
+    CHECK(audio_ring.overrun_cnt == overruns);
+  }
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+#include "graph.h"
+#include "test.h"
+#include <arm_math.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stm32f411xe.h>
+#include <string.h>
+
+#define FRAMES 96
+#define BLOCKS 1000
+
+static int32_t in[2 * FRAMES];
+static int32_t out_graph[2 * FRAMES];
+static int32_t out_inline[2 * FRAMES];
+static float32_t work[2 * FRAMES];
+
+// the same chain written out by hand: gain, meter, -6 dB, meter
+static float32_t peaks_inline[2];
+
+static void chain_inline(int32_t *buf, uint32_t frames) {
+  static const float32_t gain[2] = {1.0f, 0.50118723f};
+
+  for (uint32_t blk = 0; blk < frames; blk += 48) {
+    uint32_t n = 2 * 48;
+    arm_q31_to_float(buf + 2 * blk, work, n);
+    for (uint8_t s = 0; s < 2; s++) {
+      float32_t max = peaks_inline[s];
+      for (uint32_t i = 0; i < n; i++) {
+        work[i] *= gain[s];
+        if (fabsf(work[i]) > max) {
+          max = fabsf(work[i]);
+        }
+      }
+      peaks_inline[s] = max;
+    }
+    arm_float_to_q31(work, buf + 2 * blk, n);
+  }
+}
+
+// a peak in 1/256 dBFS, as the meters read
+static int db256(double peak) { return (int)(20.0 * 256.0 * log10(peak)); }
+
+static void signal(double level) {
+  for (uint32_t i = 0; i < FRAMES; i++) {
+    in[2 * i] = in[2 * i + 1] =
+        (int32_t)(level * 2147483647.0 * sin(2 * M_PI * i / 48.0));
+  }
+}
+
+// the graph gives the same samples as the chain written out, at an
+// overhead measured per block, and every read of the meters starts them
+// over, whatever the audio side was doing
+int main(void) {
+  static const graph_node_t nodes[] = {
+      {GRAPH_GAIN, {0, 0}, 0, 0},
+      {GRAPH_METER, {1, 0}, 0, 0},
+      {GRAPH_GAIN, {2, 0}, 0, -6 * 256},
+      {GRAPH_METER, {3, 0}, 0, 0},
+  };
+  int16_t peaks[GRAPH_MAX_NODES];
+
+  graph_init();
+  graph_set_rate(48000);
+  CHECK(graph_set_nodes(4, nodes));
+  graph_sync();
+
+  signal(0.5);
+  // the first block ramps the gain in, its peaks are dropped
+  memcpy(out_graph, in, sizeof(in));
+  graph_process(out_graph, FRAMES);
+  graph_read_meters(peaks);
+
+  uint32_t mismatches = 0;
+  uint64_t graph_cycles = 0, inline_cycles = 0;
+  for (uint32_t b = 0; b < BLOCKS; b++) {
+    memcpy(out_graph, in, sizeof(in));
+    memcpy(out_inline, in, sizeof(in));
+
+    uint32_t start = DWT->CYCCNT;
+    graph_process(out_graph, FRAMES);
+    graph_cycles += DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    chain_inline(out_inline, FRAMES);
+    inline_cycles += DWT->CYCCNT - start;
+
+    mismatches += memcmp(out_graph, out_inline, sizeof(in)) != 0;
+  }
+  printf("%u frames: graph %.0f cycles, inlined %.0f cycles, overhead "
+         "%.1f%%\n",
+         (unsigned)FRAMES, (double)graph_cycles / BLOCKS,
+         (double)inline_cycles / BLOCKS,
+         100.0 * ((double)graph_cycles / inline_cycles - 1));
+  CHECK(mismatches == 0);
+
+  graph_read_meters(peaks);
+  CHECK(abs(peaks[1] - db256(0.5)) < 4);
+  CHECK(abs(peaks[3] - db256(0.5 * 0.50118723)) < 4);
+  CHECK(peaks[0] == INT16_MIN);
+
+  // nothing played since the read
+  graph_read_meters(peaks);
+  CHECK(peaks[1] == INT16_MIN && peaks[3] == INT16_MIN);
+
+  // quieter now, the loud peak before the read is gone
+  signal(0.125);
+  memcpy(out_graph, in, sizeof(in));
+  graph_process(out_graph, FRAMES);
+  graph_read_meters(peaks);
+  CHECK(abs(peaks[1] - db256(0.125)) < 4);
+  CHECK(abs(peaks[3] - db256(0.125 * 0.50118723)) < 4);
+
+  return TEST_RESULT();
+}
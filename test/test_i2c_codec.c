@@ -0,0 +1,107 @@
+#include "codec.h"
+#include "i2c.h"
+#include "i2c_target.h"
+#include "test.h"
+#include <stm32f411xe.h>
+
+#define CODEC_ADDR 0x94
+
+// runs the bus until nothing is left to do, returns the time it took
+static uint32_t run_idle(uint32_t max_us) {
+  uint32_t start = i2c_target_now();
+
+  do {
+    i2c_target_run(1);
+  } while (!i2c_target_idle() && i2c_target_now() - start < max_us);
+  return i2c_target_now() - start;
+}
+
+// the codec bring-up lands in the registers as one burst of repeated
+// STARTs, a transfer queued while a STOP is on the bus waits for a one-shot
+// timer instead of spinning the event interrupt or waiting on USB, and a
+// NACK drops only the transfer it hit
+int main(void) {
+  // PLAYBACK_CTL2 reset value, and a register the bring-up reads back
+  i2c_target_regs[0x0f] = 0x00;
+  i2c_target_regs[0x32] = 0x3b;
+
+  i2c_init();
+  codec_init();
+  uint32_t took = run_idle(100000);
+
+  CHECK(i2c_target_regs[0x00] == 0x00);
+  CHECK(i2c_target_regs[0x47] == 0x80);
+  CHECK(i2c_target_regs[0x32] == 0x3b);
+  CHECK(i2c_target_regs[0x04] == 0xaf);
+  CHECK(i2c_target_regs[0x05] == 0x80);
+  CHECK(i2c_target_regs[0x06] == 0x04);
+  CHECK(i2c_target_regs[0x02] == 0x9e);
+
+  uint32_t gap_max = 0;
+  for (uint32_t i = 0; i < i2c_target_log_len; i++) {
+    const i2c_target_seg_t *s = &i2c_target_log[i];
+    CHECK(!s->nack);
+    // one byte time per byte after the address, and the address itself
+    CHECK(s->end_us - s->start_us >= (1 + s->len) * 90);
+    if (i > 0 && s->start_us - i2c_target_log[i - 1].end_us > gap_max) {
+      gap_max = s->start_us - i2c_target_log[i - 1].end_us;
+    }
+  }
+  printf("bring-up: %u us, %u bus segments, %u us longest gap, %u event "
+         "interrupts\n",
+         (unsigned)took, (unsigned)i2c_target_log_len, (unsigned)gap_max,
+         (unsigned)i2c_target_stats.ev_cnt);
+
+  // a write queued while the STOP of the last one is being generated
+  i2c_xfer_t vol = {CODEC_ADDR, 0x20, 1, 0, {0x10}, NULL};
+  CHECK(i2c_submit(&vol));
+  while (!(I2C1->CR1 & I2C_CR1_STOP)) {
+    i2c_target_run(1);
+  }
+  uint32_t ev = i2c_target_stats.ev_cnt;
+  uint32_t retries = i2c_target_stats.retry_cnt;
+  uint32_t queued = i2c_target_now();
+  uint32_t segs = i2c_target_log_len;
+  vol.data[0] = 0x20;
+  CHECK(i2c_submit(&vol));
+  run_idle(10000);
+  CHECK(i2c_target_log_len == segs + 1);
+  uint32_t waited = i2c_target_log[segs].start_us - queued;
+  uint32_t ev_wait = i2c_target_stats.ev_cnt - ev;
+  printf("start behind a STOP: %u us, %u event interrupts and %u timer "
+         "interrupts for the transfer\n",
+         (unsigned)waited, (unsigned)ev_wait,
+         (unsigned)(i2c_target_stats.retry_cnt - retries));
+  CHECK(waited <= 20);
+  CHECK(i2c_target_stats.retry_cnt - retries == 1);
+  // the timer's one, then SB, ADDR, two TXE and BTF
+  CHECK(ev_wait <= 6);
+  CHECK(i2c_target_regs[0x20] == 0x20);
+
+  // nobody answers: both transfers fail, the queue moves on
+  i2c_target_addr = 0x96;
+  vol.data[0] = 0x30;
+  CHECK(i2c_submit(&vol));
+  CHECK(i2c_submit(&vol));
+  run_idle(10000);
+  CHECK(i2c_target_stats.er_cnt == 2);
+  CHECK(i2c_target_regs[0x20] == 0x20);
+  i2c_target_addr = CODEC_ADDR;
+  CHECK(i2c_submit(&vol));
+  run_idle(10000);
+  CHECK(i2c_target_regs[0x20] == 0x30);
+
+  // a host volume ramp is coalesced instead of queued write by write
+  segs = i2c_target_log_len;
+  for (int16_t v = 0; v > -50 * 256; v -= 128) {
+    codec_set_volume(v, v);
+    i2c_target_run(50);
+  }
+  run_idle(100000);
+  printf("volume ramp: 100 steps in %u bus segments\n",
+         (unsigned)(i2c_target_log_len - segs));
+  CHECK(i2c_target_log_len - segs < 100);
+  CHECK(i2c_target_regs[0x20] == (uint8_t)(-2 * 49 - 1));
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+#include "board.h"
+#include "load.h"
+#include "test.h"
+#include "usb_vendor.h"
+#include "vhost.h"
+
+#define CYCLES_PER_MS 96000
+
+// the last 1 ms tick
+static uint32_t tick;
+
+// asleep until the next tick, or the one after if the interrupt ran past
+static void wfi(void) {
+  do {
+    tick += CYCLES_PER_MS;
+  } while ((int32_t)(tick - DWT->CYCCNT) <= 0);
+  DWT->CYCCNT = tick;
+}
+
+// ms ticks, each an interrupt of the given cycles and a pass of the main
+// loop, every period-th interrupt of peak cycles instead
+static void run(uint32_t ms, uint32_t cycles, uint32_t period,
+                uint32_t peak) {
+  for (uint32_t t = 0; t < ms; t++) {
+    DWT->CYCCNT += period && t % period == 0 ? peak : cycles;
+    load_idle();
+  }
+}
+
+// the main loop sleeps between the 1 ms interrupts on a cycle counter
+// driven by hand, across its wrap: the load of each window is the time
+// the interrupts took, the longer windows the average of the 1 ms ones
+// with the peak of the second kept, and an interrupt running past the
+// next tick closes its window late
+int main(void) {
+  vhost_device_t dev;
+  load_stats_t s;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  CHECK(DBGMCU->CR & DBGMCU_CR_DBG_SLEEP);
+  CHECK(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk);
+
+  host_cycles_manual = 1;
+  host_wfi_hook = wfi;
+  tick = UINT32_MAX - 20 * CYCLES_PER_MS;
+  DWT->CYCCNT = tick;
+  load_init();
+  uint32_t windows = load_stats.window_cnt;
+
+  // a quarter, then a second of 10 % with every tenth millisecond at 90 %
+  run(1000, CYCLES_PER_MS / 4, 0, 0);
+  s = load_stats;
+  printf("steady, 1/100 %%: 1 ms %u, 100 ms %u, 1 s %u, peak %u\n",
+         (unsigned)s.load_1ms, (unsigned)s.load_100ms, (unsigned)s.load_1s,
+         (unsigned)s.max_1ms);
+  CHECK(s.window_cnt - windows == 1000);
+  CHECK(s.load_1ms == LOAD_FULL / 4);
+  CHECK(s.load_100ms == LOAD_FULL / 4);
+  CHECK(s.load_1s == LOAD_FULL / 4);
+  CHECK(s.max_1ms == LOAD_FULL / 4);
+
+  run(1000, CYCLES_PER_MS / 10, 10, CYCLES_PER_MS * 9 / 10);
+  s = load_stats;
+  printf("bursts, 1/100 %%: 1 ms %u, 100 ms %u, 1 s %u, peak %u\n",
+         (unsigned)s.load_1ms, (unsigned)s.load_100ms, (unsigned)s.load_1s,
+         (unsigned)s.max_1ms);
+  CHECK(s.load_100ms == LOAD_FULL * 18 / 100);
+  CHECK(s.load_1s == LOAD_FULL * 18 / 100);
+  CHECK(s.max_1ms == LOAD_FULL * 9 / 10);
+  CHECK(s.late_cnt == 0);
+
+  // one interrupt runs 2.5 ms, the ticks it covers are a single window
+  run(1, CYCLES_PER_MS * 5 / 2, 0, 0);
+  s = load_stats;
+  printf("stalled, 1/100 %%: 1 ms %u, %u late\n", (unsigned)s.load_1ms,
+         (unsigned)s.late_cnt);
+  CHECK(s.late_cnt == 1);
+  CHECK(s.load_1ms == LOAD_FULL * 5 / 6);
+  run(1, CYCLES_PER_MS / 10, 0, 0);
+  CHECK(load_stats.late_cnt == 1);
+
+  host_cycles_manual = 0;
+  host_wfi_hook = NULL;
+  CHECK(vhost_control(0xc0, USB_VENDOR_LOAD, 0, 0, sizeof(s), &s) ==
+        sizeof(s));
+  CHECK(s.window_cnt == load_stats.window_cnt);
+  CHECK(s.load_1s == load_stats.load_1s);
+  CHECK(vhost_control(0xc0, USB_VENDOR_LOAD, 0, 0, sizeof(s) - 1, &s) ==
+        VHOST_STALL);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,186 @@
+#include "board.h"
+#include "mic.h"
+#include "playback.h"
+#include "test.h"
+#include "usb.h"
+#include "vhost.h"
+#include <math.h>
+
+#define FRAMES 10000
+// the modulator is silent for this many samples, then plays the tone
+#define ONSET (48 * 500)
+#define TONE_HZ 1000.0
+#define TONE_LEVEL 0.5
+// the decimation filters take about this many samples to pass an edge
+#define FILTER_DELAY 64
+// capture clock offsets from the bus, far past a crystal so that the
+// packet sizes have to steer within the run
+#define PPM 3000
+
+static uint8_t spk_ep, fb_ep, mic_ep;
+static uint8_t mic_iface, mic_alt;
+
+static double phase;
+static double integ[2];
+// samples produced since the stream started, and the frame the tone began
+static uint32_t produced;
+static uint32_t onset_frame;
+static uint32_t frame;
+
+// second order sigma-delta modulator as in test_mic_pdm, the input held
+// for the bits of a sample
+static void pdm_fill(void *half, uint32_t bytes) {
+  uint16_t *pdm = half;
+  uint32_t osr = bytes * 8 / MIC_BLOCK_FRAMES;
+  double x = 0;
+
+  for (uint32_t i = 0; i < bytes * 8; i++) {
+    if (i % osr == 0) {
+      if (produced == ONSET) {
+        onset_frame = frame;
+      }
+      if (produced++ >= ONSET) {
+        x = TONE_LEVEL * sin(phase);
+        phase += 2 * M_PI * TONE_HZ / 48000;
+      }
+    }
+    double y = integ[1] >= 0 ? 1.0 : -1.0;
+    integ[0] += x - y;
+    integ[1] += integ[0] - y;
+    pdm[i / 16] = (pdm[i / 16] << 1) | (y > 0);
+  }
+}
+
+// least squares fit of the tone, the rest is noise and distortion
+static double snr_db(const int32_t *pcm, uint32_t n) {
+  double w = 2 * M_PI * TONE_HZ / 48000;
+  double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0, sum = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    sum += pcm[i];
+  }
+  double mean = sum / n;
+  for (uint32_t i = 0; i < n; i++) {
+    double s = sin(w * i), c = cos(w * i), y = pcm[i] - mean;
+    ss += s * s;
+    sc += s * c;
+    cc += c * c;
+    ys += y * s;
+    yc += y * c;
+  }
+  double det = ss * cc - sc * sc;
+  double a = (ys * cc - yc * sc) / det;
+  double b = (yc * ss - ys * sc) / det;
+  double sig = 0, err = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    double fit = a * sin(w * i) + b * cos(w * i);
+    double e = pcm[i] - mean - fit;
+    sig += fit * fit;
+    err += e * e;
+  }
+  return 10 * log10(sig / err);
+}
+
+static int32_t cap[FRAMES * 49];
+
+// the mic streams for FRAMES frames with the capture clock ppm off the
+// bus, next to the speaker and its feedback
+static void run(int32_t ppm) {
+  static uint8_t pkt[1024];
+  static const uint8_t spk[192];
+  uint32_t n = 0, lost = 0, bad_len = 0, steered = 0, fill_max = 0;
+  uint32_t blocks = 0, onset = 0, latency = 0;
+  uint16_t len;
+
+  // a new stream starts over from an empty ring
+  CHECK(vhost_set_interface(mic_iface, 0) == 0);
+  CHECK(vhost_set_interface(mic_iface, mic_alt) == 0);
+  produced = 0;
+  phase = 0;
+
+  for (frame = 0; frame < FRAMES; frame++) {
+    vhost_frame();
+    vhost_iso_out(spk_ep, spk, sizeof(spk));
+    vhost_iso_in(fb_ep, pkt, &len);
+    lost += vhost_iso_in(mic_ep, pkt, &len) != OTG_ACK;
+    if (n > 0 || len > 0) {
+      uint32_t frames = len / 2;
+      bad_len += frames < 47 || frames > 49;
+      steered += frames != 48;
+      for (uint32_t i = 0; i < frames; i++) {
+        int16_t s = pkt[2 * i] | pkt[2 * i + 1] << 8;
+        cap[n] = s << 16;
+        if (!onset && n > ONSET / 2 && fabs(s / 32768.0) > TONE_LEVEL / 4) {
+          onset = n;
+          latency = frame - onset_frame;
+        }
+        n++;
+      }
+    }
+
+    // the capture blocks the mic clock has completed by the end of the frame
+    uint32_t due = (uint64_t)(frame + 1) * (1000000 + ppm) / 1000000;
+    while (blocks < due) {
+      board_dma_half(&board_mic_dma, pdm_fill);
+      blocks++;
+    }
+    if (audio_ring_fill(&mic_ring) > fill_max) {
+      fill_max = audio_ring_fill(&mic_ring);
+    }
+    if (frame % PLAYBACK_BUFFER_MS == 1) {
+      board_dma_half(&board_playback_dma, NULL);
+    }
+  }
+
+  uint32_t held = produced - n - audio_ring_fill(&mic_ring);
+  double snr = snr_db(&cap[onset + FILTER_DELAY], n - onset - FILTER_DELAY);
+  printf("%+5d ppm: %u samples, %u steered packets, ring up to %u, onset "
+         "after %u samples, %u ms, SNR %.1f dB\n",
+         (int)ppm, (unsigned)n, (unsigned)steered, (unsigned)fill_max,
+         (unsigned)(onset - ONSET), (unsigned)latency, snr);
+  CHECK(lost == 0);
+  CHECK(bad_len == 0);
+  CHECK(usb_stats.iso_in[mic_ep].dropped_cnt == 0);
+  // nothing lost or repeated: what was produced is in the capture, the
+  // ring, the TX FIFO or the packet staged behind it
+  CHECK(held <= 2 * 49);
+  CHECK(onset >= ONSET && onset < ONSET + FILTER_DELAY);
+  CHECK(latency <= 5);
+  CHECK(fill_max <= 4 * MIC_BLOCK_FRAMES);
+  CHECK(ppm != 0 || steered == 0);
+  CHECK(ppm == 0 || steered > 0);
+  // a slip of one sample would show as a phase step in the fit
+  CHECK(snr > 60);
+}
+
+// the mic interface streams at 1 ms packets alongside the speaker: a 1 kHz
+// tone switched on at a known sample reaches the host at that sample of
+// the capture, a few milliseconds after the modulator produced it, and the
+// packet sizes follow a capture clock off the bus without a sample lost
+int main(void) {
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (spk_ep == 0 && alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      spk_ep = alt->eps[0].addr;
+      fb_ep = alt->eps[1].addr & 0x7f;
+    } else if (mic_ep == 0 && alt->num_eps == 1 &&
+               (alt->eps[0].addr & 0x80) && (alt->eps[0].attr & 0x03) == 1) {
+      mic_iface = alt->iface;
+      mic_alt = alt->alt;
+      mic_ep = alt->eps[0].addr & 0x7f;
+    }
+  }
+  CHECK(spk_ep != 0 && mic_ep != 0);
+
+  run(0);
+  run(PPM);
+  run(-PPM);
+
+  return TEST_RESULT();
+}
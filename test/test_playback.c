@@ -0,0 +1,132 @@
+#include "audio_ring.h"
+#include "board.h"
+#include "conceal.h"
+#include "playback.h"
+#include "prof.h"
+#include "test.h"
+
+#define RATE 48000
+#define HALF_FRAMES (RATE / 1000 * PLAYBACK_BUFFER_MS)
+
+static uint32_t frames_in;
+
+// a ramp on the left channel and its negative on the right, far enough
+// below full scale for the processing to leave it alone
+static int32_t sample(uint32_t frame, uint8_t ch) {
+  int32_t v = (int32_t)((frame & 0xffff) << 12);
+  return ch ? -v : v;
+}
+
+static void produce(uint32_t frames) {
+  audio_ring_span_t span;
+
+  CHECK(audio_ring_reserve(&audio_ring, frames * 2, &span));
+  for (uint8_t s = 0; s < 2; s++) {
+    for (uint32_t i = 0; i < span.len[s]; i++) {
+      uint32_t word = frames_in * 2 + i + (s ? span.len[0] : 0);
+      span.ptr[s][i] = sample(word / 2, word & 1);
+    }
+  }
+  audio_ring_commit(&audio_ring, frames * 2);
+  frames_in += frames;
+}
+
+// the I2S takes the halfwords of a sample MSB first
+static int32_t out_sample(const uint32_t *half, uint32_t frame, uint8_t ch) {
+  uint32_t w = half[2 * frame + ch];
+  return (int32_t)((w >> 16) | (w << 16));
+}
+
+// the DMA goes through its halves while the host keeps the ring fed at
+// the nominal rate: the output starts once the ring is half full, fades
+// in, then plays every frame in order across the half boundaries. when
+// the host stops it fades out to silence before the ring runs dry, and
+// comes back the same way.
+int main(void) {
+  board_init();
+  CHECK(playback_rate() == RATE);
+
+  // two packets per half, the first half runs before anything is queued
+  uint32_t halves = 0;
+  uint32_t prev_frame = 0;
+  uint32_t bad = 0;
+  uint32_t checked = 0;
+  uint8_t synced = 0;
+  uint32_t faded_in = 0;
+  for (; halves < 200; halves++) {
+    // the half the output faded in is not checked, nor the next one, into
+    // which the limiter's look-ahead carries the end of the fade
+    faded_in += conceal_gain() == conceal_fade_frames();
+    produce(HALF_FRAMES);
+    board_dma_half(&board_playback_dma, NULL);
+    if (faded_in < 2) {
+      continue;
+    }
+
+    const uint32_t *half = board_dma_last(&board_playback_dma);
+    for (uint32_t i = 0; i < HALF_FRAMES; i++) {
+      int32_t l = out_sample(half, i, 0);
+      uint32_t frame = (uint32_t)l >> 12;
+      if (synced && frame != ((prev_frame + 1) & 0xffff)) {
+        bad++;
+      }
+      bad += out_sample(half, i, 1) != -l;
+      prev_frame = frame;
+      synced = 1;
+      checked++;
+    }
+  }
+  CHECK(conceal_stats.resume_cnt == 1);
+  CHECK(conceal_stats.underrun_cnt == 0);
+  CHECK(board_playback_dma.total == 2 * HALF_FRAMES * 4);
+  CHECK(playback_position() == halves * HALF_FRAMES);
+  printf("%u halves, %u frames checked, %u out of order, ring %u words\n",
+         (unsigned)halves, (unsigned)checked, (unsigned)bad,
+         (unsigned)audio_ring_fill(&audio_ring));
+  CHECK(bad == 0);
+  CHECK(checked > 150 * HALF_FRAMES);
+
+  // the host goes quiet: the ring drains, the output fades out without a
+  // step and stays silent. no frame drops by more than a fade step from
+  // the loudest sample.
+  int32_t peak = 0;
+  int32_t drop_max = 0;
+  int32_t last = out_sample(board_dma_last(&board_playback_dma),
+                            HALF_FRAMES - 1, 0);
+  for (uint32_t h = 0; h < 20; h++) {
+    board_dma_half(&board_playback_dma, NULL);
+    const uint32_t *half = board_dma_last(&board_playback_dma);
+    for (uint32_t i = 0; i < HALF_FRAMES; i++) {
+      int32_t l = out_sample(half, i, 0);
+      if (l > peak) {
+        peak = l;
+      }
+      if (last - l > drop_max) {
+        drop_max = last - l;
+      }
+      last = l;
+    }
+  }
+  CHECK(!playback_playing());
+  CHECK(conceal_stats.underrun_cnt == 1);
+  CHECK(conceal_stats.cut_cnt == 0);
+  CHECK(last == 0);
+  printf("fade out: largest drop %.2f fade steps\n",
+         (double)drop_max * conceal_fade_frames() / peak);
+  CHECK(drop_max <= peak / (int32_t)conceal_fade_frames() + (1 << 12));
+
+  // and back
+  for (uint32_t h = 0; h < 40; h++) {
+    produce(HALF_FRAMES);
+    board_dma_half(&board_playback_dma, NULL);
+  }
+  CHECK(playback_playing());
+  CHECK(conceal_stats.resume_cnt == 2);
+
+  prof_stats_t stats;
+  prof_read(PROF_PLAYBACK, &stats, 0);
+  printf("refill: %u calls, %u cycles max\n", (unsigned)stats.count,
+         (unsigned)stats.max);
+
+  return TEST_RESULT();
+}
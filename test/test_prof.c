@@ -0,0 +1,145 @@
+#include "board.h"
+#include "playback.h"
+#include "prof.h"
+#include "test.h"
+#include "usb_vendor.h"
+#include "vhost.h"
+
+#define RATE 48000
+#define PACKET_FRAMES (RATE / 1000)
+#define RUNS 100000
+// a probe nothing in the default graph records
+#define SPARE PROF_GRAPH_MIX
+
+static uint8_t out_ep;
+
+static int read_probe(uint8_t probe, uint8_t reset, prof_stats_t *s) {
+  return vhost_control(0xc0, USB_VENDOR_PROF, reset, probe,
+                       sizeof(prof_stats_t), s);
+}
+
+static uint32_t hist_sum(const prof_stats_t *s) {
+  uint32_t sum = 0;
+
+  for (uint8_t i = 0; i < PROF_BUCKETS; i++) {
+    sum += s->hist[i];
+  }
+  return sum;
+}
+
+// bucket a single run of the given length lands in
+static int bucket_of(uint32_t cycles) {
+  prof_stats_t s;
+
+  CHECK(read_probe(SPARE, 1, &s) == sizeof(s));
+  prof_record(SPARE, cycles);
+  CHECK(read_probe(SPARE, 0, &s) == sizeof(s));
+  for (uint8_t i = 0; i < PROF_BUCKETS; i++) {
+    if (s.hist[i]) {
+      return s.hist[i] == 1 && s.count == 1 ? i : -1;
+    }
+  }
+  return -1;
+}
+
+// the buckets double from 2^PROF_BUCKET_SHIFT cycles with the extremes
+// open ended, the statistics are read and reset over the vendor request
+// and the reset waits for the next record. while streaming every probe on
+// the way counts each run, the histograms hold every run. the cost of a
+// record is in host time scaled to 96 MHz.
+int main(void) {
+  prof_stats_t s;
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+
+  CHECK(bucket_of(0) == 0);
+  CHECK(bucket_of((1 << PROF_BUCKET_SHIFT) - 1) == 0);
+  CHECK(bucket_of(1 << PROF_BUCKET_SHIFT) == 1);
+  CHECK(bucket_of((2 << PROF_BUCKET_SHIFT) - 1) == 1);
+  CHECK(bucket_of(2 << PROF_BUCKET_SHIFT) == 2);
+  CHECK(bucket_of(96000) == 12);
+  CHECK(bucket_of(1u << (PROF_BUCKET_SHIFT + PROF_BUCKETS - 2)) ==
+        PROF_BUCKETS - 1);
+  CHECK(bucket_of(UINT32_MAX) == PROF_BUCKETS - 1);
+
+  CHECK(read_probe(SPARE, 1, &s) == sizeof(s));
+  prof_record(SPARE, 100);
+  prof_record(SPARE, 300);
+  prof_record(SPARE, 200);
+  CHECK(read_probe(SPARE, 1, &s) == sizeof(s));
+  CHECK(s.count == 3 && s.min == 100 && s.max == 300 && s.last == 200);
+  CHECK(s.total == 600 && hist_sum(&s) == 3);
+  // the reset is only taken with the next record
+  CHECK(read_probe(SPARE, 0, &s) == sizeof(s));
+  CHECK(s.count == 3);
+  prof_record(SPARE, 50);
+  CHECK(read_probe(SPARE, 0, &s) == sizeof(s));
+  CHECK(s.count == 1 && s.min == 50 && s.max == 50 && s.total == 50);
+
+  CHECK(read_probe(PROF_NUM_PROBES, 0, &s) == VHOST_STALL);
+  CHECK(vhost_control(0xc0, USB_VENDOR_PROF, 0, 0, sizeof(s) - 1, &s) ==
+        VHOST_STALL);
+
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      out_ep = alt->eps[0].addr;
+    }
+  }
+  CHECK(out_ep != 0);
+  for (uint8_t p = 0; p < PROF_NUM_PROBES; p++) {
+    CHECK(read_probe(p, 1, &s) == sizeof(s));
+  }
+
+  static const int16_t pkt[2 * PACKET_FRAMES];
+  uint32_t halves = 0;
+  for (uint32_t t = 0; t < 200; t++) {
+    vhost_frame();
+    CHECK(vhost_iso_out(out_ep, pkt, sizeof(pkt)) == OTG_ACK);
+    if (otg_frame() % PLAYBACK_BUFFER_MS == 0) {
+      board_dma_half(&board_playback_dma, NULL);
+      halves++;
+    }
+  }
+
+  uint32_t bad = 0;
+  for (uint8_t p = 0; p < PROF_NUM_PROBES; p++) {
+    CHECK(read_probe(p, 0, &s) == sizeof(s));
+    // the spare one still holds its last run, its reset never got taken
+    if (s.count == 0 || p == SPARE) {
+      continue;
+    }
+    printf("%-12s %6u runs, %6u min, %8.1f mean, %6u max, buckets",
+           prof_names[p], (unsigned)s.count, (unsigned)s.min,
+           (double)s.total / s.count, (unsigned)s.max);
+    for (uint8_t i = 0; i < PROF_BUCKETS; i++) {
+      if (s.hist[i]) {
+        printf(" %u:%u", (unsigned)i, (unsigned)s.hist[i]);
+      }
+    }
+    printf("\n");
+    bad += hist_sum(&s) != s.count;
+    bad += s.min > s.max || s.last < s.min || s.last > s.max;
+    bad += s.total < (uint64_t)s.min * s.count;
+    bad += s.total > (uint64_t)s.max * s.count;
+  }
+  CHECK(bad == 0);
+  CHECK(read_probe(PROF_PLAYBACK, 0, &s) == sizeof(s));
+  CHECK(s.count == halves);
+  CHECK(read_probe(PROF_USB, 0, &s) == sizeof(s));
+  CHECK(s.count >= 200);
+
+  uint32_t start = DWT->CYCCNT;
+  for (uint32_t r = 0; r < RUNS; r++) {
+    PROF_BEGIN(probe);
+    PROF_END(SPARE, probe);
+  }
+  printf("begin and end: %.1f cycles\n",
+         (double)(DWT->CYCCNT - start) / RUNS);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,141 @@
+#include "audio_ring.h"
+#include "board.h"
+#include "feedback.h"
+#include "playback.h"
+#include "test.h"
+#include "usb.h"
+#include "vhost.h"
+#include <string.h>
+
+#define UAC2_CUR 0x01
+#define SAM_FREQ (0x01 << 8)
+
+static vhost_device_t dev;
+static uint8_t out_ep, fb_ep;
+static uint32_t missed;
+static uint32_t preempt_rate;
+
+static int set_rate(uint32_t rate) {
+  uint8_t buf[4] = {rate, rate >> 8, rate >> 16, rate >> 24};
+  return vhost_control(0x21, UAC2_CUR, SAM_FREQ, dev.clock_id << 8, 4, buf);
+}
+
+static uint32_t get_rate(void) {
+  uint8_t buf[4] = {0};
+  vhost_control(0xa1, UAC2_CUR, SAM_FREQ, dev.clock_id << 8, 4, buf);
+  return buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+// a request landing while the DMA interrupt waits for the PLL to lock
+static void preempt(void) {
+  host_pll_lock_hook = NULL;
+  CHECK(set_rate(preempt_rate) == 4);
+}
+
+// a millisecond of 16-bit stereo at the host's rate, the output stage
+// consuming a half-buffer every PLAYBACK_BUFFER_MS
+static void stream(uint32_t ms) {
+  static uint8_t pkt[1024];
+
+  memset(pkt, 0x11, sizeof(pkt));
+  for (uint32_t f = 0; f < ms; f++) {
+    uint8_t fb[4];
+    uint16_t len;
+
+    vhost_frame();
+    missed += vhost_iso_out(out_ep, pkt, playback_rate() / 1000 * 4) != OTG_ACK;
+    missed += vhost_iso_in(fb_ep, fb, &len) != OTG_ACK;
+    if (f % PLAYBACK_BUFFER_MS == PLAYBACK_BUFFER_MS - 1) {
+      board_dma_half(&board_playback_dma, NULL);
+    }
+  }
+}
+
+// SET CUR SAM_FREQ completes without touching the clocks, the output and
+// feedback switch over at the next playback DMA interrupt, the mic at its
+// next block after that, and
+// streaming at the new rate loses nothing. a request that lands while the
+// output restarts is applied by the next interrupt.
+int main(void) {
+  uint32_t plls[4], i2sprs[4];
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      out_ep = alt->eps[0].addr;
+      fb_ep = alt->eps[1].addr & 0x7f;
+    }
+  }
+  CHECK(out_ep != 0);
+
+  stream(100);
+  CHECK(playback_playing());
+
+  static const uint32_t rates[] = {96000, 44100, 88200, 48000};
+  for (uint32_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+    uint32_t pll = RCC->PLLI2SCFGR;
+    uint32_t i2spr = SPI3->I2SPR;
+    uint32_t mic_i2spr = SPI2->I2SPR;
+    uint32_t overruns = audio_ring.overrun_cnt;
+
+    usb_stats.cycles_max = 0;
+    uint64_t start = vhost_now();
+    CHECK(set_rate(rates[i]) == 4);
+    uint64_t took = vhost_now() - start;
+    uint32_t isr_max = usb_stats.cycles_max;
+
+    // accepted but not applied yet
+    CHECK(get_rate() == rates[i]);
+    CHECK(playback_rate() == rates[i]);
+    CHECK(RCC->PLLI2SCFGR == pll);
+    CHECK(SPI3->I2SPR == i2spr);
+    CHECK(SPI2->I2SPR == mic_i2spr);
+
+    board_dma_half(&board_playback_dma, NULL);
+    CHECK(RCC->PLLI2SCFGR != pll);
+    CHECK(SPI3->I2SPR != i2spr);
+    // the mic restarts at its own next block
+    board_dma_half(&board_mic_dma, NULL);
+    CHECK(SPI2->I2SPR != mic_i2spr);
+    CHECK(feedback_value() == (rates[i] << 14) / 1000);
+
+    stream(200);
+    CHECK(playback_playing());
+    CHECK(audio_ring.overrun_cnt == overruns);
+    plls[i] = RCC->PLLI2SCFGR;
+    i2sprs[i] = SPI3->I2SPR;
+
+    printf("%u Hz: request %llu us, %u ISR cycles max, I2S prescaler %u\n",
+           (unsigned)rates[i], (unsigned long long)took, (unsigned)isr_max,
+           (unsigned)playback_i2s_prescaler());
+  }
+
+  // a rate without clock setting is refused and changes nothing
+  CHECK(set_rate(32000) == VHOST_STALL);
+  CHECK(playback_rate() == 48000);
+
+  // to 96 kHz, with 44.1 kHz requested during the restart
+  CHECK(set_rate(rates[0]) == 4);
+  preempt_rate = rates[1];
+  host_pll_lock_hook = preempt;
+  board_dma_half(&board_playback_dma, NULL);
+  CHECK(host_pll_lock_hook == NULL);
+  CHECK(playback_rate() == rates[1]);
+  CHECK(SPI3->I2SPR == i2sprs[0]);
+  board_dma_half(&board_playback_dma, NULL);
+  CHECK(RCC->PLLI2SCFGR == plls[1]);
+  CHECK(SPI3->I2SPR == i2sprs[1]);
+  board_dma_half(&board_mic_dma, NULL);
+  CHECK(feedback_value() == (rates[1] << 14) / 1000);
+  stream(200);
+  CHECK(playback_playing());
+
+  printf("%u packets missed\n", (unsigned)missed);
+  CHECK(missed == 0);
+  return TEST_RESULT();
+}
@@ -0,0 +1,107 @@
+#include "board.h"
+#include "spectrum.h"
+#include "test.h"
+#include "usb.h"
+#include "vhost.h"
+#include <math.h>
+#include <string.h>
+
+#define RATE 48000
+#define BLOCK_FRAMES 96
+#define TONE_HZ 1000.0
+// -6 dBFS
+#define TONE_LEVEL 0.5
+// 1/3-octave band centered on 1 kHz
+#define TONE_BAND 17
+
+void SPI4_IRQHandler(void);
+
+static double phase;
+static spectrum_report_t report;
+static uint32_t reports;
+
+static void feed(uint32_t frames) {
+  int32_t buf[2 * BLOCK_FRAMES];
+
+  for (uint32_t i = 0; i < frames; i++) {
+    int32_t s = (int32_t)(TONE_LEVEL * 2147483647.0 * sin(phase));
+    buf[2 * i] = buf[2 * i + 1] = s;
+    phase += 2 * M_PI * TONE_HZ / RATE;
+  }
+  spectrum_feed(SPECTRUM_PLAYBACK, buf, frames, 2);
+}
+
+// the background frame runs once the audio side has pended it, the host
+// picks up the report in the next frame
+static void step(void) {
+  uint8_t buf[64];
+  uint16_t len;
+
+  feed(BLOCK_FRAMES);
+  if (host_nvic_take(SPI4_IRQn)) {
+    SPI4_IRQHandler();
+  }
+  vhost_frame();
+  if (otg_in(USB_REPORT_EP, buf, &len) == OTG_ACK) {
+    memcpy(&report, buf, sizeof(report));
+    reports++;
+  }
+  vhost_irq();
+}
+
+static uint8_t preempt;
+
+// the audio interrupt lands while the frame is being copied and writes
+// over all of it
+static void feed_during_copy(void) {
+  if (preempt) {
+    preempt = 0;
+    for (uint32_t i = 0; i < SPECTRUM_MAX_SIZE / BLOCK_FRAMES + 2; i++) {
+      feed(BLOCK_FRAMES);
+    }
+  }
+}
+
+// a tone shows in its band at its level for every FFT size, with the cost
+// of a frame, and a frame overwritten while it is copied is dropped
+int main(void) {
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+
+  for (uint16_t size = SPECTRUM_MIN_SIZE; size <= SPECTRUM_MAX_SIZE;
+       size *= 2) {
+    spectrum_config_t config = {SPECTRUM_PLAYBACK, 0, size, 10};
+    CHECK(spectrum_set_config(&config));
+    reports = 0;
+    for (uint32_t i = 0; i < 100; i++) {
+      step();
+    }
+
+    double level = report.band[TONE_BAND] / 256.0;
+    double below = report.band[TONE_BAND - 3] / 256.0;
+    double above = report.band[TONE_BAND + 3] / 256.0;
+    printf("%u points: %u reports, 1 kHz band %.2f dB, 500 Hz %.1f dB, "
+           "2 kHz %.1f dB, %u cycles/frame\n",
+           (unsigned)size, (unsigned)reports, level, below, above,
+           (unsigned)spectrum_stats.cycles_last);
+    CHECK(reports >= 15);
+    // at 256 points the band holds a single bin, off the tone's peak
+    CHECK(fabs(level + 6.02) < (size == SPECTRUM_MIN_SIZE ? 3.0 : 0.5));
+    CHECK(below < -30 && above < -30);
+  }
+
+  uint32_t late = spectrum_stats.late_cnt;
+  uint32_t frames = spectrum_stats.frame_cnt;
+  host_barrier_hook = feed_during_copy;
+  for (uint32_t i = 0; i < 100 && spectrum_stats.late_cnt == late; i++) {
+    preempt = 1;
+    step();
+  }
+  host_barrier_hook = NULL;
+  CHECK(spectrum_stats.late_cnt == late + 1);
+  CHECK(spectrum_stats.frame_cnt == frames);
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,271 @@
+#include "board.h"
+#include "dyn.h"
+#include "peq.h"
+#include "test.h"
+#include "usb.h"
+#include "usb_desc.h"
+#include "usb_vendor.h"
+#include "vhost.h"
+#include <string.h>
+
+#define EP0_MPS 64
+#define STALL (-1)
+#define NAK_LIMIT 100
+
+// one control transfer, SETUP as the host puts it on the bus. data is
+// sent for OUT, checked against the reply for IN when given. the length
+// of the data stage, or STALL in either stage.
+typedef struct {
+  uint8_t setup[8];
+  int16_t result;
+  const uint8_t *data;
+} ctrl_t;
+
+static uint32_t packets;
+
+static otg_result_t ep0_in(uint8_t *pkt, uint16_t *len) {
+  otg_result_t r = OTG_NAK;
+
+  for (uint32_t i = 0; i < NAK_LIMIT && r == OTG_NAK; i++) {
+    r = otg_in(0, pkt, len);
+    vhost_irq();
+    if (r == OTG_NAK) {
+      vhost_frame();
+    }
+  }
+  return r;
+}
+
+static otg_result_t ep0_out(const uint8_t *pkt, uint16_t len) {
+  otg_result_t r = OTG_NAK;
+
+  for (uint32_t i = 0; i < NAK_LIMIT && r == OTG_NAK; i++) {
+    r = otg_out(0, pkt, len);
+    vhost_irq();
+    if (r == OTG_NAK) {
+      vhost_frame();
+    }
+  }
+  return r;
+}
+
+// the transaction level, so every data packet is counted, a ZLP included
+static int xfer(const uint8_t *setup, uint8_t *data) {
+  uint16_t length = setup[6] | (setup[7] << 8);
+  uint16_t done = 0;
+  otg_result_t r;
+
+  packets = 0;
+  otg_setup(setup);
+  vhost_irq();
+
+  if (length != 0 && (setup[0] & 0x80)) {
+    for (;;) {
+      uint8_t pkt[EP0_MPS];
+      uint16_t n;
+      if ((r = ep0_in(pkt, &n)) != OTG_ACK) {
+        return r == OTG_STALL ? STALL : -2;
+      }
+      packets++;
+      memcpy(data + done, pkt, n);
+      done += n;
+      if (n < EP0_MPS || done == length) {
+        break;
+      }
+    }
+    r = ep0_out(NULL, 0);
+  } else {
+    while (done < length) {
+      uint16_t n = length - done > EP0_MPS ? EP0_MPS : length - done;
+      if ((r = ep0_out(data + done, n)) != OTG_ACK) {
+        return r == OTG_STALL ? STALL : -2;
+      }
+      packets++;
+      done += n;
+    }
+    uint8_t zlp[EP0_MPS];
+    uint16_t n;
+    r = ep0_in(zlp, &n);
+    if (r == OTG_ACK && n != 0) {
+      return -2;
+    }
+  }
+
+  if (r != OTG_ACK) {
+    return r == OTG_STALL ? STALL : -2;
+  }
+  return done;
+}
+
+#define LE16(v) (v) & 0xff, (v) >> 8
+#define CLOCK LE16(USB_AUDIO_CLOCK_ID << 8)
+#define FU LE16(USB_AUDIO_FU_ID << 8)
+
+static const uint8_t rate_48k[] = {0x80, 0xbb, 0x00, 0x00};
+static const uint8_t volume_m10db[] = {0x00, 0xf6};
+static const uint8_t self_powered[] = {0x01, 0x00};
+static const uint8_t halted[] = {0x01, 0x00};
+static const uint8_t not_halted[] = {0x00, 0x00};
+static const uint8_t config_1[] = {0x01};
+static const uint8_t alt_1[] = {0x01};
+static const uint8_t lang[] = {0x04, 0x03, 0x09, 0x04};
+// a ceiling over full scale
+static const dyn_params_t bad_dyn = {.limiter = 1, .ceiling = 256};
+static uint8_t bands[PEQ_MAX_BANDS * sizeof(peq_band_t)];
+
+// the requests a class driver sends once the device has its address:
+// descriptors at the lengths Windows and Linux ask for, the standard
+// requests the old handler stalled, the UAC2 controls, a stream opened
+// and an endpoint halted and cleared
+static const ctrl_t driver_trace[] = {
+    {{0x80, 0x06, LE16(0x0100), LE16(0), LE16(18)}, 18, NULL},
+    {{0x80, 0x06, LE16(0x0200), LE16(0), LE16(9)}, 9, NULL},
+    {{0x80, 0x06, LE16(0x0200), LE16(0), LE16(255)}, 255, NULL},
+    {{0x80, 0x06, LE16(0x0200), LE16(0), LE16(128)}, 128, NULL},
+    {{0x80, 0x06, LE16(0x0200), LE16(0), LE16(0x1000)}, 411, NULL},
+    // full speed only, no qualifier
+    {{0x80, 0x06, LE16(0x0600), LE16(0), LE16(10)}, STALL, NULL},
+    {{0x80, 0x06, LE16(0x0300), LE16(0), LE16(255)}, 4, lang},
+    {{0x80, 0x06, LE16(0x0302), LE16(0x0409), LE16(255)}, 34, NULL},
+    {{0x80, 0x06, LE16(0x0309), LE16(0x0409), LE16(255)}, STALL, NULL},
+    {{0x80, 0x00, LE16(0), LE16(0), LE16(2)}, 2, self_powered},
+    {{0x00, 0x09, LE16(1), LE16(0), LE16(0)}, 0, NULL},
+    {{0x80, 0x08, LE16(0), LE16(0), LE16(1)}, 1, config_1},
+    {{0x81, 0x00, LE16(0), LE16(USB_AS_INTERFACE), LE16(2)}, 2, not_halted},
+    {{0x81, 0x00, LE16(0), LE16(USB_NUM_INTERFACES), LE16(2)}, STALL, NULL},
+    // sampling frequency: number of ranges, the ranges, current, valid
+    {{0xa1, 0x02, LE16(0x0100), CLOCK, LE16(2)}, 2, NULL},
+    {{0xa1, 0x02, LE16(0x0100), CLOCK, LE16(50)}, 50, NULL},
+    {{0xa1, 0x01, LE16(0x0100), CLOCK, LE16(4)}, 4, rate_48k},
+    {{0xa1, 0x01, LE16(0x0200), CLOCK, LE16(1)}, 1, NULL},
+    {{0x21, 0x01, LE16(0x0100), CLOCK, LE16(4)}, 4, rate_48k},
+    // master mute and volume, set and read back
+    {{0xa1, 0x01, LE16(0x0100), FU, LE16(1)}, 1, NULL},
+    {{0xa1, 0x02, LE16(0x0200), FU, LE16(8)}, 8, NULL},
+    {{0x21, 0x01, LE16(0x0200), FU, LE16(2)}, 2, volume_m10db},
+    {{0xa1, 0x01, LE16(0x0200), FU, LE16(2)}, 2, volume_m10db},
+    // no such control
+    {{0xa1, 0x01, LE16(0x0700), FU, LE16(2)}, STALL, NULL},
+    {{0x01, 0x0b, LE16(1), LE16(USB_AS_INTERFACE), LE16(0)}, 0, NULL},
+    {{0x81, 0x0a, LE16(0), LE16(USB_AS_INTERFACE), LE16(1)}, 1, alt_1},
+    {{0x01, 0x0b, LE16(USB_AS_NUM_ALTS), LE16(USB_AS_INTERFACE), LE16(0)},
+     STALL, NULL},
+    {{0x02, 0x03, LE16(0), LE16(0x80 | USB_REPORT_EP), LE16(0)}, 0, NULL},
+    {{0x82, 0x00, LE16(0), LE16(0x80 | USB_REPORT_EP), LE16(2)}, 2, halted},
+    {{0x02, 0x01, LE16(0), LE16(0x80 | USB_REPORT_EP), LE16(0)}, 0, NULL},
+    {{0x82, 0x00, LE16(0), LE16(0x80 | USB_REPORT_EP), LE16(2)}, 2,
+     not_halted},
+    {{0x02, 0x03, LE16(0), LE16(USB_NUM_EPS), LE16(0)}, STALL, NULL},
+    {{0x01, 0x0b, LE16(0), LE16(USB_AS_INTERFACE), LE16(0)}, 0, NULL},
+    {{0x80, 0xff, LE16(0), LE16(0), LE16(64)}, STALL, NULL},
+    {{0x00, 0x09, LE16(2), LE16(0), LE16(0)}, STALL, NULL},
+    {{0x80, 0x08, LE16(0), LE16(0), LE16(1)}, 1, config_1},
+};
+
+// vendor requests with data stages over one packet in both directions,
+// one refused at SETUP and one whose data is refused at the status stage
+static const ctrl_t vendor_trace[] = {
+    {{0x40, USB_VENDOR_PEQ, LE16(0), LE16(0), LE16(sizeof(bands))},
+     sizeof(bands), bands},
+    {{0xc0, USB_VENDOR_PEQ, LE16(0), LE16(0), LE16(sizeof(bands))},
+     sizeof(bands), bands},
+    {{0x40, USB_VENDOR_PEQ, LE16(0), LE16(PEQ_MAX_BANDS - 1), LE16(16)},
+     STALL, NULL},
+    {{0x41, USB_VENDOR_PEQ, LE16(0), LE16(0), LE16(8)}, STALL, NULL},
+    {{0x40, USB_VENDOR_DYN, LE16(0), LE16(0), LE16(sizeof(bad_dyn))}, STALL,
+     (const uint8_t *)&bad_dyn},
+    {{0xc0, USB_VENDOR_PEQ, LE16(0), LE16(0), LE16(8)}, 8, bands},
+};
+
+// the transfers go through as listed, IN data stages end with a short
+// packet, or a ZLP when they stop short of wLength on a packet boundary
+static uint32_t replay(const char *name, const ctrl_t *trace, uint32_t n) {
+  uint32_t stalls = 0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    const ctrl_t *c = &trace[i];
+    uint16_t length = c->setup[6] | (c->setup[7] << 8);
+    uint8_t buf[0x1000];
+    int ret;
+
+    memset(buf, 0xee, sizeof(buf));
+    if (c->data != NULL && !(c->setup[0] & 0x80)) {
+      memcpy(buf, c->data, length);
+    }
+    ret = xfer(c->setup, buf);
+    if (ret != c->result) {
+      printf("%s %u: %02x %02x wValue %04x wIndex %04x: got %d, want %d\n",
+             name, (unsigned)i, c->setup[0], c->setup[1],
+             c->setup[2] | (c->setup[3] << 8),
+             c->setup[4] | (c->setup[5] << 8), ret, c->result);
+    }
+    CHECK(ret == c->result);
+    if (ret == STALL) {
+      stalls++;
+      continue;
+    }
+
+    if (c->setup[0] & 0x80) {
+      uint32_t want = (ret + EP0_MPS - 1) / EP0_MPS;
+      if (ret < length && ret % EP0_MPS == 0) {
+        want++;
+      }
+      CHECK(packets == (ret == 0 ? 1 : want));
+      if (c->data != NULL) {
+        CHECK(memcmp(buf, c->data, ret) == 0);
+      }
+    }
+  }
+  printf("%s: %u transfers, %u stalled\n", name, (unsigned)n,
+         (unsigned)stalls);
+  return stalls;
+}
+
+// recorded SETUP sequences replayed against the OTG model, one
+// transaction at a time, after the device was enumerated: every request a
+// driver needs is answered, the ones that should stall do, and a stall
+// never outlives its transfer
+int main(void) {
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+
+  uint32_t nak = vhost_stats.nak_cnt;
+  replay("driver", driver_trace, sizeof(driver_trace) / sizeof(ctrl_t));
+
+  for (uint8_t i = 0; i < PEQ_MAX_BANDS; i++) {
+    peq_band_t b = {PEQ_PEAK, 0, 100 * (i + 1), -256 * i, 0x0b50};
+    memcpy(&bands[i * sizeof(b)], &b, sizeof(b));
+  }
+  replay("vendor", vendor_trace, sizeof(vendor_trace) / sizeof(ctrl_t));
+  CHECK(vhost_stats.nak_cnt == nak);
+
+  // the host gives up on a transfer halfway through its data stage, the
+  // next SETUP starts over
+  static const uint8_t get_config[8] = {0x80, 0x06, LE16(0x0200), LE16(0),
+                                        LE16(411)};
+  static const uint8_t get_status[8] = {0x80, 0x00, LE16(0), LE16(0),
+                                        LE16(2)};
+  uint8_t pkt[EP0_MPS];
+  uint16_t len;
+  otg_setup(get_config);
+  vhost_irq();
+  CHECK(ep0_in(pkt, &len) == OTG_ACK && len == EP0_MPS);
+  CHECK(xfer(get_status, pkt) == 2);
+  CHECK(pkt[0] == 0x01);
+  uint8_t config[0x1000];
+  CHECK(xfer(get_config, config) == 411);
+  CHECK(packets == 7);
+
+  // every string says how long it is
+  for (uint8_t i = 0; i < 3; i++) {
+    static uint8_t get_string[8] = {0x80, 0x06, 0x00, 0x03, LE16(0x0409),
+                                    LE16(255)};
+    get_string[2] = i;
+    int n = xfer(get_string, pkt);
+    CHECK(n >= 2 && pkt[0] == n && pkt[1] == 0x03);
+  }
+
+  return TEST_RESULT();
+}
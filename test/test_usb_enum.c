@@ -0,0 +1,118 @@
+#include "audio_ring.h"
+#include "clock.h"
+#include "codec.h"
+#include "feedback.h"
+#include "gpio.h"
+#include "i2c.h"
+#include "mic.h"
+#include "playback.h"
+#include "prof.h"
+#include "spectrum.h"
+#include "test.h"
+#include "tim.h"
+#include "usb.h"
+#include "vhost.h"
+#include <string.h>
+
+#define STREAM_FRAMES 200
+
+static uint32_t played[AUDIO_RING_WORDS];
+
+// the output stage takes a millisecond of audio per frame
+static void consume(void) {
+  audio_ring_read(&audio_ring, played, playback_rate() / 1000 * 2);
+}
+
+// enumerate, then stream every alternate setting of both AS interfaces,
+// sending a full speaker packet and reading every IN endpoint each frame.
+// ISR cycles are host time scaled to the 96 MHz core, for comparing runs
+// rather than budgeting, the register accesses are exact.
+int main(void) {
+  vhost_device_t dev;
+
+  clock_init();
+  prof_init();
+  gpio_init();
+  tim1_init();
+  playback_init();
+  mic_init();
+  spectrum_init();
+  i2c_init();
+  codec_init();
+  feedback_init();
+  usb_init();
+
+  CHECK(vhost_enumerate(&dev) == 0);
+  printf("enumeration: %llu us, %u transactions, %u NAKs, %u stalls, %u "
+         "interrupts\n",
+         (unsigned long long)vhost_now(), vhost_stats.transactions,
+         vhost_stats.nak_cnt, vhost_stats.stall_cnt, vhost_stats.irq_cnt);
+  CHECK(vhost_stats.stall_cnt == 0);
+  CHECK(vhost_stats.nak_cnt == 0);
+  CHECK(vhost_now() < 100000);
+
+  vhost_frame_hook = consume;
+
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    const vhost_ep_t *out = NULL;
+    const vhost_ep_t *in[2] = {NULL, NULL};
+    uint8_t num_in = 0;
+
+    // isochronous endpoints only, the vendor interface has no stream
+    if (alt->num_eps == 0 || (alt->eps[0].attr & 0x03) != 0x01) {
+      continue;
+    }
+    for (uint8_t e = 0; e < alt->num_eps; e++) {
+      if (alt->eps[e].addr & 0x80) {
+        in[num_in++] = &alt->eps[e];
+      } else {
+        out = &alt->eps[e];
+      }
+    }
+
+    CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+
+    uint16_t pkt_len = out ? 48 * 2 * alt->subframe : 0;
+    uint8_t pkt[1024];
+    uint32_t packets = 0;
+    uint32_t missed = 0;
+    uint32_t irq_start = usb_stats.irq_cnt;
+    uint64_t cycles_start = usb_stats.cycles_total;
+    uint32_t access_start = otg_stats.accesses;
+
+    memset(pkt, 0x11, sizeof(pkt));
+    for (uint32_t f = 0; f < STREAM_FRAMES; f++) {
+      vhost_frame();
+      if (out) {
+        missed += vhost_iso_out(out->addr, pkt, pkt_len) != OTG_ACK;
+        packets++;
+      }
+      for (uint8_t e = 0; e < num_in; e++) {
+        uint8_t buf[1024];
+        uint16_t len;
+        missed += vhost_iso_in(in[e]->addr & 0x7f, buf, &len) != OTG_ACK;
+        CHECK(len <= in[e]->mps);
+        packets++;
+      }
+    }
+
+    uint32_t irqs = usb_stats.irq_cnt - irq_start;
+    printf("interface %u alt %u (%u-bit in %u bytes): %u packets, %u missed, "
+           "%.1f interrupts/frame, %.0f ISR cycles/packet, %.1f register "
+           "accesses/packet\n",
+           alt->iface, alt->alt, alt->bits, alt->subframe, packets, missed,
+           (double)irqs / STREAM_FRAMES,
+           (double)(usb_stats.cycles_total - cycles_start) / packets,
+           (double)(otg_stats.accesses - access_start) / packets);
+    CHECK(missed == 0);
+
+    CHECK(vhost_set_interface(alt->iface, 0) == 0);
+  }
+
+  CHECK(otg_stats.rx_misread_cnt == 0);
+  CHECK(otg_stats.rx_full_cnt == 0);
+  CHECK(otg_stats.tx_overflow_cnt == 0);
+  CHECK(otg_stats.tx_underrun_cnt == 0);
+  return TEST_RESULT();
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "test.h"
+#include "usb_audio.h"
+#include "usb_desc.h"
+#include "usb_fifo.h"
+#include "usb_regs.h"
+
+#define EP0_MPS 64
+#define WORDS(bytes) (((uint32_t)(bytes) + 3) / 4)
+
+static const uint32_t rates[] = {44100, 48000, 88200, 96000};
+#define NUM_RATES (sizeof(rates) / sizeof(rates[0]))
+
+// largest packet of a stream at a rate, as in usb_audio.c
+static uint16_t stream_mps(uint32_t rate, uint32_t frame_bytes) {
+  return ((rate + 999) / 1000 + 1) * frame_bytes;
+}
+
+// the endpoints of one setting of both AS interfaces, as usb.c builds them
+static void device_eps(uint8_t spk_alt, uint8_t mic_on, uint32_t rate,
+                       usb_fifo_eps_t *eps) {
+  const usb_audio_format_t *fmt = usb_audio_format(spk_alt);
+
+  eps->out_mps = fmt ? stream_mps(rate, fmt->frame_bytes) : EP0_MPS;
+  eps->in_mps[0] = EP0_MPS;
+  eps->in_mps[1] = 3;
+  eps->in_mps[2] = mic_on ? stream_mps(rate, USB_AUDIO_MIC_FRAME_BYTES) : 0;
+  eps->in_mps[USB_REPORT_EP] = USB_REPORT_MPS;
+}
+
+// a plan fits the RAM, gives every endpoint a packet, and keeps the TX
+// FIFOs stacked from the top without overlapping the RX FIFO or each other
+static int plan_valid(const usb_fifo_eps_t *eps, const usb_fifo_plan_t *plan) {
+  uint32_t top = USB_FIFO_WORDS;
+
+  if (plan->rx_words < 13 + WORDS(eps->out_mps) + 1) {
+    return 0;
+  }
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    uint32_t words = plan->tx_words[ep];
+    if (ep == 0 || eps->in_mps[ep] != 0) {
+      if (words < WORDS(eps->in_mps[ep]) || words < USB_FIFO_TX_MIN) {
+        return 0;
+      }
+    } else if (words != 0) {
+      return 0;
+    }
+    if (plan->tx_offset[ep] + words != top) {
+      return 0;
+    }
+    top = plan->tx_offset[ep];
+  }
+  return plan->rx_words <= top;
+}
+
+static uint32_t single_packet_words(const usb_fifo_eps_t *eps) {
+  uint32_t used = 13 + WORDS(eps->out_mps) + 1 + 2 * USB_NUM_EPS + 1;
+
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    if (ep == 0 || eps->in_mps[ep] != 0) {
+      uint32_t words = WORDS(eps->in_mps[ep]);
+      used += words < USB_FIFO_TX_MIN ? USB_FIFO_TX_MIN : words;
+    }
+  }
+  return used;
+}
+
+static int plan_programmed(const usb_fifo_plan_t *plan) {
+  if (USB->GRXFSIZ != plan->rx_words) {
+    return 0;
+  }
+  for (uint8_t ep = 0; ep < USB_NUM_EPS; ep++) {
+    volatile uint32_t *reg =
+        (ep == 0) ? &USB->DIEPTXF0_HNPTXFSIZ : &USB->DIEPTXF[ep - 1];
+    uint32_t txf = (plan->tx_words[ep] << USB_OTG_DIEPTXF_INEPTXFD_Pos) |
+                   plan->tx_offset[ep];
+    if (plan->tx_words[ep] != 0 && *reg != txf) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// every setting the device can be put in must plan and double buffer its
+// isochronous endpoints, every switch between two of them must program
+// the core, and the planner must accept any layout that fits at all
+int main(void) {
+  usb_fifo_eps_t eps;
+  usb_fifo_plan_t plan;
+  uint32_t settings = 0, double_cnt = 0, switches = 0, combos = 0;
+
+  for (uint32_t r = 0; r < NUM_RATES; r++) {
+    for (uint8_t alt = 0; alt < USB_AS_NUM_ALTS; alt++) {
+      for (uint8_t mic = 0; mic < 2; mic++) {
+        device_eps(alt, mic, rates[r], &eps);
+        CHECK(usb_fifo_plan(&eps, &plan));
+        CHECK(plan_valid(&eps, &plan));
+        // the second isochronous packet goes in where it fits, at 48 kHz
+        // and 16 bit it always does
+        uint8_t rx2 = plan.rx_words >= 13 + 2 * (WORDS(eps.out_mps) + 1);
+        uint8_t mic2 = !mic || plan.tx_words[2] >= 2 * WORDS(eps.in_mps[2]);
+        if (rates[r] <= 48000 && alt <= 1) {
+          CHECK(rx2 && mic2);
+        }
+        double_cnt += rx2 && mic2;
+        settings++;
+      }
+    }
+  }
+
+  // from every setting to every other one at the same rate
+  for (uint32_t r = 0; r < NUM_RATES; r++) {
+    for (uint32_t from = 0; from < 2 * USB_AS_NUM_ALTS; from++) {
+      for (uint32_t to = 0; to < 2 * USB_AS_NUM_ALTS; to++) {
+        device_eps(from / 2, from % 2, rates[r], &eps);
+        usb_fifo_plan(&eps, &plan);
+        CHECK(usb_fifo_apply(&plan));
+        device_eps(to / 2, to % 2, rates[r], &eps);
+        usb_fifo_plan(&eps, &plan);
+        CHECK(usb_fifo_apply(&plan));
+        CHECK(plan_programmed(&plan));
+        CHECK(usb_fifo_moved(&plan) == 0);
+        switches++;
+      }
+    }
+  }
+
+  // any IN and OUT packet sizes on every endpoint
+  static const uint16_t sizes[] = {0, 3, 8, 64, 196, 388, 776, 1023};
+  const uint32_t n = sizeof(sizes) / sizeof(sizes[0]);
+  for (uint32_t i = 1; i < n; i++) {
+    for (uint32_t a = 0; a < n; a++) {
+      for (uint32_t b = 0; b < n; b++) {
+        for (uint32_t c = 0; c < n; c++) {
+          eps.out_mps = sizes[i];
+          eps.in_mps[0] = EP0_MPS;
+          eps.in_mps[1] = sizes[a];
+          eps.in_mps[2] = sizes[b];
+          eps.in_mps[3] = sizes[c];
+          int ok = usb_fifo_plan(&eps, &plan);
+          CHECK(ok == (single_packet_words(&eps) <= USB_FIFO_WORDS));
+          if (ok) {
+            CHECK(plan_valid(&eps, &plan));
+          }
+          combos++;
+        }
+      }
+    }
+  }
+
+  // a flush the core never completes is reported, not waited out
+  device_eps(0, 0, 48000, &eps);
+  usb_fifo_plan(&eps, &plan);
+  usb_fifo_apply(&plan);
+  device_eps(1, 1, 96000, &eps);
+  usb_fifo_plan(&eps, &plan);
+  otg_flush_stuck = 1;
+  CHECK(usb_fifo_moved(&plan) != 0);
+  CHECK(!usb_fifo_apply(&plan));
+  CHECK(!usb_fifo_flush(1));
+  otg_flush_stuck = 0;
+  CHECK(usb_fifo_flush(0x10));
+
+  printf("%u device settings, %u double buffered, %u switches, "
+         "%u endpoint combinations\n",
+         (unsigned)settings, (unsigned)double_cnt, (unsigned)switches,
+         (unsigned)combos);
+  return TEST_RESULT();
+}
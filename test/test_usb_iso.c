@@ -0,0 +1,147 @@
+#include "board.h"
+#include "playback.h"
+#include "test.h"
+#include "usb.h"
+#include "vhost.h"
+
+#define FRAMES 3000
+// a fault every this many frames, the kinds taking turns
+#define FAULT_EVERY 50
+
+static uint8_t spk_ep, fb_ep, mic_ep;
+
+enum {
+  NONE,
+  // the interrupt is held off for a whole frame, by a higher priority or
+  // with interrupts masked: nothing is re-armed in time for it
+  HELD,
+  // the host skips the frame: the endpoints stay armed for it and have to
+  // be moved on to the next one
+  SKIPPED,
+};
+
+// frame end and SOF, the interrupt runs unless held off
+static void bus_frame(uint8_t irq) {
+  otg_frame_end();
+  if (irq) {
+    vhost_irq();
+  }
+  otg_sof();
+  if (irq) {
+    vhost_irq();
+  }
+
+  // a mic block per millisecond at 48 kHz
+  board_dma_half(&board_mic_dma, NULL);
+  if (otg_frame() % PLAYBACK_BUFFER_MS == 0) {
+    board_dma_half(&board_playback_dma, NULL);
+  }
+}
+
+// packets of the speaker, its feedback and the mic that did not go through
+static uint32_t transfer(uint8_t irq) {
+  static uint8_t pkt[1024];
+  uint32_t lost = 0;
+  uint16_t len;
+
+  lost += otg_out(spk_ep, pkt, 192) != OTG_ACK;
+  if (irq) {
+    vhost_irq();
+  }
+  lost += otg_in(fb_ep, pkt, &len) != OTG_ACK;
+  if (irq) {
+    vhost_irq();
+  }
+  lost += otg_in(mic_ep, pkt, &len) != OTG_ACK;
+  if (irq) {
+    vhost_irq();
+  }
+  return lost;
+}
+
+static uint32_t dropped(void) {
+  return usb_stats.iso_out[spk_ep].dropped_cnt +
+         usb_stats.iso_in[fb_ep].dropped_cnt +
+         usb_stats.iso_in[mic_ep].dropped_cnt;
+}
+
+static uint32_t recovered(void) {
+  return usb_stats.iso_out[spk_ep].recovered_cnt +
+         usb_stats.iso_in[fb_ep].recovered_cnt +
+         usb_stats.iso_in[mic_ep].recovered_cnt;
+}
+
+// the three streams run with a fault injected every FAULT_EVERY frames.
+// only the packets of the frame hit are lost: the endpoints are armed for
+// the right frame again by the next one, every drop the core reports is
+// followed by a recovery, and nothing is lost in between faults.
+int main(void) {
+  vhost_device_t dev;
+
+  board_init();
+  CHECK(vhost_enumerate(&dev) == 0);
+  for (uint8_t i = 0; i < dev.num_alts; i++) {
+    const vhost_alt_t *alt = &dev.alts[i];
+    if (spk_ep == 0 && alt->num_eps == 2 && !(alt->eps[0].addr & 0x80) &&
+        alt->subframe == 2) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      spk_ep = alt->eps[0].addr;
+      fb_ep = alt->eps[1].addr & 0x7f;
+    } else if (mic_ep == 0 && alt->num_eps == 1 &&
+               (alt->eps[0].addr & 0x80) && (alt->eps[0].attr & 0x03) == 1) {
+      CHECK(vhost_set_interface(alt->iface, alt->alt) == 0);
+      mic_ep = alt->eps[0].addr & 0x7f;
+    }
+  }
+  CHECK(spk_ep != 0 && mic_ep != 0);
+
+  // settle first, the mic starts with zero length packets
+  for (uint32_t f = 0; f < 100; f++) {
+    bus_frame(1);
+    transfer(1);
+  }
+  CHECK(dropped() == 0);
+
+  uint32_t faults[3] = {0};
+  uint32_t lost_fault = 0;
+  uint32_t lost_after = 0;
+  uint8_t fault = NONE;
+  for (uint32_t f = 1; f <= FRAMES; f++) {
+    uint8_t kind = NONE;
+    if (f % FAULT_EVERY == 0) {
+      kind = f / FAULT_EVERY % 2 ? HELD : SKIPPED;
+      faults[kind]++;
+    }
+
+    // held off after the transactions of this frame, the interrupt runs
+    // with the first one of the next, too late to re-arm for it
+    bus_frame(fault != HELD);
+    if (kind == SKIPPED) {
+      fault = kind;
+      continue;
+    }
+    uint32_t lost = transfer(kind != HELD);
+    if (fault == HELD) {
+      lost_fault += lost;
+    } else {
+      lost_after += lost;
+    }
+    fault = kind;
+  }
+  // the last fault recovers too
+  bus_frame(1);
+  lost_after += transfer(1);
+
+  printf("%u frames, %u held interrupts, %u skipped frames: %u packets "
+         "lost in them, %u after, %u drops reported, %u recovered\n",
+         FRAMES, (unsigned)faults[HELD], (unsigned)faults[SKIPPED],
+         (unsigned)lost_fault, (unsigned)lost_after, (unsigned)dropped(),
+         (unsigned)recovered());
+  CHECK(lost_after == 0);
+  // nothing is re-armed for the frame the interrupt is held off in
+  CHECK(lost_fault == 3 * faults[HELD]);
+  CHECK(dropped() >= faults[SKIPPED]);
+  CHECK(recovered() == dropped());
+
+  return TEST_RESULT();
+}